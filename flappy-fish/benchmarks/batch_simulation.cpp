@@ -0,0 +1,166 @@
+/*
+ * BATCH SIMULATION
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+// Simula partidas sin dibujarlas con Batch_Runner y el bot Gap_Bot y muestra cuántas partidas por
+// segundo y por núcleo se simulan y la puntuación que consigue el bot:
+//
+//   flappy-fish-batch [opciones]
+//
+//     --games <n>        Partidas que se simulan (100000 por defecto).
+//     --threads <n>      Hilos (todos los núcleos por defecto).
+//     --max-seconds <s>  Duración máxima de una partida en segundos de juego (300 por defecto).
+//     --seed <n>         Semilla del lote (1 por defecto). La misma semilla da las mismas partidas.
+//     --margin <px>      Margen del bot bajo el centro del hueco antes de impulsarse (0 por defecto).
+//     --lanes <n>        Partidas que avanzan a la vez con SIMD (8 o 16) o 1 para avanzarlas de una
+//                        en una (8 por defecto).
+//     --verify <n>       Comprueba que las n primeras partidas terminan igual bit a bit avanzándolas
+//                        de una en una y con lotes de 8 y 16 carriles, y termina.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Batch_Runner.hpp"
+#include "Game_Batch.hpp"
+
+using namespace flappyfish;
+using namespace std;
+
+namespace
+{
+
+    typedef Game_Batch< 8 >::Summary Summary;
+
+    bool same (const Summary & a, const Summary & b)
+    {
+        return a.steps        == b.steps
+            && a.punctuation  == b.punctuation
+            && a.game_over    == b.game_over
+            && a.random_counter == b.random_counter
+            && memcmp (&a.y,      &b.y,      sizeof(float)) == 0
+            && memcmp (&a.yForce, &b.yForce, sizeof(float)) == 0;
+    }
+
+    template< unsigned LANES >
+    unsigned verify (const vector< Summary > & reference, const Gap_Bot & bot, const Batch_Runner::Settings & settings)
+    {
+        vector< Summary > summaries(reference.size ());
+        Game_Batch< LANES > batch;
+
+        batch.play
+        (
+            0,
+            reference.size (),
+            bot.get_margin (),
+            settings.step,
+            settings.max_steps,
+            [&] (uint64_t index) { return Batch_Runner::game_seed (settings.seed, index); },
+            [&] (uint64_t index, const typename Game_Batch< LANES >::Summary & summary)
+            {
+                summaries[index] = Summary{ summary.steps, summary.punctuation, summary.game_over, summary.y, summary.yForce, summary.random_counter };
+            }
+        );
+
+        unsigned differences = 0;
+
+        for (size_t index = 0; index < reference.size (); ++index)
+        {
+            if (!same (reference[index], summaries[index]))
+            {
+                if (differences++ < 10)
+                {
+                    printf
+                    (
+                        "%u lanes, game %zu: %llu steps, %u points, y %.9g instead of %llu steps, %u points, y %.9g\n",
+                        LANES, index,
+                        (unsigned long long)summaries[index].steps, summaries[index].punctuation, summaries[index].y,
+                        (unsigned long long)reference[index].steps, reference[index].punctuation, reference[index].y
+                    );
+                }
+            }
+        }
+
+        printf ("%2u lanes: %u of %zu games differ\n", LANES, differences, reference.size ());
+
+        return differences;
+    }
+
+    int verify (uint64_t games, const Gap_Bot & bot, const Batch_Runner::Settings & settings)
+    {
+        vector< Summary > reference;
+        Game_Simulation   game;
+
+        for (uint64_t index = 0; index < games; ++index)
+        {
+            game.reset (Batch_Runner::game_seed (settings.seed, index));
+
+            Batch_Runner::play (game, bot, settings);
+
+            reference.push_back (Summary{ game.steps, game.punctuation, game.game_over, game.y, game.yForce, game.random_counter });
+        }
+
+        unsigned differences = verify< 8 > (reference, bot, settings) + verify< 16 > (reference, bot, settings);
+
+        return differences ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    Batch_Runner::Settings settings;
+
+    settings.games = 100000;
+
+    unsigned threads = 0;
+    float    margin  = 0.f;
+    uint64_t checks  = 0;
+
+    if (number_of_arguments % 2 == 0)
+    {
+        fprintf (stderr, "missing value for %s\n", arguments[number_of_arguments - 1]);
+        return 2;
+    }
+
+    for (int index = 1; index + 1 < number_of_arguments; index += 2)
+    {
+        const string option = arguments[index];
+        const char * value  = arguments[index + 1];
+
+        if (option == "--games"      ) settings.games     = strtoull (value, nullptr, 10);                          else
+        if (option == "--threads"    ) threads            = unsigned(atoi (value));                                 else
+        if (option == "--max-seconds") settings.max_steps = uint64_t(atof (value) / double(settings.step));        else
+        if (option == "--seed"       ) settings.seed      = uint32_t(strtoul (value, nullptr, 10));                 else
+        if (option == "--margin"     ) margin             = float(atof (value));                                    else
+        if (option == "--lanes"      ) settings.lanes     = unsigned(atoi (value));                                 else
+        if (option == "--verify"     ) checks             = strtoull (value, nullptr, 10);
+        else
+        {
+            fprintf (stderr, "unknown option %s\n", option.c_str ());
+            return 2;
+        }
+    }
+
+    Gap_Bot bot(margin);
+
+    if (checks > 0) return verify (checks, bot, settings);
+
+    Batch_Runner runner(threads);
+
+    Batch_Runner::Result result = settings.lanes > 1 ? runner.run_batched (bot, settings) : runner.run (bot, settings);
+
+    printf ("games                 %llu (%llu cut at %.0f s)\n", (unsigned long long)result.games, (unsigned long long)result.cut_games, settings.max_steps * settings.step);
+    printf ("threads               %u (%llu ranges stolen)\n", result.threads, (unsigned long long)runner.get_steal_count ());
+    printf ("lanes                 %u\n", settings.lanes > 1 ? (settings.lanes >= 16 ? 16 : 8) : 1);
+    printf ("seconds               %.3f\n", result.seconds);
+    printf ("games per second      %.0f\n", result.games_per_second ());
+    printf ("games per second/core %.0f\n", result.games_per_second_per_core ());
+    printf ("steps per second      %.0f\n", result.seconds > 0. ? double(result.steps) / result.seconds : 0.);
+    printf ("mean punctuation      %.2f (max %u)\n", result.mean_punctuation (), result.max_punctuation);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,216 @@
+/*
+ * GAME SCENE SUITE
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+// Suite de benchmark_suite que mide el fotograma completo de Game_Scene (eventos, update, pasos de
+// simulación y render) con el Director, Null_Graphics_Context y Recording_Canvas, es decir, solo
+// el trabajo de la CPU. Además del tiempo por fotograma se mide el de cada paso de simulación
+// (Game_Scene::run) y el de los fotogramas en los que se cargan los assets, y se guardan los
+// sprites, cambios de estado y cambios de textura por fotograma para detectar cuando crecen.
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <basics/Director>
+#include <basics/Headless>
+#include <basics/Input_Injector>
+#include <basics/Null_Graphics_Context>
+#include <basics/Null_Rendering>
+#include <basics/Recording_Canvas>
+#include <basics/enable>
+#include "Game_Scene.hpp"
+#include "benchmark_suite.hpp"
+
+using namespace basics;
+using namespace basics::benchmarks;
+using namespace std;
+
+namespace
+{
+
+    typedef chrono::steady_clock Clock;
+
+    // Game_Scene con cronómetros alrededor de los métodos que llama el Director en cada fotograma:
+
+    class Timed_Game_Scene : public flappyfish::Game_Scene
+    {
+    public:
+
+        double   frame_seconds    = 0.;
+        double   simulate_seconds = 0.;
+        double   load_seconds     = 0.;
+        uint64_t frames           = 0;
+        uint64_t steps            = 0;
+        uint64_t loads            = 0;
+
+        Recording_Canvas::Counters canvas_counters = Recording_Canvas::Counters();
+        uint64_t                   canvas_frames   = 0;
+
+    private:
+
+        Clock::time_point frame_start;
+        bool              in_frame = false;
+        bool              loading  = false;
+
+    public:
+
+        void handle (Event & event) override
+        {
+            begin_frame ();
+
+            Game_Scene::handle (event);
+        }
+
+        void update (float time) override
+        {
+            begin_frame ();
+
+            // Game_Scene vuelve a cargar los assets cada vez que empieza una partida. Esos
+            // fotogramas se miden aparte:
+
+            loading = !is_loaded ();
+
+            Game_Scene::update (time);
+        }
+
+        void simulate (float step) override
+        {
+            Clock::time_point start = Clock::now ();
+
+            Game_Scene::simulate (step);
+
+            if (is_loaded ())
+            {
+                simulate_seconds += chrono::duration< double >(Clock::now () - start).count ();
+                steps++;
+            }
+        }
+
+        void render (Graphics_Context::Accessor & context) override
+        {
+            Game_Scene::render (context);
+
+            if (in_frame && is_loaded ())
+            {
+                double seconds = chrono::duration< double >(Clock::now () - frame_start).count ();
+
+                if (loading)
+                {
+                    load_seconds += seconds;
+                    loads++;
+                }
+                else
+                {
+                    frame_seconds += seconds;
+                    frames++;
+                }
+            }
+
+            in_frame = false;
+
+            // Solo se ejecuta con Null_Graphics_Context, cuyo canvas es un Recording_Canvas:
+
+            if (Canvas * canvas = context->get_renderer< Canvas > (ID(canvas)))
+            {
+                canvas_counters = static_cast< Recording_Canvas * >(canvas)->get_total_counters ();
+                canvas_frames   = static_cast< Recording_Canvas * >(canvas)->get_frame_count    ();
+            }
+        }
+
+    private:
+
+        void begin_frame ()
+        {
+            if (!in_frame)
+            {
+                frame_start = Clock::now ();
+                in_frame    = true;
+            }
+        }
+
+    };
+
+}
+
+BASICS_BENCHMARK_SUITE(game_scene)
+{
+    if (!context.wants ("frame") && !context.wants ("simulate") && !context.wants ("load")) return;
+
+    const uint64_t frames = 1200;
+
+    enable< Null_Rendering > ();
+
+    Headless::set_assets_path (context.get_assets_path ());
+
+    director.set_graphics_context_factory (Null_Graphics_Context::create);
+    director.set_frame_limit (frames);
+
+    // Se toca la pantalla cada 20 fotogramas para que el pez siga volando y para volver a jugar
+    // cuando se pierde (el botón está en el centro):
+
+    Input_Injector input_injector;
+
+    for (uint64_t frame = 60; frame < frames; frame += 20) input_injector.tap (frame, 360.f, 600.f);
+
+    director.set_input_injector (&input_injector);
+
+    vector< double > frame_samples;
+    vector< double > simulate_samples;
+    vector< double > load_samples;
+
+    Recording_Canvas::Counters counters      = Recording_Canvas::Counters();
+    uint64_t                   canvas_frames = 0;
+
+    for (unsigned repetition = 0; repetition < context.get_repetitions (); ++repetition)
+    {
+        input_injector.rewind ();
+
+        shared_ptr< Timed_Game_Scene > scene = make_shared< Timed_Game_Scene > ();
+
+        director.run_scene (scene);
+
+        if (scene->frames == 0 || scene->steps == 0)
+        {
+            fprintf (stderr, "game_scene: the scene wasn't loaded\n");
+            break;
+        }
+
+        frame_samples   .push_back (scene->frame_seconds    / double(scene->frames));
+        simulate_samples.push_back (scene->simulate_seconds / double(scene->steps ));
+
+        if (scene->loads) load_samples.push_back (scene->load_seconds / double(scene->loads));
+
+        counters      = scene->canvas_counters;
+        canvas_frames = scene->canvas_frames;
+    }
+
+    director.set_input_injector (nullptr);
+    director.set_frame_limit    (0);
+
+    if (frame_samples.empty ()) return;
+
+    if (context.wants ("frame"))
+    {
+        context.add_result ("frame", 1., 1, frame_samples);
+
+        if (canvas_frames > 0)
+        {
+            context.add_counter ("sprites_per_frame",         double(counters.sprites        ) / canvas_frames);
+            context.add_counter ("glyphs_per_frame",          double(counters.glyphs         ) / canvas_frames);
+            context.add_counter ("state_changes_per_frame",   double(counters.state_changes  ) / canvas_frames);
+            context.add_counter ("texture_changes_per_frame", double(counters.texture_changes) / canvas_frames);
+        }
+    }
+
+    if (context.wants ("simulate"))
+    {
+        context.add_result ("simulate", 1., 1, simulate_samples);
+    }
+
+    if (context.wants ("load"))
+    {
+        context.add_result ("load", 1., 1, load_samples);
+    }
+}
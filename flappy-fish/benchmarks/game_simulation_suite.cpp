@@ -0,0 +1,67 @@
+/*
+ * GAME SIMULATION SUITE
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+// Suite de benchmark_suite que mide Game_Simulation sin dibujado: el coste de cada paso de una
+// partida jugada por Gap_Bot y el de lotes de partidas con Batch_Runner en un solo hilo (para que
+// el resultado no dependa del número de núcleos de la máquina), de una en una y en carriles SIMD.
+
+#include "Batch_Runner.hpp"
+#include "benchmark_suite.hpp"
+
+using namespace flappyfish;
+using namespace basics::benchmarks;
+
+BASICS_BENCHMARK_SUITE(game_simulation)
+{
+    Gap_Bot bot;
+
+    Batch_Runner::Settings settings;
+
+    settings.max_steps = 120 * 60;
+
+    // Las partidas duran distinto, así que se mide siempre el mismo grupo de semillas:
+
+    {
+        Game_Simulation game;
+        uint64_t        steps = 0;
+
+        for (uint64_t index = 0; index < 64; ++index)
+        {
+            game.reset (Batch_Runner::game_seed (settings.seed, index));
+
+            steps += Batch_Runner::play (game, bot, settings);
+        }
+
+        context.measure
+        (
+            "step",
+            double(steps),
+            [&]
+            {
+                for (uint64_t index = 0; index < 64; ++index)
+                {
+                    game.reset (Batch_Runner::game_seed (settings.seed, index));
+
+                    Batch_Runner::play (game, bot, settings);
+                }
+
+                keep (game.y);
+            }
+        );
+    }
+
+    {
+        Batch_Runner runner(1);
+
+        settings.games = 256;
+
+        context.measure ("batch", double(settings.games), [&] { keep (runner.run (bot, settings).steps); });
+
+        settings.lanes = 8;
+
+        context.measure ("batch_lanes", double(settings.games), [&] { keep (runner.run_batched (bot, settings).steps); });
+    }
+}
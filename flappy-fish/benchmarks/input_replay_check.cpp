@@ -0,0 +1,164 @@
+/*
+ * INPUT REPLAY CHECK
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+// Graba con Director::record_input() una sesión de Game_Scene sin pantalla (con Null_Graphics_Context
+// y toques de Input_Injector), la guarda y la vuelve a cargar como haría un archivo, la reproduce con
+// Director::replay_input() en otra Game_Scene y comprueba que la partida (Game_Simulation) termina
+// igual bit a bit. Muestra también cuántos bytes ocupa la grabación:
+//
+//   flappy-fish-replay-check [carpeta de los assets] [fotogramas]
+//
+// Termina con EXIT_FAILURE si las partidas no coinciden.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <basics/Director>
+#include <basics/Headless>
+#include <basics/Input_Injector>
+#include <basics/Input_Recording>
+#include <basics/Null_Graphics_Context>
+#include <basics/Null_Rendering>
+#include <basics/enable>
+#include "Game_Scene.hpp"
+
+using namespace basics;
+using namespace flappyfish;
+using namespace std;
+
+namespace
+{
+
+    bool same_float (float a, float b)
+    {
+        return memcmp (&a, &b, sizeof(float)) == 0;
+    }
+
+    bool same (const Game_Simulation & a, const Game_Simulation & b)
+    {
+        if (a.steps          != b.steps          ||
+            a.punctuation    != b.punctuation    ||
+            a.game_over      != b.game_over      ||
+            a.random_counter != b.random_counter ||
+           !same_float (a.y,      b.y     )      ||
+           !same_float (a.yForce, b.yForce)      ||
+           !same_float (a.bgx,    b.bgx   )      ||
+           !same_float (a.bg2x,   b.bg2x  ))
+        {
+            return false;
+        }
+
+        for (unsigned i = 0; i < Game_Simulation::pipes_size; ++i)
+        {
+            if (!same_float (a.pipes[i].x, b.pipes[i].x) || !same_float (a.pipes[i].y, b.pipes[i].y)) return false;
+        }
+
+        return true;
+    }
+
+    void print (const char * name, const Game_Simulation & game)
+    {
+        printf
+        (
+            "%-8s %llu steps, %u points, y %.9g, yForce %.9g, first pipe at %.9g, %u random numbers\n",
+            name,
+            (unsigned long long)game.steps,
+            game.punctuation,
+            game.y,
+            game.yForce,
+            game.pipes[0].x,
+            game.random_counter
+        );
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    const char * assets_path = number_of_arguments > 1 ? arguments[1] : "assets";
+    uint64_t     frames      = number_of_arguments > 2 ? strtoull (arguments[2], nullptr, 10) : 3000;
+
+    enable< Null_Rendering > ();
+
+    Headless::set_assets_path (assets_path);
+
+    director.set_graphics_context_factory (Null_Graphics_Context::create);
+
+    // Se graba la sesión. Los toques en el centro de la pantalla hacen volar al pez y vuelven a
+    // empezar la partida cuando se pierde. Los intervalos irregulares cambian las tuberías que se
+    // alcanzan y el momento en el que se pierde:
+
+    Input_Injector input_injector;
+
+    srand (7);
+
+    for (uint64_t frame = 60; frame < frames; frame += 10 + rand () % 25) input_injector.tap (frame, 360.f, 600.f);
+
+    Input_Recording recording;
+
+    shared_ptr< Game_Scene > recorded_scene = make_shared< Game_Scene > ();
+
+    director.set_input_injector (&input_injector);
+    director.set_frame_limit    (frames);
+    director.record_input       (&recording);
+    director.run_scene          (recorded_scene);
+    director.record_input       (nullptr);
+    director.set_input_injector (nullptr);
+    director.set_frame_limit    (0);
+
+    // La grabación se serializa y se vuelve a leer para comprobar también el formato:
+
+    vector< uint8_t > buffer;
+    Input_Recording   loaded_recording;
+
+    recording.serialize (buffer);
+
+    if (!loaded_recording.deserialize (buffer))
+    {
+        fprintf (stderr, "the recording couldn't be read back\n");
+        return EXIT_FAILURE;
+    }
+
+    printf
+    (
+        "recording %llu frames, %zu bytes (%.0f bytes per 3000 frames)\n",
+        (unsigned long long)loaded_recording.get_frame_count (),
+        loaded_recording.get_size (),
+        loaded_recording.get_frame_count () ? double(loaded_recording.get_size ()) * 3000. / double(loaded_recording.get_frame_count ()) : 0.
+    );
+
+    // Se reproduce en otra escena (la semilla de la partida también sale de la grabación):
+
+    shared_ptr< Game_Scene > replayed_scene = make_shared< Game_Scene > ();
+
+    director.replay_input (&loaded_recording);
+    director.run_scene    (replayed_scene);
+    director.replay_input (nullptr);
+
+    const Game_Simulation & recorded = recorded_scene->get_simulation ();
+    const Game_Simulation & replayed = replayed_scene->get_simulation ();
+
+    print ("recorded", recorded);
+    print ("replayed", replayed);
+
+    if (recorded.steps == 0)
+    {
+        fprintf (stderr, "the game wasn't played (are the assets at %s?)\n", assets_path);
+        return EXIT_FAILURE;
+    }
+
+    if (!same (recorded, replayed))
+    {
+        printf ("the replayed game differs from the recorded one\n");
+        return EXIT_FAILURE;
+    }
+
+    printf ("the replayed game is identical\n");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,200 @@
+/*
+ * RESOURCE RESTORATION CHECK
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+// Comprueba que, cuando se vuelve a crear el contexto gráfico, las texturas que marca la escena actual
+// (Scene::prioritize_resources()) se restauran antes que el resto. Ejecuta Game_Scene sin pantalla con
+// Null_Graphics_Context, añade unas texturas que no son de la escena, destruye y vuelve a crear la
+// ventana (lo que hace el sistema cuando la aplicación pasa a segundo plano y vuelve) y, con un
+// presupuesto que solo deja restaurar un recurso por fotograma, comprueba en cada fotograma que no
+// se restaura ningún recurso de prioridad normal mientras queden de prioridad alta por restaurar:
+//
+//   flappy-fish-restoration-check [carpeta de los assets]
+//
+// Termina con EXIT_FAILURE si el orden no es el esperado.
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <basics/Director>
+#include <basics/Graphics_Resource_Cache>
+#include <basics/Headless>
+#include <basics/Null_Graphics_Context>
+#include <basics/Null_Rendering>
+#include <basics/Texture_2D>
+#include <basics/Window>
+#include <basics/enable>
+#include "Game_Scene.hpp"
+
+using namespace basics;
+using namespace flappyfish;
+using namespace std;
+
+namespace
+{
+
+    Graphics_Resource_Cache * resource_cache = nullptr;
+
+    // Crea el contexto como Null_Graphics_Context::create() y se queda con la caché del Director para
+    // poder consultar el estado de los recursos:
+
+    bool create_context (Window::Accessor & window, Graphics_Resource_Cache * cache)
+    {
+        resource_cache = cache;
+
+        return Null_Graphics_Context::create (window, cache);
+    }
+
+    struct Restoration_State
+    {
+        unsigned high_priority;
+        unsigned high_priority_usable;
+        unsigned normal_priority;
+        unsigned normal_priority_usable;
+    };
+
+    Restoration_State get_restoration_state ()
+    {
+        Restoration_State state = Restoration_State();
+
+        for (auto & cached : resource_cache->resources)
+        {
+            shared_ptr< Graphics_Resource > resource = cached.lock ();
+
+            if (!resource) continue;
+
+            if (resource->get_priority () >= Graphics_Resource::HIGH)
+            {
+                state.high_priority++;
+                state.high_priority_usable += resource->is_usable ();
+            }
+            else
+            {
+                state.normal_priority++;
+                state.normal_priority_usable += resource->is_usable ();
+            }
+        }
+
+        return state;
+    }
+
+    class Restoring_Game_Scene : public Game_Scene
+    {
+    public:
+
+        vector< shared_ptr< Texture_2D > > other_textures;      // Texturas que no son de la escena
+        unsigned                           loss_frame   = 0;    // Fotograma en el que se pierde el contexto
+        unsigned                           frame        = 0;
+        unsigned                           checked      = 0;    // Fotogramas comprobados tras perderlo
+        unsigned                           errors       = 0;
+        bool                               first_frame  = true;
+
+    public:
+
+        void update (float time) override
+        {
+            Game_Scene::update (time);
+
+            if (!is_loaded ()) return;
+
+            frame++;
+
+            if (other_textures.empty ())
+            {
+                // Otras escenas (p. ej. el menú) tienen sus propias texturas en la caché:
+
+                Graphics_Context::Accessor context = director.lock_graphics_context ();
+
+                for (unsigned index = 0; index < 4 && context; ++index)
+                {
+                    shared_ptr< Texture_2D > texture = Texture_2D::create (0, context, "fondo.png");
+
+                    if (texture && context->add (texture)) other_textures.push_back (texture);
+                }
+
+                loss_frame = frame + 10;
+            }
+            else
+            if (frame == loss_frame)
+            {
+                // Se pierde el contexto gráfico y se vuelve a crear (con los eventos de la ventana):
+
+                Window::destroy_window (default_window_id);
+                Window::create_window  (default_window_id);
+            }
+        }
+
+        void render (Graphics_Context::Accessor & context) override
+        {
+            Game_Scene::render (context);
+
+            if (loss_frame == 0 || frame <= loss_frame || !resource_cache) return;
+
+            Restoration_State state = get_restoration_state ();
+
+            // Hasta que no se crea el contexto nuevo los recursos siguen sin poder usarse:
+
+            if (state.high_priority_usable + state.normal_priority_usable == 0) return;
+
+            checked++;
+
+            if (first_frame)
+            {
+                printf
+                (
+                    "first restoration frame: %u of %u high priority and %u of %u normal priority resources restored\n",
+                    state.high_priority_usable,   state.high_priority,
+                    state.normal_priority_usable, state.normal_priority
+                );
+
+                if (state.high_priority == 0 || state.normal_priority_usable > 0) errors++;
+
+                first_frame = false;
+            }
+
+            if (state.normal_priority_usable > 0 && state.high_priority_usable < state.high_priority)
+            {
+                printf ("frame %u: a normal priority resource was restored before the high priority ones\n", frame);
+
+                errors++;
+            }
+
+            if (state.normal_priority_usable == state.normal_priority && state.high_priority_usable == state.high_priority)
+            {
+                director.stop ();
+            }
+        }
+
+    };
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    const char * assets_path = number_of_arguments > 1 ? arguments[1] : "assets";
+
+    enable< Null_Rendering > ();
+
+    Headless::set_assets_path (assets_path);
+
+    director.set_graphics_context_factory       (create_context);
+    director.set_resource_restoration_budget    (0.f);                  // Un recurso por fotograma
+    director.set_frame_limit                    (600);
+
+    shared_ptr< Restoring_Game_Scene > scene = make_shared< Restoring_Game_Scene > ();
+
+    director.run_scene (scene);
+
+    if (scene->checked == 0)
+    {
+        fprintf (stderr, "the graphics context wasn't restored (are the assets at %s?)\n", assets_path);
+        return EXIT_FAILURE;
+    }
+
+    printf ("%u frames checked, %u errors\n", scene->checked, scene->errors);
+
+    return scene->errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/*
+ * SPRITE STRESS SUITE
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+// Suite de benchmark_suite que ejecuta Sprite_Stress_Scene con los sprites del pez en cada backend
+// de Canvas disponible (el nulo, el software y OpenGL ES si hay una superficie EGL). Cada medición
+// es el coste de un sprite (la pendiente del tiempo por fotograma a lo largo de la rampa) y además
+// se muestra el número máximo de sprites que caben en un fotograma a 60 Hz.
+// El máximo no se guarda como valor adicional porque la comparación con la referencia considera
+// una regresión que los valores adicionales crezcan.
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include <basics/Director>
+#include <basics/Graphics_Context>
+#include <basics/Headless>
+#include <basics/Null_Graphics_Context>
+#include <basics/Null_Rendering>
+#include <basics/Sprite_Stress_Scene>
+#include <basics/enable>
+#include <basics/opengles/Context>
+#include <basics/opengles/OpenGL_ES2>
+#include <basics/software/Context>
+#include <basics/software/Software_Rendering>
+#include "benchmark_suite.hpp"
+
+using namespace basics;
+using namespace basics::benchmarks;
+using namespace std;
+
+namespace
+{
+
+    typedef Director::Graphics_Context_Factory Factory;
+
+    void measure_backend (Suite_Context & context, const string & name, Factory factory)
+    {
+        if (!context.wants (name)) return;
+
+        director.set_graphics_context_factory (factory);
+
+        // Por si el backend no llega a cargar la escena (p. ej. si no se puede crear su contexto):
+
+        director.set_frame_limit (200000);
+
+        vector< double > samples;
+        unsigned         max_sprites     = 0;
+        float            base_frame_time = 0.f;
+
+        for (unsigned repetition = 0; repetition < context.get_repetitions (); ++repetition)
+        {
+            shared_ptr< Sprite_Stress_Scene > scene = make_shared< Sprite_Stress_Scene >
+            (
+                "game-assets.sprites",
+                vector< Id >{ ID(player.1), ID(player.2) },
+                "myfont.fnt"
+            );
+
+            scene->set_step_frames (5, 30);
+
+            director.run_scene (scene);
+
+            const Sprite_Stress_Scene::Report & report = scene->get_report ();
+
+            if (report.steps.size () < 2 || report.seconds_per_sprite <= 0.f) break;
+
+            samples.push_back (report.seconds_per_sprite);
+
+            max_sprites     = report.max_sprites;
+            base_frame_time = report.base_frame_time;
+        }
+
+        director.set_frame_limit (0);
+
+        if (samples.empty ())
+        {
+            fprintf (stderr, "sprite_stress/%s: the backend isn't available\n", name.c_str ());
+            return;
+        }
+
+        context.add_result  (name, 1., 1, samples);
+        context.add_counter ("base_frame_ns", base_frame_time * 1e9);
+
+        printf ("%-48s %14u sprites at 60 Hz\n", ("  " + name + " max").c_str (), max_sprites);
+        fflush (stdout);
+    }
+
+}
+
+BASICS_BENCHMARK_SUITE(sprite_stress)
+{
+    Headless::set_assets_path (context.get_assets_path ());
+
+    enable< Null_Rendering > ();
+
+    measure_backend (context, "null", Null_Graphics_Context::create);
+
+    enable< Software_Rendering > ();
+
+    measure_backend (context, "software", software::Context::create);
+
+    enable< OpenGL_ES2 > ();
+
+    measure_backend (context, "opengles", opengles::Context::create);
+
+    director.set_graphics_context_factory (Null_Graphics_Context::create);
+}
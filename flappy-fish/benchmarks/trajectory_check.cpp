@@ -0,0 +1,158 @@
+/*
+ * TRAJECTORY CHECK
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+// Comprueba que Game_Simulation mueve el pez igual que el juego original, que lo movía yForce * 1.5
+// por fotograma a 60 fps (después de restarle GRAVITY * dT), con cualquier paso de simulación que
+// divida el fotograma de 1/60 s. Simula un vuelo con la regla original (el pez se impulsa cada vez que
+// cae por debajo de su altura inicial, más algunos impulsos irregulares), lo repite con los mismos
+// impulsos en los mismos fotogramas con Game_Simulation a 60, 120 (la de Game_Scene) y 240 Hz y
+// compara la posición del pez al final de cada fotograma:
+//
+//   flappy-fish-trajectory-check [fotogramas]
+//
+// Por defecto simula 3600 fotogramas (un minuto a 60 fps), más de lo que suele durar una partida.
+// Muestra también lo que se separaba la regla anterior (y += yForce * 1.5 * TUNING_RATE * dT) a
+// 120 Hz. Termina con EXIT_FAILURE si alguna diferencia supera la tolerancia.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "Game_Simulation.hpp"
+
+using namespace flappyfish;
+using namespace std;
+
+namespace
+{
+
+    const float tolerance = .05f;              // Píxeles en un minuto de vuelo (el error de redondeo que se acumula)
+
+    // Regla del juego original, un paso por fotograma de 60 fps. Guarda en flaps si el pez se ha
+    // impulsado en cada fotograma:
+
+    vector< float > original_trajectory (unsigned frames, vector< bool > & flaps)
+    {
+        vector< float > trajectory;
+
+        const float dT     = 1.f / 60.f;
+        float       y      = 0.f;
+        float       yForce = 0.f;
+
+        for (unsigned frame = 0; frame < frames; ++frame)
+        {
+            bool flap = (yForce <= 0.f && y < 0.f) || frame % 53 == 0;
+
+            if (flap) yForce = Game_Simulation::FLAP_FORCE;
+
+            flaps.push_back (flap);
+
+            yForce -= Game_Simulation::GRAVITY * dT;
+            y      += yForce * 1.5f;
+
+            trajectory.push_back (y);
+        }
+
+        return trajectory;
+    }
+
+    // Game_Simulation con rate pasos por segundo. Las tuberías se dejan detrás del pez y el pez
+    // empieza a la altura start, que lo mantiene dentro de una pantalla de altura height, para que la
+    // partida no termine:
+
+    vector< float > simulated_trajectory (const vector< bool > & flaps, unsigned rate, bool previous_rule, float start, float height)
+    {
+        vector< float > trajectory;
+
+        Game_Simulation game;
+
+        game.layout.fish_x      = -1e6f;
+        game.layout.view_height = height;
+
+        game.reset (1);
+
+        game.y = start;
+
+        const float    dT             = 1.f / float(rate);
+        const unsigned steps_by_frame = rate / 60;
+
+        for (size_t frame = 0; frame < flaps.size () && !game.game_over; ++frame)
+        {
+            if (flaps[frame]) game.flap ();
+
+            for (unsigned step = 0; step < steps_by_frame; ++step)
+            {
+                if (previous_rule)
+                {
+                    game.yForce -= Game_Simulation::GRAVITY * dT;
+                    game.y      += game.yForce * 1.5f * Game_Simulation::TUNING_RATE * dT;
+                }
+                else
+                    game.step (dT);
+            }
+
+            trajectory.push_back (game.y - start);
+        }
+
+        return trajectory;
+    }
+
+    float max_difference (const vector< float > & a, const vector< float > & b)
+    {
+        if (a.size () != b.size ()) return INFINITY;
+
+        float difference = 0.f;
+
+        for (size_t index = 0; index < a.size (); ++index)
+        {
+            difference = fmaxf (difference, fabsf (a[index] - b[index]));
+        }
+
+        return difference;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    unsigned frames = number_of_arguments > 1 ? unsigned(strtoul (arguments[1], nullptr, 10)) : 3600;
+
+    vector< bool  > flaps;
+    vector< float > original = original_trajectory (frames, flaps);
+
+    float lowest  = 0.f;
+    float highest = 0.f;
+
+    for (float y : original)
+    {
+        lowest  = fminf (lowest,  y);
+        highest = fmaxf (highest, y);
+    }
+
+    const float start  = 100.f - lowest;
+    const float height = start + highest + 100.f;
+
+    unsigned failures = 0;
+
+    for (unsigned rate : { 60u, 120u, 240u })
+    {
+        float difference = max_difference (original, simulated_trajectory (flaps, rate, false, start, height));
+
+        printf ("%3u Hz: %u frames, the fish is at most %.6f px away from the original trajectory\n", rate, frames, difference);
+
+        if (!(difference <= tolerance)) failures++;
+    }
+
+    printf
+    (
+        "previous rule at 120 Hz: at most %.3f px away from the original trajectory\n",
+        max_difference (original, simulated_trajectory (flaps, 120, true, start, height))
+    );
+
+    printf ("%s\n", failures ? "trajectory check failed" : "trajectory check passed");
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
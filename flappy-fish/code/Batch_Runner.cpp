@@ -0,0 +1,157 @@
+/*
+ * BATCH RUNNER
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+#include "Batch_Runner.hpp"
+#include "Game_Batch.hpp"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace flappyfish
+{
+
+    namespace
+    {
+
+        // Resultados de cada hilo, separados para que no compartan línea de caché
+        struct alignas(64) Worker_Result
+        {
+            uint64_t games             = 0;
+            uint64_t steps             = 0;
+            uint64_t cut_games         = 0;
+            uint64_t total_punctuation = 0;
+            unsigned max_punctuation   = 0;
+
+            void add (uint64_t game_steps, unsigned punctuation, bool game_over)
+            {
+                if (!game_over) cut_games++;
+
+                games++;
+                steps             += game_steps;
+                total_punctuation += punctuation;
+                max_punctuation    = std::max (max_punctuation, punctuation);
+            }
+        };
+
+        Batch_Runner::Result add_up (const std::vector< Worker_Result > & results, std::chrono::steady_clock::time_point start, unsigned threads)
+        {
+            Batch_Runner::Result total = Batch_Runner::Result();
+
+            total.seconds = std::chrono::duration< double >(std::chrono::steady_clock::now () - start).count ();
+            total.threads = threads;
+
+            for (const Worker_Result & result : results)
+            {
+                total.games             += result.games;
+                total.steps             += result.steps;
+                total.cut_games         += result.cut_games;
+                total.total_punctuation += result.total_punctuation;
+                total.max_punctuation    = std::max (total.max_punctuation, result.max_punctuation);
+            }
+
+            return total;
+        }
+
+    }
+
+    uint32_t Batch_Runner::game_seed (uint32_t seed, uint64_t index)
+    {
+        // Se mezclan los bits (el final de MurmurHash3) para que partidas con índices seguidos no
+        // empiecen con números aleatorios parecidos:
+
+        uint32_t hash = seed ^ uint32_t(index) ^ uint32_t(index >> 32) * 0x9E3779B9u;
+
+        hash ^= hash >> 16;
+        hash *= 0x85EBCA6Bu;
+        hash ^= hash >> 13;
+        hash *= 0xC2B2AE35u;
+        hash ^= hash >> 16;
+
+        return hash;
+    }
+
+    uint64_t Batch_Runner::play (Game_Simulation & game, const Bot_Policy & bot, const Settings & settings)
+    {
+        while (!game.game_over && game.steps < settings.max_steps)
+        {
+            if (bot.flap (game)) game.flap ();
+
+            game.step (settings.step);
+        }
+
+        return game.steps;
+    }
+
+    Batch_Runner::Result Batch_Runner::run (const Bot_Policy & bot, const Settings & settings)
+    {
+        std::vector< Worker_Result > results(pool.get_thread_count ());
+
+        auto start = std::chrono::steady_clock::now ();
+
+        pool.parallel_for
+        (
+            size_t(settings.games),
+            settings.grain,
+            [&] (size_t begin, size_t end, unsigned worker)
+            {
+                Worker_Result & result = results[worker];
+                Game_Simulation game;
+
+                for (size_t index = begin; index < end; ++index)
+                {
+                    game.reset (game_seed (settings.seed, index));
+
+                    uint64_t steps = play (game, bot, settings);
+
+                    result.add (steps, game.punctuation, game.game_over);
+                }
+            }
+        );
+
+        return add_up (results, start, pool.get_thread_count ());
+    }
+
+    Batch_Runner::Result Batch_Runner::run_batched (const Gap_Bot & bot, const Settings & settings)
+    {
+        return settings.lanes >= 16 ? run_lanes< 16 > (bot, settings) : run_lanes< 8 > (bot, settings);
+    }
+
+    template< unsigned LANES >
+    Batch_Runner::Result Batch_Runner::run_lanes (const Gap_Bot & bot, const Settings & settings)
+    {
+        std::vector< Worker_Result > results(pool.get_thread_count ());
+
+        auto start = std::chrono::steady_clock::now ();
+
+        pool.parallel_for
+        (
+            size_t(settings.games),
+            settings.grain * LANES,
+            [&] (size_t begin, size_t end, unsigned worker)
+            {
+                Worker_Result & result = results[worker];
+                Game_Batch< LANES > batch;
+
+                batch.play
+                (
+                    begin,
+                    end,
+                    bot.get_margin (),
+                    settings.step,
+                    settings.max_steps,
+                    [&] (uint64_t index) { return game_seed (settings.seed, index); },
+                    [&] (uint64_t , const typename Game_Batch< LANES >::Summary & summary)
+                    {
+                        result.add (summary.steps, summary.punctuation, summary.game_over);
+                    }
+                );
+            }
+        );
+
+        return add_up (results, start, pool.get_thread_count ());
+    }
+
+}
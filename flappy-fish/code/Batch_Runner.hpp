@@ -0,0 +1,102 @@
+/*
+ * BATCH RUNNER
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+#ifndef BATCH_RUNNER_HEADER
+#define BATCH_RUNNER_HEADER
+
+#include <cstdint>
+#include <basics/Work_Stealing_Pool>
+#include "Game_Simulation.hpp"
+
+namespace flappyfish
+{
+
+    // Simula muchas partidas de Game_Simulation sin dibujarlas, repartidas entre varios hilos, con
+    // un bot que decide cuándo impulsarse. Sirve para torneos de bots y para ajustar la dificultad.
+
+    class Batch_Runner
+    {
+    public:
+
+        struct Settings
+        {
+            uint64_t games     = 10000;
+            float    step      = 1.f / 120.f;           // El mismo paso que Game_Scene
+            uint64_t max_steps = 120 * 300;             // Las partidas que duran más se cortan (5 minutos)
+            uint32_t seed      = 1;                     // Cada partida usa una semilla derivada de esta y de su índice
+            size_t   grain     = 64;                    // Partidas por trozo de trabajo (por carril en run_batched())
+            unsigned lanes     = 8;                     // Partidas por lote en run_batched() (8 o 16)
+        };
+
+        struct Result
+        {
+            uint64_t games;
+            uint64_t steps;
+            uint64_t cut_games;                         // Partidas que llegaron a max_steps
+            uint64_t total_punctuation;
+            unsigned max_punctuation;
+            unsigned threads;
+            double   seconds;
+
+            double games_per_second () const
+            {
+                return seconds > 0. ? double(games) / seconds : 0.;
+            }
+
+            double games_per_second_per_core () const
+            {
+                return threads > 0 ? games_per_second () / threads : 0.;
+            }
+
+            double mean_punctuation () const
+            {
+                return games > 0 ? double(total_punctuation) / double(games) : 0.;
+            }
+        };
+
+    private:
+
+        basics::Work_Stealing_Pool pool;
+
+    public:
+
+        // 0 hilos usa todos los núcleos
+        Batch_Runner(unsigned threads = 0) : pool(threads)
+        {
+        }
+
+        unsigned get_thread_count () const
+        {
+            return pool.get_thread_count ();
+        }
+
+        uint64_t get_steal_count () const
+        {
+            return pool.get_steal_count ();
+        }
+
+        // El bot se comparte entre todos los hilos
+        Result run (const Bot_Policy & bot, const Settings & settings);
+
+        // Como run() pero avanzando settings.lanes partidas a la vez con Game_Batch (solo con Gap_Bot).
+        // Los resultados son los mismos que los de run():
+        Result run_batched (const Gap_Bot & bot, const Settings & settings);
+
+        // Semilla de la partida index de un lote:
+        static uint32_t game_seed (uint32_t seed, uint64_t index);
+
+        // Juega una partida completa y devuelve los pasos que ha durado:
+        static uint64_t play (Game_Simulation & game, const Bot_Policy & bot, const Settings & settings);
+
+    private:
+
+        template< unsigned LANES >
+        Result run_lanes (const Gap_Bot & bot, const Settings & settings);
+    };
+
+}
+
+#endif
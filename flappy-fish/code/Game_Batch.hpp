@@ -0,0 +1,345 @@
+/*
+ * GAME BATCH
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+#ifndef GAME_BATCH_HEADER
+#define GAME_BATCH_HEADER
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include "Game_Simulation.hpp"
+
+namespace flappyfish
+{
+
+    // Varias partidas de Game_Simulation ("carriles") que avanzan a la vez con el bot Gap_Bot. El
+    // estado se guarda por campos (estructura de arrays) y cada fase del paso es un bucle sin saltos
+    // sobre los carriles que el compilador convierte en instrucciones SIMD (SSE/AVX o NEON): en los
+    // carriles cuya partida ha terminado el pez y la puntuación no cambian porque los resultados se
+    // mezclan con máscaras.
+    //
+    // Cada carril hace exactamente las mismas operaciones en el mismo orden que Game_Simulation::step
+    // y Gap_Bot::flap, así que el resultado es idéntico bit a bit (ver --verify en flappy-fish-batch).
+    // Cuando una partida termina se guarda su resultado y el carril se rellena con la siguiente.
+
+    template< unsigned LANES >
+    class Game_Batch
+    {
+    public:
+
+        static const unsigned lanes      = LANES;
+        static const unsigned pipes_size = Game_Simulation::pipes_size;
+
+        // Estado final de una partida (lo mismo que se puede leer de un Game_Simulation):
+        struct Summary
+        {
+            uint64_t steps;
+            unsigned punctuation;
+            bool     game_over;
+            float    y;
+            float    yForce;
+            uint32_t random_counter;
+        };
+
+    private:
+
+        Game_Simulation::Layout layout;
+
+        alignas(64) float    y             [LANES];
+        alignas(64) float    yForce        [LANES];
+        alignas(64) float    bgx           [LANES];
+        alignas(64) float    bg2x          [LANES];
+        alignas(64) float    pipe_x        [pipes_size][LANES];
+        alignas(64) float    pipe_y        [pipes_size][LANES];
+        alignas(64) uint64_t random_key    [LANES];
+        alignas(64) uint32_t random_counter[LANES];
+        alignas(64) uint32_t punctuation   [LANES];
+        alignas(64) int32_t  game_over     [LANES];       // 0 o -1 (todos los bits a 1) para usarlo como máscara
+        alignas(64) int32_t  active        [LANES];       // Carriles con una partida en curso
+        alignas(64) uint64_t steps         [LANES];
+        alignas(64) uint64_t game          [LANES];       // Índice de la partida de cada carril
+
+    public:
+
+        explicit Game_Batch(const Game_Simulation::Layout & layout = Game_Simulation::Layout()) : layout(layout)
+        {
+            for (unsigned lane = 0; lane < LANES; ++lane) active[lane] = 0;
+        }
+
+        // Juega las partidas [first, end) con las semillas seed_of(index) y llama a done(index, summary)
+        // cuando termina cada una (por game over o al llegar a max_steps):
+        template< typename SEED_OF, typename DONE >
+        void play (uint64_t first, uint64_t end, float margin, float dT, uint64_t max_steps, SEED_OF && seed_of, DONE && done)
+        {
+            uint64_t next = first;
+
+            for (unsigned lane = 0; lane < LANES; ++lane)
+            {
+                if (next < end) load (lane, next, seed_of (next)); else active[lane] = 0;
+
+                next += next < end;
+            }
+
+            // Los carriles que terminan se rellenan con la siguiente partida. Solo se miran cuando
+            // alguna choca o cuando a la que más tiempo lleva jugando le toca cortarse en max_steps:
+
+            bool     finished  = true;
+            uint64_t until_cut = 0;
+
+            for (;;)
+            {
+                if (finished || until_cut == 0)
+                {
+                    until_cut = max_steps;
+
+                    for (unsigned lane = 0; lane < LANES; ++lane)
+                    {
+                        while (active[lane] && (game_over[lane] || steps[lane] >= max_steps))
+                        {
+                            done (game[lane], summary (lane));
+
+                            if (next < end)
+                            {
+                                load (lane, next, seed_of (next));
+
+                                ++next;
+                            }
+                            else
+                                active[lane] = 0;
+                        }
+
+                        if (active[lane]) until_cut = std::min (until_cut, max_steps - steps[lane]);
+                    }
+
+                    if (!any_active ()) break;
+                }
+
+                finished = step (margin, dT);
+
+                --until_cut;
+            }
+        }
+
+        // Un paso de todos los carriles activos: el bot decide si se impulsa y la partida avanza dT.
+        // Devuelve true si alguna partida ha terminado en este paso.
+        bool step (float margin, float dT)
+        {
+            const float half_width  = layout.pipe_width  / 2;
+            const float half_height = layout.pipe_height / 2;
+            const float half_bg     = layout.background_width / 2;
+            const float fish_x      = layout.fish_x;
+
+            // Las condiciones se combinan con & y | en lugar de && y || para que no haya saltos (el
+            // compilador no adelanta una comparación de floats que quizá no se evaluaría):
+
+            alignas(64) int32_t live[LANES];
+
+            for (unsigned lane = 0; lane < LANES; ++lane) live[lane] = active[lane] & ~game_over[lane];
+
+            // Gap_Bot: el centro del hueco de la tubería de abajo más cercana que no se ha pasado (como
+            // next_x empieza en infinito, la primera que está por delante siempre es la más cercana)
+
+            alignas(64) float   next_x[LANES];
+            alignas(64) float   next_y[LANES];
+
+            for (unsigned lane = 0; lane < LANES; ++lane)
+            {
+                next_x[lane] = std::numeric_limits< float >::infinity ();
+                next_y[lane] = 0.f;
+            }
+
+            for (unsigned i = 0; i < pipes_size / 2; ++i)
+            {
+                for (unsigned lane = 0; lane < LANES; ++lane)
+                {
+                    float x = pipe_x[i][lane];
+                    float y = pipe_y[i][lane];
+                    bool  closer = (x + half_width > fish_x) & (x < next_x[lane]);
+
+                    next_x[lane] = closer ? x : next_x[lane];
+                    next_y[lane] = closer ? y : next_y[lane];
+                }
+            }
+
+            for (unsigned lane = 0; lane < LANES; ++lane)
+            {
+                float   gap_y      = next_y[lane] + Game_Simulation::DISTANCE_UP / 2;
+                float   gap_center = next_x[lane] < std::numeric_limits< float >::infinity () ? gap_y : layout.view_height / 2;
+                int32_t flap       = -int32_t(yForce[lane] <= 0.f) & -int32_t(y[lane] < gap_center - margin) & live[lane];
+
+                yForce[lane] = flap ? Game_Simulation::FLAP_FORCE : yForce[lane];
+            }
+
+            // Movimiento en Y del pez con gravedad y del fondo
+
+            const float background_width = layout.background_width;
+
+            for (unsigned lane = 0; lane < LANES; ++lane)
+            {
+                float force = yForce[lane] - Game_Simulation::GRAVITY * dT;
+                float new_y = y[lane] + Game_Simulation::fall (force, dT);
+
+                yForce[lane] = live[lane] ? force : yForce[lane];
+                y     [lane] = live[lane] ? new_y : y     [lane];
+            }
+
+            for (unsigned lane = 0; lane < LANES; ++lane)
+            {
+                float bg1 = bgx [lane] - dT * Game_Simulation::BGSPEED;
+                float bg2 = bg2x[lane] - dT * Game_Simulation::BGSPEED;
+
+                int32_t wrap1 = -int32_t(bg1 + half_bg + 5 < 0);
+                int32_t wrap2 = -int32_t(bg2 + half_bg + 5 < 0) & ~wrap1;
+
+                float after2 = bg2 + background_width;
+
+                bg1 = wrap1 ? after2 : bg1;
+
+                float after1 = bg1 + background_width;
+
+                bg2 = wrap2 ? after1 : bg2;
+
+                bgx [lane] = live[lane] ? bg1 : bgx [lane];
+                bg2x[lane] = live[lane] ? bg2 : bg2x[lane];
+            }
+
+            for (unsigned lane = 0; lane < LANES; ++lane) steps[lane] += uint32_t(live[lane]) & 1;
+
+            // Las tuberías de los carriles terminados también se mueven: no se vuelven a leer hasta que
+            // el carril se rellena (la recolocación y las colisiones usan la máscara live).
+
+            for (unsigned i = 0; i < pipes_size; ++i)
+            {
+                for (unsigned lane = 0; lane < LANES; ++lane)
+                {
+                    pipe_x[i][lane] -= dT * Game_Simulation::PIPE_SPEED;
+                }
+            }
+
+            // Recolocación de las tuberías, en el mismo orden que en Game_Simulation porque cada una
+            // se coloca tras la anterior (que puede haberse recolocado en este mismo paso). Como en
+            // casi todos los pasos no se recoloca ninguna, primero se comprueba si hace falta:
+
+            for (unsigned index = 0; index < pipes_size / 2; ++index)
+            {
+                alignas(64) int32_t recycle[LANES];
+
+                int32_t any_recycle = 0;
+
+                for (unsigned lane = 0; lane < LANES; ++lane)
+                {
+                    recycle[lane] = live[lane] & -int32_t(pipe_x[index][lane] + half_width <= 0);
+                    any_recycle  |= recycle[lane];
+                }
+
+                if (any_recycle) recycle_pipe (index, recycle);
+            }
+
+            // Colisiones (cajas alineadas con los ejes contra el punto del pez) y salida de la pantalla
+
+            alignas(64) int32_t hit[LANES];
+
+            for (unsigned lane = 0; lane < LANES; ++lane)
+            {
+                hit[lane] = -int32_t(y[lane] < 0 + 50) | -int32_t(y[lane] > layout.view_height + 50);
+            }
+
+            for (unsigned i = 0; i < pipes_size; ++i)
+            {
+                for (unsigned lane = 0; lane < LANES; ++lane)
+                {
+                    hit[lane] |= -int32_t(fish_x  > pipe_x[i][lane] - half_width )
+                               & -int32_t(fish_x  < pipe_x[i][lane] + half_width )
+                               & -int32_t(y[lane] > pipe_y[i][lane] - half_height)
+                               & -int32_t(y[lane] < pipe_y[i][lane] + half_height);
+                }
+            }
+
+            int32_t any_hit = 0;
+
+            for (unsigned lane = 0; lane < LANES; ++lane)
+            {
+                hit      [lane] &= live[lane];
+                game_over[lane] |= hit [lane];
+                any_hit         |= hit [lane];
+            }
+
+            return any_hit != 0;
+        }
+
+        bool any_active () const
+        {
+            int32_t any = 0;
+
+            for (unsigned lane = 0; lane < LANES; ++lane) any |= active[lane];
+
+            return any != 0;
+        }
+
+    private:
+
+        // Coloca la tubería index (y su pareja) tras la anterior en los carriles de la máscara,
+        // avanzando solo el contador del generador aleatorio de esos carriles:
+        void recycle_pipe (unsigned index, const int32_t * recycle)
+        {
+            const unsigned previous = index == 0 ? pipes_size - 1 : index - 1;
+            const unsigned pair     = index + pipes_size / 2;
+
+            for (unsigned lane = 0; lane < LANES; ++lane)
+            {
+                uint32_t random = basics::Counter_Random::generate (random_key[lane], random_counter[lane]);
+
+                float new_x = pipe_x[previous][lane] + Game_Simulation::DISTANCE_X;
+                float new_y = std::max (-200.0f, std::min (pipe_y[previous][lane] + float(int(random % 500) - 350), 400.0f));
+                float up_y  = new_y + Game_Simulation::DISTANCE_UP;
+
+                random_counter[lane] += uint32_t(recycle[lane]) & 1;
+                pipe_x[index][lane] = recycle[lane] ? new_x : pipe_x[index][lane];
+                pipe_x[pair ][lane] = recycle[lane] ? new_x : pipe_x[pair ][lane];
+                pipe_y[index][lane] = recycle[lane] ? new_y : pipe_y[index][lane];
+                pipe_y[pair ][lane] = recycle[lane] ? up_y  : pipe_y[pair ][lane];
+                punctuation [lane] += uint32_t(recycle[lane]) & 1;
+            }
+        }
+
+        void load (unsigned lane, uint64_t index, uint32_t seed)
+        {
+            // La partida empieza igual que una Game_Simulation (que coloca las primeras tuberías):
+
+            Game_Simulation simulation;
+
+            simulation.layout = layout;
+            simulation.reset (seed);
+
+            y             [lane] = simulation.y;
+            yForce        [lane] = simulation.yForce;
+            bgx           [lane] = simulation.bgx;
+            bg2x          [lane] = simulation.bg2x;
+            random_key    [lane] = simulation.random.get_key ();
+            random_counter[lane] = simulation.random_counter;
+            punctuation   [lane] = simulation.punctuation;
+            game_over     [lane] = 0;
+            active        [lane] = -1;
+            steps         [lane] = 0;
+            game          [lane] = index;
+
+            for (unsigned i = 0; i < pipes_size; ++i)
+            {
+                pipe_x[i][lane] = simulation.pipes[i].x;
+                pipe_y[i][lane] = simulation.pipes[i].y;
+            }
+        }
+
+        Summary summary (unsigned lane) const
+        {
+            return Summary{ steps[lane], punctuation[lane], game_over[lane] != 0, y[lane], yForce[lane], random_counter[lane] };
+        }
+
+    };
+
+}
+
+#endif
@@ -5,9 +5,12 @@
  */
 
 #include "Game_Scene.hpp"
+#include <cwchar>
 #include <basics/Canvas>
 #include <basics/Director>
+#include <basics/Frame_Arena>
 #include <basics/Scaling>
+#include <basics/Trace>
 #include <basics/Rotation>
 #include <basics/Translation>
 
@@ -19,50 +22,47 @@ namespace flappyfish
 
     Game_Scene::Game_Scene()
     {
+        state         = LOADING;
         canvas_width  = 720;
         canvas_height =  1280;
+
+        simulation.layout.view_width  = float(canvas_width );
+        simulation.layout.view_height = float(canvas_height);
+
+        //La simulación avanza a pasos fijos independientemente de la frecuencia de dibujado
+        set_simulation_rate (SIMULATION_RATE);
     }
 
     bool Game_Scene::initialize ()
     {
+        //Los recursos se conservan al volver a jugar, así que state no se reinicia aquí
         game_state = PLAYING;
-        state     = LOADING;
         suspended = false;
         hasStartedPlaying = false;
 
-        punctuation = 0;
         pause_button.position = {(float)canvas_width * 0.1f, (float)canvas_height * 0.9f};
 
-        //Moñeco
-        x         = 100;
-        y         = (float)canvas_height/2;
-
         //Fondo
-        bgx         = 1280.0f/2;
         bgy         = 1280.0f/2;
-        bg2x        = bgx + 1280;
-
-        //Seed para el random
-        srand (unsigned(time(nullptr)));
 
-        //Posición de las tuberías
-        pipes[0].pos = pipes[pipes_size / 2].pos =      {(canvas_width + 250), canvas_height/2 - DISTANCE_UP/2};
+        //La partida empieza con una semilla que da el Director para que las partidas grabadas se
+        //puedan repetir
+        simulation.reset (director.make_random_seed ());
 
-        //Todas las tuberías de arriba van después de las tuberías de abajo, por lo que
-        // la tubería 0 va con la 3, la 1 con la 4, etc.
-        pipes[pipes_size / 2].pos.coordinates.y() += DISTANCE_UP;
-
-        //Las primeras tuberías van al medio, las siguientes en Y aleatorias
-        for (unsigned i = 1; i < pipes_size / 2 ; ++i)
-        {
-            pipes[i].pos = pipes[i + pipes_size / 2].pos = {(pipes[i - 1].pos.coordinates.x() + DISTANCE_X),
-                                                            (random_Y_pos(pipes[i - 1].pos.coordinates.y()))};
-            pipes[i + pipes_size / 2].pos.coordinates.y() += DISTANCE_UP;
-        }
+        save_previous_state ();
 
         return true;
     }
 
+    void Game_Scene::prioritize_resources ()
+    {
+        //Al recrearse el contexto gráfico se restauran antes las texturas de la partida que las del menú
+        if (background) background->set_priority (Graphics_Resource::HIGH);
+        if (atlas     ) atlas     ->set_priority (Graphics_Resource::HIGH);
+        if (atlas_menu) atlas_menu->set_priority (Graphics_Resource::HIGH);
+        if (font      ) font      ->set_priority (Graphics_Resource::HIGH);
+    }
+
     void Game_Scene::suspend ()
     {
         suspended = true;
@@ -88,7 +88,7 @@ namespace flappyfish
 
                     if(game_state == PLAYING){
                         flying ? flying = false : flying = true;
-                        yForce = 5;
+                        simulation.flap ();
                     }
 
 
@@ -96,7 +96,7 @@ namespace flappyfish
                 }
                case ID(touch-ended):
                 {
-                    Point2f touch_location = { *event[ID(x)].as< var::Float > (), *event[ID(y)].as< var::Float > () };
+                    Point2f touch_location = { event.touch ().x, event.touch ().y };
 
                     if(game_state != PLAYING) //Opciones de Game Over y Pause
                     {
@@ -107,7 +107,8 @@ namespace flappyfish
                         }
                         else if (option_at (touch_location) == QUIT && game_state != PLAYING)
                         {
-                            director.stop();
+                            //Se vuelve al menú, que se ha quedado cargado debajo de la partida
+                            director.pop_scene();
                         }
                         else if (option_at (touch_location) == PLAY && game_state == PAUSED)
                         {
@@ -133,15 +134,35 @@ namespace flappyfish
         }
     }
 
-    void Game_Scene::update (float time)
+    void Game_Scene::update (float )
     {
-        switch (state)
+        //Si la escena no se ha cargado antes con Director::preload_scene(), se carga ahora
+        if (!suspended && state == LOADING) preload ();
+
+        if (!suspended && state == UPLOADING)
         {
-            case LOADING: load ();     break;
-            case RUNNING: if(hasStartedPlaying) run  (time); break;
+            Graphics_Context::Accessor context = director.lock_graphics_context ();
+
+            if (context) upload (context);
         }
     }
 
+    void Game_Scene::simulate (float step)
+    {
+        save_previous_state ();
+
+        if (state == RUNNING && hasStartedPlaying) run (step);
+    }
+
+    void Game_Scene::save_previous_state ()
+    {
+        previous_bgx  = simulation.bgx;
+        previous_bg2x = simulation.bg2x;
+        previous_y    = simulation.y;
+
+        for (unsigned i = 0; i < Game_Simulation::pipes_size; ++i) previous_pipes_x[i] = simulation.pipes[i].x;
+    }
+
     void Game_Scene::render (basics::Graphics_Context::Accessor & context)
     {
         if (!suspended && state == RUNNING)
@@ -157,38 +178,55 @@ namespace flappyfish
             {
                 canvas->clear        ();
 
+                //Se dibuja el estado interpolado entre los dos últimos pasos de simulación
+                const float alpha = get_interpolation_alpha ();
+
                 if(background) //Dibuja los fondos uno tras otro
                 {
-                    canvas->fill_rectangle ({ bgx, bgy },   {background->get_width() , background->get_height() }, background.get ());
-                    canvas->fill_rectangle ({ bg2x, bgy },  {background->get_width() , background->get_height() }, background.get ());
+                    float bgx_now  = previous_bgx  + (simulation.bgx  - previous_bgx ) * alpha;
+                    float bg2x_now = previous_bg2x + (simulation.bg2x - previous_bg2x) * alpha;
+
+                    canvas->fill_rectangle ({ bgx_now, bgy },   {background->get_width() , background->get_height() }, background.get ());
+                    canvas->fill_rectangle ({ bg2x_now, bgy },  {background->get_width() , background->get_height() }, background.get ());
                 }
 
                 if(atlas)
                 {
                     //Dibuja las tuberías
-                    for (int i = 0; i < pipes_size; ++i)
+                    for (unsigned i = 0; i < Game_Simulation::pipes_size; ++i)
                     {
+                         const Game_Simulation::Pipe & pipe = simulation.pipes[i];
 
-                         if(i < pipes_size / 2) //Las primeras son las de abajo
+                         Point2f where = { previous_pipes_x[i] + (pipe.x - previous_pipes_x[i]) * alpha, pipe.y };
 
-                             draw_slice (canvas, pipes[i].pos, *atlas, ID(pipes.pipeup) );
+                         if(i < Game_Simulation::pipes_size / 2) //Las primeras son las de abajo
+
+                             draw_slice (canvas, where, *atlas, ID(pipes.pipeup) );
 
                          else //Las de después sus parejas
-                             draw_slice (canvas, pipes[i].pos, *atlas, ID(pipes.pipedown) );
+                             draw_slice (canvas, where, *atlas, ID(pipes.pipedown) );
 
                     }
 
+                    float x     = simulation.layout.fish_x;
+                    float y_now = previous_y + (simulation.y - previous_y) * alpha;
+
                     if(flying)
-                        draw_slice(canvas, {x,y}, *atlas, ID(player.1));
+                        draw_slice(canvas, {x,y_now}, *atlas, ID(player.1));
 
                     else
-                        draw_slice(canvas, {x,y}, *atlas, ID(player.2));
+                        draw_slice(canvas, {x,y_now}, *atlas, ID(player.2));
 
                 }
 
                 if(font) //Muestra puntuación
                 {
-                    Text_Layout punctuation_text(*font, to_wstring(punctuation));
+                    //El texto se compone en la memoria del fotograma para no reservar memoria en cada uno
+                    const size_t text_size = 16;
+                    wchar_t    * text      = static_cast< wchar_t * >(frame_arena.allocate (text_size * sizeof(wchar_t), alignof(wchar_t)));
+                    int          length    = swprintf (text, text_size, L"%u", simulation.punctuation);
+
+                    Text_Layout punctuation_text(*font, text, length > 0 ? size_t(length) : 0, frame_arena);
                     canvas->draw_text({canvas_width/2, canvas_height*0.95f}, punctuation_text, TOP | CENTER);
                 }
 
@@ -234,101 +272,75 @@ namespace flappyfish
         }
     }
 
-    void Game_Scene::load ()
+    void Game_Scene::preload ()
     {
-        if (!suspended)
+        BASICS_TRACE_SCOPE("Game_Scene::preload");
+
+        //Solo se leen los archivos y se decodifican las imágenes (no hace falta el contexto gráfico)
+        atlas.reset (new Atlas("game-assets.sprites"));
+        atlas_menu.reset (new Atlas("menu-sprites.sprites"));
+
+        if (Texture_2D::decode ("fondo.png", background_pixels, background_options)
+            && atlas->is_pending_upload () && atlas_menu->is_pending_upload ())
         {
-            Graphics_Context::Accessor context = director.lock_graphics_context ();
+            state = UPLOADING;
+        }
+        else state = ERROR;             //No se reintenta: volver a leer los archivos en cada frame bloquearía el juego
+    }
 
-            if (context)
-            {
-                background = Texture_2D::create (ID(bg), context, "fondo.png");
+    bool Game_Scene::upload (Graphics_Context::Accessor & context)
+    {
+        BASICS_TRACE_SCOPE("Game_Scene::upload");
 
-                font.reset (new Raster_Font("myfont.fnt", context));
-                atlas.reset (new Atlas("game-assets.sprites", context));
-                atlas_menu.reset (new Atlas("menu-sprites.sprites", context));
+        if (state == UPLOADING)
+        {
+            background = Texture_2D::create (ID(bg), context, background_pixels, background_options);
 
-                if (background && atlas->good() && font->good() && atlas_menu->good())
-                {
+            //La fuente es pequeña y Raster_Font necesita el contexto para leerla, así que se carga aquí
+            font.reset (new Raster_Font("myfont.fnt", context));
 
-                    //Además de cargar las imágenes, cuando están listas asigno ciertos valores
-                    //según el tamaño de los slices
-                    dimensions = {atlas->get_slice (ID(pipes.pipedown))->width,
-                                  atlas->get_slice (ID(pipes.pipedown))->height};
+            if (background && atlas->upload (context) && atlas_menu->upload (context) && font->good())
+            {
 
-                    pause_button.size = {atlas_menu->get_slice (ID(pause_but))->width,
-                                         atlas_menu->get_slice (ID(pause_but))->height};
+                //Además de cargar las imágenes, cuando están listas asigno ciertos valores
+                //según el tamaño de los slices
+                simulation.layout.pipe_width       = atlas->get_slice (ID(pipes.pipedown))->width;
+                simulation.layout.pipe_height      = atlas->get_slice (ID(pipes.pipedown))->height;
+                simulation.layout.background_width = background->get_width ();
 
-                    context->add(background);
+                pause_button.size = {atlas_menu->get_slice (ID(pause_but))->width,
+                                     atlas_menu->get_slice (ID(pause_but))->height};
 
-                    state = RUNNING;
-                }
+                context->add(background);
+
+                state = RUNNING;
             }
+            else state = ERROR;
+
+            //La imagen ya está en la textura
+            background_pixels = Color_Buffer< Rgba8888 >();
         }
+
+        //Si la carga ha fallado se retorna false (el Director seguirá llamando, pero en ERROR no se hace nada)
+        return state == RUNNING;
     }
 
     void Game_Scene::run (float dT)
     {
         if(game_state == PLAYING)
         {
-            //Movimiento en Y del pez con gravedad
-            yForce  -= GRAVITY * dT;
-            y       += yForce * 1.5f;
-
-            //Se mueve el fondo poco a poco
-            bgx     -= dT*BGSPEED;
-            bg2x    -= dT*BGSPEED;
-
-            //Cuando los sprites del bg se salen de la pantalla +5px, se recolocan
-            if      (bgx + background->get_width()/2 + 5 < 0)               bgx = bg2x + background->get_width();
-            else if (bg2x + background->get_width()/2 + 5 < 0)              bg2x = bgx + background->get_width();
+            simulation.step (dT);
 
+            //Cuando el fondo o las tuberías se recolocan no se interpola desde su posición anterior
+            if (simulation.bgx  > previous_bgx ) previous_bgx  = simulation.bgx;
+            if (simulation.bg2x > previous_bg2x) previous_bg2x = simulation.bg2x;
 
-            //Se mueven las tuberías más rápido
-            for (int i = 0; i < pipes_size; ++i)
+            for (unsigned i = 0; i < Game_Simulation::pipes_size; ++i)
             {
-                pipes[i].pos.coordinates.x() -= dT* PIPE_SPEED;
+                if (simulation.pipes[i].x > previous_pipes_x[i]) previous_pipes_x[i] = simulation.pipes[i].x;
             }
 
-            //Comprobación salir de la pantalla de las tuberías para recolocarlas
-            unsigned index = 0;
-            for (index = 0; index < pipes_size / 2; ++index)
-            {
-                if (pipes[index].pos.coordinates.x() + dimensions.coordinates.x()/2 <= 0)
-                {
-                    unsigned previous_pos = 0;
-
-                    if (index == 0)
-                        previous_pos = pipes_size - 1;
-                    else
-                        previous_pos = index - 1;
-
-                    pipes[index].pos.coordinates.x() = pipes[index + pipes_size / 2].pos.coordinates.x() =
-                                                        pipes[previous_pos].pos.coordinates.x() + DISTANCE_X;
-                    pipes[index].pos.coordinates.y() = random_Y_pos(pipes[previous_pos].pos.coordinates.y());
-                    pipes[index + pipes_size / 2].pos.coordinates.y() = pipes[index].pos.coordinates.y() + DISTANCE_UP;
-
-                    //Suma más uno cuando la tubería sale de la pantalla
-                    add_punctuation();
-                }
-
-            }
-
-            //Colisiones con el pez, he decidido dejar un poco de cancha y en vez de chocarte
-            //con un solo píxel contra la tubería, tienes más cancha
-          for (int i = 0; i < pipes_size; ++i)
-          {
-              if(x > pipes[i].pos[0] - dimensions[0]/2
-              && x < pipes[i].pos[0] + dimensions[0]/2
-              && y > pipes[i].pos[1] - dimensions[1]/2
-              && y < pipes[i].pos[1] + dimensions[1]/2)
-              {
-                  game_state = GAME_OVER;
-              }
-          }
-
-            //Comprobación Game Over si te sales de la pantalla
-            if (y < 0 + 50 || y> canvas_height + 50) game_state = GAME_OVER;
+            if (simulation.game_over) game_state = GAME_OVER;
         }
 
     }
@@ -343,12 +355,6 @@ namespace flappyfish
         }
     }
 
-    void Game_Scene::add_punctuation()
-    {
-        ++punctuation;
-    }
-
-
     int Game_Scene::option_at (const Point2f & point)
     {
         //Para los botones de Continue, Quit y Replay
@@ -12,6 +12,7 @@
 #include <basics/Texture_2D>
 #include <basics/Atlas>
 #include <basics/Canvas>
+#include "Game_Simulation.hpp"
 
 namespace flappyfish
 {
@@ -31,7 +32,9 @@ namespace flappyfish
         enum State
         {
             LOADING,
+            UPLOADING,                  //Recursos leídos en preload(), falta crear las texturas
             RUNNING,
+            ERROR                       //No se han podido cargar los recursos
         };
 
         enum Game_state {
@@ -58,29 +61,20 @@ namespace flappyfish
         bool flying = false; //Te da feedback cuando haces tap, cambia el sprite del pez
 
         Texture_Handle background;
+        basics::Color_Buffer< basics::Rgba8888 > background_pixels;    //Imagen del fondo leída en preload()
+        basics::Texture_2D::Options              background_options;
         Atlas_Handle atlas, atlas_menu;
         Font_Handle font;
-        unsigned punctuation;
 
-        float          bgx, bgy, bg2x; //Posiciones del bg
-        float          x, y;           //Posiciones del player
-        float          yForce;         //Impulso
+        Game_Simulation simulation;    //Reglas del juego: pez, tuberías, colisiones y puntuación
 
-        const int BGSPEED = 100;       //Parallax, capa del fondo
-        static constexpr float GRAVITY = 9.8f;
+        float          bgy;            //Posición en Y del bg
 
-        struct Pipes{
-            Point2f pos;
-        };
-
-        Point2f dimensions = {0,0};
-        const int PIPE_SPEED = 200;
-        static constexpr float DISTANCE_UP = 1050; //Distancia con la tubería de arriba
-        static constexpr float DISTANCE_X = 400;   //Distancia con la tubería de la derecha
-
-        static const unsigned pipes_size = 6;
-        Pipes pipes [pipes_size];
+        //Posiciones en el paso de simulación anterior (para interpolar)
+        float          previous_bgx, previous_bg2x, previous_y;
+        float          previous_pipes_x[Game_Simulation::pipes_size];
 
+        static constexpr int   SIMULATION_RATE = 120;
 
         struct Option //Botones en menús
         {
@@ -106,28 +100,35 @@ namespace flappyfish
             return { canvas_width, canvas_height };
         }
 
+        bool is_loaded  () const override
+        {
+            return state == RUNNING;
+        }
+
         bool initialize () override;
+        void preload    () override;
+        bool upload     (basics::Graphics_Context::Accessor & context) override;
         void suspend    () override;
         void resume     () override;
+        void prioritize_resources () override;
 
         void handle     (basics::Event & event) override;
         void update     (float time) override;
+        void simulate   (float step) override;
         void render     (basics::Graphics_Context::Accessor & context) override;
 
+        //Estado de la partida (para comprobar que una sesión grabada se reproduce igual)
+        const Game_Simulation & get_simulation () const
+        {
+            return simulation;
+        }
+
     private:
 
-        void load ();
         void run  (float time);
+        void save_previous_state ();
         void draw_slice (basics::Canvas * canvas, const basics::Point2f & where, basics::Atlas & atlas, basics::Id slice_id);
-        void add_punctuation();
         int option_at (const Point2f & point);
-
-        // Saca una random Y para las tuberías que se van colocando al final según la posición en Y de la anterior
-        inline float random_Y_pos (const float previous_Y)
-        {
-            // Clamp entre dos valores para que no se salga en Y de la pantalla
-            return std::max(-200.0f, std::min( previous_Y + rand() % 500 + (-350) , 400.0f));
-        }
     };
 
 }
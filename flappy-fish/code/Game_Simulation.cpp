@@ -0,0 +1,133 @@
+/*
+ * GAME SIMULATION
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+#include "Game_Simulation.hpp"
+#include <algorithm>
+
+namespace flappyfish
+{
+
+    void Game_Simulation::reset (uint32_t seed)
+    {
+        random         = basics::Counter_Random(seed);
+        random_counter = 0;
+
+        punctuation = 0;
+        game_over   = false;
+        steps       = 0;
+
+        //Moñeco
+        y         = layout.view_height / 2;
+        yForce    = 0;
+
+        //Fondo
+        bgx       = layout.background_width / 2;
+        bg2x      = bgx + layout.background_width;
+
+        //Posición de las tuberías
+        pipes[0] = pipes[pipes_size / 2] = { layout.view_width + 250, layout.view_height / 2 - DISTANCE_UP / 2 };
+
+        //Todas las tuberías de arriba van después de las tuberías de abajo, por lo que
+        // la tubería 0 va con la 3, la 1 con la 4, etc.
+        pipes[pipes_size / 2].y += DISTANCE_UP;
+
+        //Las primeras tuberías van al medio, las siguientes en Y aleatorias
+        for (unsigned i = 1; i < pipes_size / 2; ++i)
+        {
+            pipes[i] = pipes[i + pipes_size / 2] = { pipes[i - 1].x + DISTANCE_X, random_Y_pos (pipes[i - 1].y) };
+
+            pipes[i + pipes_size / 2].y += DISTANCE_UP;
+        }
+    }
+
+    void Game_Simulation::step (float dT)
+    {
+        if (game_over) return;
+
+        ++steps;
+
+        //Movimiento en Y del pez con gravedad
+        yForce  -= GRAVITY * dT;
+        y       += fall (yForce, dT);
+
+        //Se mueve el fondo poco a poco
+        bgx     -= dT * BGSPEED;
+        bg2x    -= dT * BGSPEED;
+
+        //Cuando los sprites del bg se salen de la pantalla +5px, se recolocan
+        if      (bgx  + layout.background_width / 2 + 5 < 0) bgx  = bg2x + layout.background_width;
+        else if (bg2x + layout.background_width / 2 + 5 < 0) bg2x = bgx  + layout.background_width;
+
+        //Se mueven las tuberías más rápido
+        for (unsigned i = 0; i < pipes_size; ++i)
+        {
+            pipes[i].x -= dT * PIPE_SPEED;
+        }
+
+        //Comprobación salir de la pantalla de las tuberías para recolocarlas
+        for (unsigned index = 0; index < pipes_size / 2; ++index)
+        {
+            if (pipes[index].x + layout.pipe_width / 2 <= 0)
+            {
+                unsigned previous_pos = index == 0 ? pipes_size - 1 : index - 1;
+
+                pipes[index].x = pipes[index + pipes_size / 2].x = pipes[previous_pos].x + DISTANCE_X;
+                pipes[index].y = random_Y_pos (pipes[previous_pos].y);
+
+                pipes[index + pipes_size / 2].y = pipes[index].y + DISTANCE_UP;
+
+                //Suma más uno cuando la tubería sale de la pantalla
+                ++punctuation;
+            }
+        }
+
+        //Colisiones con el pez, con un poco de cancha: el pez es un punto
+        const float x = layout.fish_x;
+
+        for (unsigned i = 0; i < pipes_size; ++i)
+        {
+            if (x > pipes[i].x - layout.pipe_width  / 2
+             && x < pipes[i].x + layout.pipe_width  / 2
+             && y > pipes[i].y - layout.pipe_height / 2
+             && y < pipes[i].y + layout.pipe_height / 2)
+            {
+                game_over = true;
+            }
+        }
+
+        //Comprobación Game Over si te sales de la pantalla
+        if (y < 0 + 50 || y > layout.view_height + 50) game_over = true;
+    }
+
+    float Game_Simulation::random_Y_pos (float previous_Y)
+    {
+        // Clamp entre dos valores para que no se salga en Y de la pantalla
+        return std::max (-200.0f, std::min (previous_Y + float(int(random.at (random_counter++) % 500) - 350), 400.0f));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Gap_Bot::flap (const Game_Simulation & game) const
+    {
+        // La siguiente tubería de abajo que el pez no ha pasado todavía:
+
+        const Game_Simulation::Pipe * next = nullptr;
+
+        for (unsigned i = 0; i < Game_Simulation::pipes_size / 2; ++i)
+        {
+            const Game_Simulation::Pipe & pipe = game.pipes[i];
+
+            if (pipe.x + game.layout.pipe_width / 2 > game.layout.fish_x && (!next || pipe.x < next->x)) next = &pipe;
+        }
+
+        // El hueco va del borde de arriba de la tubería de abajo al borde de abajo de su pareja:
+
+        float gap_center = next ? next->y + Game_Simulation::DISTANCE_UP / 2 : game.layout.view_height / 2;
+
+        return game.yForce <= 0.f && game.y < gap_center - margin;
+    }
+
+}
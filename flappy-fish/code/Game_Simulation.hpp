@@ -0,0 +1,139 @@
+/*
+ * GAME SIMULATION
+ * Copyright © 2021+ María López Ausín
+ * @version 1.0.0
+ */
+
+#ifndef GAME_SIMULATION_HEADER
+#define GAME_SIMULATION_HEADER
+
+#include <cstdint>
+#include <basics/Random>
+
+namespace flappyfish
+{
+
+    // Reglas del juego (física del pez, tuberías, colisiones y puntuación) sin nada de dibujado ni
+    // estado global: cada partida tiene su propio generador aleatorio, de modo que se pueden simular
+    // muchas a la vez (ver Batch_Runner) y una semilla da siempre la misma partida. El generador se
+    // basa en un contador (la tubería n usa el número n), así que una partida repetida o jugada en
+    // un carril de Game_Batch recibe exactamente las mismas tuberías.
+
+    class Game_Simulation
+    {
+    public:
+
+        static constexpr float GRAVITY     = 9.8f;
+        static constexpr float TUNING_RATE = 60.f;       // El impulso se ajustó para pasos de 1/60 s
+        static constexpr float FLAP_FORCE  = 5.f;
+        static constexpr float BGSPEED     = 100.f;      // Parallax, capa del fondo
+        static constexpr float PIPE_SPEED  = 200.f;
+        static constexpr float DISTANCE_UP = 1050.f;     // Distancia con la tubería de arriba
+        static constexpr float DISTANCE_X  = 400.f;      // Distancia con la tubería de la derecha
+
+        static const unsigned pipes_size = 6;            // Las primeras son las de abajo y las de después sus parejas
+
+        struct Pipe
+        {
+            float x;
+            float y;
+        };
+
+        // Tamaños que dependen de los assets. Por defecto son los de game-assets.sprites y
+        // fondo.png para poder simular sin cargarlos:
+
+        struct Layout
+        {
+            float view_width       = 720.f;
+            float view_height      = 1280.f;
+            float fish_x           = 100.f;
+            float pipe_width       = 149.f;
+            float pipe_height      = 804.f;
+            float background_width = 1280.f;
+        };
+
+    public:
+
+        Layout   layout;
+
+        float    y;                                      // Posición del pez
+        float    yForce;                                 // Impulso
+        float    bgx, bg2x;                              // Posiciones del bg
+        Pipe     pipes[pipes_size];
+        unsigned punctuation;
+        bool     game_over;
+        uint64_t steps;                                  // Pasos simulados desde reset()
+
+        basics::Counter_Random random;
+        uint32_t               random_counter;           // Números aleatorios usados desde reset()
+
+    public:
+
+        Game_Simulation()
+        {
+            reset (1);
+        }
+
+        // Empieza una partida nueva. Las tuberías se colocan con el generador iniciado con la semilla:
+        void reset (uint32_t seed);
+
+        // Lo que hace un tap durante la partida:
+        void flap ()
+        {
+            yForce = FLAP_FORCE;
+        }
+
+        // Avanza la partida dT segundos (no hace nada si ya ha terminado):
+        void step (float dT);
+
+        // Cuánto se mueve el pez en Y en un paso de dT segundos que termina con el impulso force.
+        // El juego original movía el pez yForce * 1.5 por fotograma a 60 fps después de restarle la
+        // gravedad. Esto integra de forma exacta ese mismo movimiento, así que con pasos de 1/60 s
+        // da lo mismo que el original y con pasos más cortos (Game_Scene simula a 120 Hz) el pez
+        // pasa por las mismas posiciones al final de cada 1/60 s (ver flappy-fish-trajectory-check):
+        static float fall (float force, float dT)
+        {
+            return force * 1.5f * TUNING_RATE * dT + GRAVITY * 1.5f * TUNING_RATE * dT * (dT - 1.f / TUNING_RATE) * .5f;
+        }
+
+    private:
+
+        // Saca una random Y para las tuberías que se van colocando al final según la posición en Y de la anterior
+        float random_Y_pos (float previous_Y);
+    };
+
+    // Decide en cada paso de la simulación si el pez debe impulsarse. Se comparte entre los hilos
+    // de Batch_Runner, así que no debe modificar su propio estado.
+
+    class Bot_Policy
+    {
+    public:
+
+        virtual ~Bot_Policy() = default;
+
+        virtual bool flap (const Game_Simulation & game) const = 0;
+    };
+
+    // Bot que se impulsa cuando cae por debajo del centro del hueco de la siguiente tubería:
+
+    class Gap_Bot : public Bot_Policy
+    {
+        float margin;
+
+    public:
+
+        Gap_Bot(float margin = 0.f) : margin(margin)
+        {
+        }
+
+        float get_margin () const
+        {
+            return margin;
+        }
+
+        bool flap (const Game_Simulation & game) const override;
+    };
+
+}
+
+#endif
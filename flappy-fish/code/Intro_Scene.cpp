@@ -22,10 +22,12 @@ namespace flappyfish
         }
         else
         {
-            timer.reset ();
+            elapsed_seconds = 0.f;
 
             opacity = 0.f;
             state   = FADING_IN;
+
+            preload_next_scene ();
         }
         return true;
     }
@@ -37,9 +39,9 @@ namespace flappyfish
         if (!suspended) switch (state)
             {
                 case LOADING:    update_loading    (); break;
-                case FADING_IN:  update_fading_in  (); break;
-                case WAITING:    update_waiting    (); break;
-                case FADING_OUT: update_fading_out (); break;
+                case FADING_IN:  update_fading_in  (time); break;
+                case WAITING:    update_waiting    (time); break;
+                case FADING_OUT: update_fading_out (time); break;
                 default: break;
             }
     }
@@ -80,6 +82,15 @@ namespace flappyfish
         }
     }
 
+    void Intro_Scene::preload_next_scene ()
+    {
+        // El menú carga sus recursos mientras se muestra el logo, así que aparece sin esperas:
+
+        next_scene = make_shared< Menu_Scene > ();
+
+        director.preload_scene (next_scene);
+    }
+
     void Intro_Scene::update_loading ()
     {
         Graphics_Context::Accessor context = director.lock_graphics_context ();
@@ -96,19 +107,21 @@ namespace flappyfish
             {
                 context->add (logo_texture);
 
-                timer.reset ();
+                elapsed_seconds = 0.f;
 
                 opacity = 0.f;
                 state   = FADING_IN;
+
+                preload_next_scene ();
             }
             else
                 state   = ERROR;
         }
     }
 
-    void Intro_Scene::update_fading_in ()
+    void Intro_Scene::update_fading_in (float time)
     {
-        float elapsed_seconds = timer.get_elapsed_seconds ();
+        elapsed_seconds += time;
 
         if (elapsed_seconds < 1.f)
         {
@@ -116,28 +129,30 @@ namespace flappyfish
         }
         else
         {
-            timer.reset ();
+            elapsed_seconds = 0.f;
 
             opacity = 1.f;
             state   = WAITING;
         }
     }
 
-    void Intro_Scene::update_waiting ()
+    void Intro_Scene::update_waiting (float time)
     {
+        elapsed_seconds += time;
+
         // Se esperan dos segundos sin hacer nada:
 
-        if (timer.get_elapsed_seconds () > 2.f)
+        if (elapsed_seconds > 2.f)
         {
-            timer.reset ();
+            elapsed_seconds = 0.f;
 
             state = FADING_OUT;
         }
     }
 
-    void Intro_Scene::update_fading_out ()
+    void Intro_Scene::update_fading_out (float time)
     {
-        float elapsed_seconds = timer.get_elapsed_seconds ();
+        elapsed_seconds += time;
 
         if (elapsed_seconds < .5f)
         {
@@ -145,11 +160,13 @@ namespace flappyfish
         }
         else
         {
-            // Cuando el faceout se ha completado, se lanza la siguiente escena:
+            // Cuando el faceout se ha completado, se lanza la siguiente escena, que ya está cargada:
 
             state = FINISHED;
 
-            director.run_scene (shared_ptr< Scene >(new Menu_Scene));
+            director.run_scene (next_scene);
+
+            next_scene.reset ();
 
         }
     }
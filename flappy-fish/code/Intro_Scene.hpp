@@ -11,13 +11,12 @@
 #include <basics/Canvas>
 #include <basics/Scene>
 #include <basics/Texture_2D>
-#include <basics/Timer>
 
 namespace flappyfish
 {
 
-    using basics::Timer;
     using basics::Canvas;
+    using basics::Scene;
     using basics::Texture_2D;
     using basics::Graphics_Context;
 
@@ -42,11 +41,12 @@ namespace flappyfish
         unsigned canvas_width;                              ///< Ancho de la resolución virtual usada para dibujar.
         unsigned canvas_height;                             ///< Alto  de la resolución virtual usada para dibujar.
 
-        Timer    timer;                                     ///< Cronómetro usado para medir intervalos de tiempo.
+        float    elapsed_seconds;                           ///< Tiempo transcurrido en el estado actual (según los pasos de tiempo de update()).
 
         float    opacity;                                   ///< Opacidad de la textura.
 
         std::shared_ptr < Texture_2D > logo_texture;        ///< Textura que contiene la imagen del logo.
+        std::shared_ptr < Scene      > next_scene;          ///< Escena del menú, que se carga mientras se muestra el logo.
 
     public:
 
@@ -68,6 +68,11 @@ namespace flappyfish
             return { canvas_width, canvas_height };
         }
 
+        bool is_loaded () const override
+        {
+            return state != UNINITIALIZED && state != LOADING && state != ERROR;
+        }
+
         bool initialize () override;
 
         void suspend () override
@@ -84,12 +89,20 @@ namespace flappyfish
 
         void render (Graphics_Context::Accessor & context) override;
 
+        void prioritize_resources () override
+        {
+            // El logo es lo único que se dibuja, así que se restaura antes que el resto:
+
+            if (logo_texture) logo_texture->set_priority (basics::Graphics_Resource::HIGH);
+        }
+
     private:
 
-        void update_loading    ();
-        void update_fading_in  ();
-        void update_waiting    ();
-        void update_fading_out ();
+        void preload_next_scene ();
+        void update_loading     ();
+        void update_fading_in   (float time);
+        void update_waiting     (float time);
+        void update_fading_out  (float time);
 
     };
 
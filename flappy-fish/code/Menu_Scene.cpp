@@ -32,6 +32,93 @@ namespace flappyfish
         pressed_false();
 
         help_button.position = {canvas_width*0.9, canvas_height*0.1f };
+
+        //La partida se carga mientras el jugador está en el menú para que empiece sin esperas
+        if (!next_scene)
+        {
+            next_scene = make_shared< Game_Scene > ();
+            director.preload_scene (next_scene);
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Menu_Scene::uncover ()
+    {
+        //Se vuelve de la partida: el menú sigue cargado y la partida también (se conserva en
+        //next_scene), así que la siguiente empieza con los mismos recursos al reiniciarla initialize()
+        pressed_false();
+
+        is_showing_help = false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Menu_Scene::evict ()
+    {
+        //Falta memoria mientras se juega: se sueltan las texturas y se vuelven a cargar en update()
+        //cuando se vuelva al menú
+        if (state == READY)
+        {
+            background.reset ();
+            atlas.reset ();
+
+            state = LOADING;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Menu_Scene::prioritize_resources ()
+    {
+        //Al recrearse el contexto gráfico se restauran antes las texturas del menú que las de la partida
+        if (background) background->set_priority (Graphics_Resource::HIGH);
+        if (atlas     ) atlas     ->set_priority (Graphics_Resource::HIGH);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Menu_Scene::preload ()
+    {
+        //Solo se leen los archivos y se decodifican las imágenes (no hace falta el contexto gráfico)
+        atlas.reset (new Atlas("menu-sprites.sprites"));
+
+        if (Texture_2D::decode ("fondo.png", background_pixels, background_options) && atlas->is_pending_upload ())
+        {
+            state = UPLOADING;
+        }
+        else state = ERROR;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Menu_Scene::upload (Graphics_Context::Accessor & context)
+    {
+        if (state == UPLOADING)
+        {
+            background = Texture_2D::create (ID(bg), context, background_pixels, background_options);
+
+            // Si las texturas se han podido crear el estado es READY y, en otro caso, es ERROR:
+            if (background && atlas->upload (context))
+            {
+                context->add(background);
+                state = READY;
+
+                //Inicializo tamaños según slice
+                help_button.size = {atlas->get_slice (ID(help_but))->width,
+                                    atlas->get_slice (ID(help_but))->height};
+
+                // Si el atlas está disponible, se inicializan los datos de las opciones del menú:
+                configure_options ();
+            }
+            else state = ERROR;
+
+            //La imagen ya está en la textura
+            background_pixels = Color_Buffer< Rgba8888 >();
+        }
+
         return true;
     }
 
@@ -48,7 +135,7 @@ namespace flappyfish
                 {
                     // Se determina qué opción se ha tocado:
 
-                    Point2f touch_location = { *event[ID(x)].as< var::Float > (), *event[ID(y)].as< var::Float > () };
+                    Point2f touch_location = { event.touch ().x, event.touch ().y };
                     int     option_touched = option_at (touch_location);
 
                     // Solo se puede tocar una opción a la vez (para evitar selecciones múltiples),
@@ -70,11 +157,12 @@ namespace flappyfish
                     if(!is_showing_help) //Si no está la pantalla de ayuda puedes seleccionar los botones
                     {
                         // Se determina qué opción se ha dejado de tocar la última y se actúa como corresponda:
-                        Point2f touch_location = { *event[ID(x)].as< var::Float > (), *event[ID(y)].as< var::Float > () };
+                        Point2f touch_location = { event.touch ().x, event.touch ().y };
 
-                        if (option_at (touch_location) == PLAY)
+                        if (option_at (touch_location) == PLAY && next_scene)
                         {
-                            director.run_scene (shared_ptr< Scene >(new Game_Scene));
+                            //El menú se queda debajo de la partida para volver a él sin cargarlo de nuevo
+                            director.push_scene (next_scene);
                         }
                         else if (option_at (touch_location) == QUIT)
                         {
@@ -102,33 +190,17 @@ namespace flappyfish
 
     void Menu_Scene::update (float time)
     {
-        if (!suspended) if (state == LOADING)
+        // Si la escena no se ha cargado antes con Director::preload_scene(), se carga ahora:
+
+        if (!suspended) if (state == LOADING) preload ();
+
+        if (!suspended) if (state == UPLOADING)
             {
                 Graphics_Context::Accessor context = director.lock_graphics_context ();
 
                 if (context)
                 {
-                    background = Texture_2D::create (ID(bg), context, "fondo.png");
-                    atlas.reset (new Atlas("menu-sprites.sprites", context));
-
-                    // Si el atlas se ha podido cargar el estado es READY y, en otro caso, es ERROR:
-                    if(atlas->good () && background)
-                    {
-                        context->add(background);
-                        state = READY;
-
-                        //Inicializo tamaños según slice
-                        help_button.size = {atlas->get_slice (ID(help_but))->width,
-                                            atlas->get_slice (ID(help_but))->height};
-                    }
-                    else state = ERROR;
-
-                    // Si el atlas está disponible, se inicializan los datos de las opciones del menú:
-
-                    if (state == READY)
-                    {
-                        configure_options ();
-                    }
+                    upload (context);
                 }
             }
     }
@@ -12,6 +12,7 @@
 #include <basics/Canvas>
 #include <basics/Point>
 #include <basics/Scene>
+#include <basics/Texture_2D>
 
 namespace flappyfish
 {
@@ -31,6 +32,7 @@ namespace flappyfish
         enum State
         {
             LOADING,
+            UPLOADING,                          // Recursos leídos en preload(), falta crear las texturas
             READY,
             ERROR
         };
@@ -43,6 +45,9 @@ namespace flappyfish
 
         Texture_Handle background;
 
+        basics::Color_Buffer< basics::Rgba8888 > background_pixels;    //Imagen del fondo leída en preload()
+        Texture_2D::Options                      background_options;
+
         struct Option
         {
             const Atlas::Slice * slice;
@@ -71,6 +76,8 @@ namespace flappyfish
         Help_Button help_button;
 
         bool is_showing_help = false;
+
+        std::shared_ptr< basics::Scene > next_scene;   //Partida que se carga mientras se muestra el menú y se reutiliza en las siguientes
     public:
 
         Menu_Scene();
@@ -80,7 +87,14 @@ namespace flappyfish
             return { canvas_width, canvas_height };
         }
 
+        bool is_loaded () const override
+        {
+            return state == READY;
+        }
+
         bool initialize () override;
+        void preload    () override;
+        bool upload     (Graphics_Context::Accessor & context) override;
 
         void suspend () override
         {
@@ -92,6 +106,10 @@ namespace flappyfish
             suspended = false;
         }
 
+        void uncover () override;
+        void evict   () override;
+        void prioritize_resources () override;
+
         void handle (basics::Event & event) override;
         void update (float time) override;
         void render (Graphics_Context::Accessor & context) override;
@@ -14,6 +14,17 @@
 #include <basics/opengles/OpenGL_ES2>
 #include "Intro_Scene.hpp"
 
+#if defined(BASICS_LINUX_OS)
+    #include <cstdio>
+    #include <cstdlib>
+    #include <basics/Headless>
+    #include <basics/Input_Recording>
+#endif
+
+#if defined(FLAPPY_FISH_SPRITE_STRESS)
+    #include <basics/Sprite_Stress_Scene>
+#endif
+
 using namespace basics;
 using namespace flappyfish;
 using namespace std;
@@ -24,9 +35,75 @@ int main ()
 
     enable< basics::OpenGL_ES2 > ();
 
+    #if defined(BASICS_LINUX_OS)
+
+        // Sin pantalla el juego termina tras los fotogramas de BASICS_FRAME_LIMIT (si no es 0):
+
+        director.set_frame_limit (Headless::get_frame_limit ());
+
+        // También se puede grabar la sesión en un archivo (FLAPPY_FISH_RECORD=ruta) o reproducir
+        // una grabada (FLAPPY_FISH_REPLAY=ruta), que termina al acabar la grabación:
+
+        const char * record_path = getenv ("FLAPPY_FISH_RECORD");
+        const char * replay_path = getenv ("FLAPPY_FISH_REPLAY");
+
+        Input_Recording recording;
+
+        if (replay_path && *replay_path)
+        {
+            if (recording.load (replay_path))
+            {
+                director.replay_input (&recording);
+            }
+            else
+            {
+                fprintf (stderr, "the input recording %s couldn't be loaded\n", replay_path);
+                return EXIT_FAILURE;
+            }
+        }
+        else if (record_path && *record_path)
+        {
+            director.record_input (&recording);
+        }
+
+    #endif
+
     // Se crea una escena y se inicia mediante el Director:
 
-    director.run_scene (shared_ptr< Scene >(new Intro_Scene));
+    #if defined(FLAPPY_FISH_SPRITE_STRESS)
+
+        // En lugar del juego se mide cuántos sprites se pueden dibujar a 60 Hz en el dispositivo.
+        // El resultado se escribe en el log y la escena sigue dibujando ese número de sprites:
+
+        shared_ptr< Sprite_Stress_Scene > stress_scene = make_shared< Sprite_Stress_Scene >
+        (
+            "game-assets.sprites",
+            vector< Id >{ ID(player.1), ID(player.2) },
+            "myfont.fnt"
+        );
+
+        stress_scene->set_stop_when_done (false);
+
+        director.run_scene (stress_scene);
+
+    #else
+
+        director.run_scene (make_shared< Intro_Scene > ());
+
+    #endif
+
+    #if defined(BASICS_LINUX_OS)
+
+        director.record_input (nullptr);
+        director.replay_input (nullptr);
+
+        if (record_path && *record_path && !(replay_path && *replay_path) && !recording.save (record_path))
+        {
+            fprintf (stderr, "the input recording couldn't be saved to %s\n", record_path);
+            return EXIT_FAILURE;
+        }
+
+    #endif
 
     return 0;
 }
@@ -16,6 +16,7 @@
 
     #include <android/asset_manager.h>
     #include <basics/Asset>
+    #include <basics/Small_Object_Pool>
     #include "Android_Asset.hpp"
     #include "Native_Activity.hpp"
 
@@ -24,7 +25,7 @@
 
         std::shared_ptr< Asset > Asset::open (const std::string & path)
         {
-            std::shared_ptr< Asset > asset(new internal::Android_Asset(path));
+            std::shared_ptr< Asset > asset = make_pooled< internal::Android_Asset > (path);
 
             if (!asset->good ())
             {
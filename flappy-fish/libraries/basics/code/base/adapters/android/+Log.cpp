@@ -29,9 +29,28 @@
             ANDROID_LOG_FATAL,
         };
 
-        void Log::dump (Level level, const char * tag, const char * cstring)
+        /**
+         * Canal que envía los mensajes al logcat de Android.
+         */
+        class Logcat_Channel : public Log::Channel
         {
-            __android_log_write (android_log_priorities[level], tag ? tag : "*", cstring);
+        public:
+
+            void write (const Log::Record & record) override
+            {
+                __android_log_write (android_log_priorities[record.level], record.tag ? record.tag : "*", record.text);
+            }
+
+        };
+
+        std::shared_ptr< Log::Channel > Log::create_default_channel ()
+        {
+            return std::make_shared< Logcat_Channel > ();
+        }
+
+        void Log::report_error (const char * message)
+        {
+            __android_log_write (ANDROID_LOG_ERROR, "log", message);
         }
 
         Log log;
@@ -36,13 +36,20 @@
                         {
                             int32_t index = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
 
-                            Event event(ID(touch-started));
-
-                            event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
-                            event[ID(x) ] = AMotionEvent_getX         (android_event, index);
-                            event[ID(y) ] = AMotionEvent_getY         (android_event, index);
-
-                            director.handle (event);
+                            director.handle
+                            (
+                                Event
+                                (
+                                    ID(touch-started),
+                                    Event::Touch
+                                    {
+                                        AMotionEvent_getPointerId (android_event, index),
+                                        AMotionEvent_getX         (android_event, index),
+                                        AMotionEvent_getY         (android_event, index)
+                                    },
+                                    AMotionEvent_getEventTime (android_event)
+                                )
+                            );
 
                             break;
                         }
@@ -54,16 +61,53 @@
                             // se envían eventos de movimiento para todos los punteros...
 
                             size_t pointer_count = AMotionEvent_getPointerCount (android_event);
+                            size_t history_size  = AMotionEvent_getHistorySize  (android_event);
 
-                            for (size_t index = 0; index < pointer_count; ++index)
+                            // Android agrupa en un mismo evento las muestras intermedias que el controlador táctil
+                            // ha tomado desde el anterior. Se envían todas (el Director funde los movimientos de
+                            // cada puntero en uno por fotograma y guarda el resto en su historial):
+
+                            for (size_t sample = 0; sample < history_size; ++sample)
                             {
-                                Event event(ID(touch-moved));
+                                int64_t timestamp = AMotionEvent_getHistoricalEventTime (android_event, sample);
+
+                                for (size_t index = 0; index < pointer_count; ++index)
+                                {
+                                    director.handle
+                                    (
+                                        Event
+                                        (
+                                            ID(touch-moved),
+                                            Event::Touch
+                                            {
+                                                AMotionEvent_getPointerId   (android_event, index),
+                                                AMotionEvent_getHistoricalX (android_event, index, sample),
+                                                AMotionEvent_getHistoricalY (android_event, index, sample)
+                                            },
+                                            timestamp
+                                        )
+                                    );
+                                }
+                            }
 
-                                event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
-                                event[ID(x) ] = AMotionEvent_getX         (android_event, index);
-                                event[ID(y) ] = AMotionEvent_getY         (android_event, index);
+                            int64_t timestamp = AMotionEvent_getEventTime (android_event);
 
-                                director.handle (event);
+                            for (size_t index = 0; index < pointer_count; ++index)
+                            {
+                                director.handle
+                                (
+                                    Event
+                                    (
+                                        ID(touch-moved),
+                                        Event::Touch
+                                        {
+                                            AMotionEvent_getPointerId (android_event, index),
+                                            AMotionEvent_getX         (android_event, index),
+                                            AMotionEvent_getY         (android_event, index)
+                                        },
+                                        timestamp
+                                    )
+                                );
                             }
 
                             break;
@@ -75,13 +119,20 @@
                         {
                             int32_t index = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
 
-                            Event event(ID(touch-ended));
-
-                            event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
-                            event[ID(x) ] = AMotionEvent_getX         (android_event, index);
-                            event[ID(y) ] = AMotionEvent_getY         (android_event, index);
-
-                            director.handle (event);
+                            director.handle
+                            (
+                                Event
+                                (
+                                    ID(touch-ended),
+                                    Event::Touch
+                                    {
+                                        AMotionEvent_getPointerId (android_event, index),
+                                        AMotionEvent_getX         (android_event, index),
+                                        AMotionEvent_getY         (android_event, index)
+                                    },
+                                    AMotionEvent_getEventTime (android_event)
+                                )
+                            );
 
                             break;
                         }
@@ -92,8 +143,29 @@
             return true;
         }
 
-        int handle_key_event (AInputEvent * event)
+        int handle_key_event (AInputEvent * android_event)
         {
+            int32_t action = AKeyEvent_getAction (android_event);
+
+            if (action == AKEY_EVENT_ACTION_DOWN || action == AKEY_EVENT_ACTION_UP)
+            {
+                director.handle
+                (
+                    Event
+                    (
+                        action == AKEY_EVENT_ACTION_DOWN ? ID(key-pressed) : ID(key-released),
+                        Event::Key
+                        {
+                            AKeyEvent_getKeyCode   (android_event),
+                            AKeyEvent_getMetaState (android_event)
+                        },
+                        AKeyEvent_getEventTime (android_event)
+                    )
+                );
+            }
+
+            // Las teclas no se consumen para que el sistema las siga gestionando (p. ej. BACK):
+
             return false;
         }
 
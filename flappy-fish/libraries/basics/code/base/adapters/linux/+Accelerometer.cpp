@@ -0,0 +1,36 @@
+/*
+ * ACCELEROMETER
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <basics/Accelerometer>
+
+    namespace basics
+    {
+
+        // Sin dispositivo no hay acelerómetro (se puede simular con set_state() en otras plataformas):
+
+        bool Accelerometer::is_available ()
+        {
+            return false;
+        }
+
+        Accelerometer * Accelerometer::get_instance ()
+        {
+            return nullptr;
+        }
+
+    }
+
+#endif
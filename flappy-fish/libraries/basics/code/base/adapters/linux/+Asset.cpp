@@ -0,0 +1,48 @@
+/*
+ * ASSET
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <basics/Asset>
+    #include <basics/Small_Object_Pool>
+    #include "File_Asset.hpp"
+
+    namespace basics
+    {
+
+        std::shared_ptr< Asset > Asset::open (const std::string & path)
+        {
+            std::shared_ptr< Asset > asset = make_pooled< internal::File_Asset > (path);
+
+            if (!asset->good ())
+            {
+                 asset.reset ();
+            }
+
+            return asset;
+        }
+
+        bool Asset::exists (const std::string & path)
+        {
+            return internal::File_Asset(path).good ();
+        }
+
+        size_t Asset::size (const std::string & path)
+        {
+            return internal::File_Asset(path).size ();
+        }
+
+    }
+
+#endif
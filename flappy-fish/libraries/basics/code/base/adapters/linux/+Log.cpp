@@ -0,0 +1,35 @@
+/*
+ * LOG
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#include <basics/Log>
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    namespace basics
+    {
+
+        std::shared_ptr< Log::Channel > Log::create_default_channel ()
+        {
+            return std::make_shared< Log::Stdout_Channel > ();
+        }
+
+        void Log::report_error (const char * message)
+        {
+            fprintf (stderr, "E/log: %s\n", message);
+        }
+
+        Log log;
+
+    }
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * WINDOW
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <basics/Application>
+    #include <basics/Headless>
+    #include "Headless_Window.hpp"
+
+    namespace basics
+    {
+
+        namespace
+        {
+
+            // Solo existe la ventana por defecto y se crea y destruye desde el hilo del Director:
+
+            std::shared_ptr< internal::Headless_Window > default_window;
+
+        }
+
+        const bool Window::can_be_instantiated __attribute__((__used__)) = true;
+
+        Window::Handle Window::create_window (Id id)
+        {
+            if (id == default_window_id)
+            {
+                if (!default_window)
+                {
+                    default_window = std::make_shared< internal::Headless_Window > (id, Headless::get_surface_size ());
+
+                    application.push (Event(Application::Event_Id::WINDOW_CREATED));
+                }
+
+                return Handle(default_window);
+            }
+
+            return Handle();
+        }
+
+        bool Window::destroy_window (Id id)
+        {
+            if (id == default_window_id && default_window)
+            {
+                default_window.reset ();
+
+                application.push (Event(Application::Event_Id::WINDOW_DESTROYED));
+
+                return true;
+            }
+
+            return false;
+        }
+
+        Window::Handle Window::get_window (Id id)
+        {
+            if (id == default_window_id && default_window)
+            {
+                return Handle(default_window);
+            }
+
+            return Handle();
+        }
+
+    }
+
+#endif
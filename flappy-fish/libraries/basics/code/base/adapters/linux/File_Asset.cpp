@@ -0,0 +1,159 @@
+/*
+ * FILE ASSET
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <basics/Headless>
+    #include "File_Asset.hpp"
+
+    namespace basics { namespace internal
+    {
+
+        File_Asset::File_Asset(const std::string & path)
+        {
+            handle = fopen ((Headless::get_assets_path () + '/' + path).c_str (), "rb");
+            length = 0;
+            cursor = 0;
+            failed = handle == nullptr;
+            at_end = false;
+
+            if (handle)
+            {
+                // El tamaño se averigua una sola vez porque los assets no cambian mientras están abiertos:
+
+                if (fseek (handle, 0, SEEK_END) == 0)
+                {
+                    long end = ftell (handle);
+
+                    length = end > 0 ? size_t(end) : 0;
+                }
+
+                failed = fseek (handle, 0, SEEK_SET) != 0;
+            }
+        }
+
+        File_Asset::~File_Asset()
+        {
+            if (handle != nullptr)
+            {
+                fclose (handle), handle = nullptr;
+            }
+        }
+
+        bool File_Asset::good () const
+        {
+            return not failed;
+        }
+
+        bool File_Asset::fail () const
+        {
+            return failed;
+        }
+
+        bool File_Asset::eof () const
+        {
+            return at_end;
+        }
+
+        size_t File_Asset::size () const
+        {
+            return good () ? length : 0;
+        }
+
+        bool File_Asset::seek (ptrdiff_t offset, Anchor anchor)
+        {
+            if (good ())
+            {
+                if (fseek (handle, long(offset), anchor == BEGINNING ? SEEK_SET : anchor == END ? SEEK_END : SEEK_CUR) == 0)
+                {
+                    cursor = size_t(ftell (handle));
+                    at_end = false;
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        size_t File_Asset::tell () const
+        {
+            return cursor;
+        }
+
+        byte File_Asset::read ()
+        {
+            byte data = 0;
+
+            if (good ())
+            {
+                read (&data, 1);
+            }
+
+            return data;
+        }
+
+        bool File_Asset::read_all (std::vector< byte > & buffer)
+        {
+            if (good () && seek (0, BEGINNING))
+            {
+                buffer.resize (length);
+
+                return read (buffer.data (), length);
+            }
+
+            return false;
+        }
+
+        bool File_Asset::read_all (std::string & buffer)
+        {
+            if (good () && seek (0, BEGINNING))
+            {
+                buffer.resize (length);
+
+                return read ((uint8_t *)&buffer[0], length);
+            }
+
+            return false;
+        }
+
+        bool File_Asset::read (uint8_t * buffer, size_t size)
+        {
+            if (size > 0)
+            {
+                size_t result = fread (buffer, 1, size, handle);
+
+                cursor += result;
+
+                if (result == size)
+                {
+                    return true;
+                }
+                else
+                if (feof (handle))
+                {
+                    at_end = true;
+                }
+                else
+                    failed = true;
+
+                return false;
+            }
+
+            return true;
+        }
+
+    }}
+
+#endif
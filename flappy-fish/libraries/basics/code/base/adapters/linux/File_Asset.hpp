@@ -0,0 +1,60 @@
+/*
+ * FILE ASSET
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#ifndef BASICS_FILE_ASSET_HEADER
+#define BASICS_FILE_ASSET_HEADER
+
+    #include <cstdio>
+    #include <basics/Asset>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Asset que se lee de un archivo de la carpeta de assets (ver Headless::set_assets_path()).
+         */
+        class File_Asset final : public Asset
+        {
+
+            FILE   * handle;
+            size_t   length;
+            size_t   cursor;
+            bool     failed;
+            bool     at_end;
+
+        public:
+
+            File_Asset(const std::string & path);
+           ~File_Asset();
+
+        public:
+
+            bool   good () const override;
+            bool   fail () const override;
+            bool   eof  () const override;
+
+            size_t size () const override;
+            bool   seek (ptrdiff_t offset, Anchor = CURRENT) override;
+            size_t tell () const override;
+            byte   read () override;
+            bool   read_all (std::vector< byte > & buffer) override;
+            bool   read_all (std::string & buffer) override;
+
+        private:
+
+            bool read (uint8_t * buffer, size_t size);
+
+        };
+
+    }}
+
+#endif
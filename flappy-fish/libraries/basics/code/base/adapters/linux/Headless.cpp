@@ -0,0 +1,101 @@
+/*
+ * HEADLESS
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <cstdio>
+    #include <cstdlib>
+    #include <basics/Headless>
+    #include "Linux_Application.hpp"
+
+    namespace basics
+    {
+
+        namespace
+        {
+
+            struct Options
+            {
+                std::string assets_path;
+                Size2u      surface_size;
+                uint64_t    frame_limit;
+
+                Options()
+                {
+                    const char * path   = getenv ("BASICS_ASSETS_PATH");
+                    const char * size   = getenv ("BASICS_SURFACE_SIZE");
+                    const char * frames = getenv ("BASICS_FRAME_LIMIT");
+
+                    assets_path  = path && *path ? path : "assets";
+                    surface_size = { 720, 1280 };
+                    frame_limit  = frames && *frames ? strtoull (frames, nullptr, 10) : 0;
+
+                    unsigned width, height;
+
+                    if (size && sscanf (size, "%ux%u", &width, &height) == 2)
+                    {
+                        surface_size = { width, height };
+                    }
+                }
+            };
+
+            Options & get_options ()
+            {
+                static Options options;
+                return options;
+            }
+
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Headless::set_assets_path (const std::string & path)
+        {
+            get_options ().assets_path = path;
+        }
+
+        const std::string & Headless::get_assets_path ()
+        {
+            return get_options ().assets_path;
+        }
+
+        void Headless::set_surface_size (const Size2u & size)
+        {
+            get_options ().surface_size = size;
+        }
+
+        Size2u Headless::get_surface_size ()
+        {
+            return get_options ().surface_size;
+        }
+
+        void Headless::set_frame_limit (uint64_t frames)
+        {
+            get_options ().frame_limit = frames;
+        }
+
+        uint64_t Headless::get_frame_limit ()
+        {
+            return get_options ().frame_limit;
+        }
+
+        void Headless::quit ()
+        {
+            internal::application.set_state (Application::DESTROYED);
+            internal::application.push      (Event(Application::Event_Id::QUIT));
+        }
+
+    }
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * HEADLESS WINDOW
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#ifndef BASICS_HEADLESS_WINDOW_HEADER
+#define BASICS_HEADLESS_WINDOW_HEADER
+
+    #include <basics/Window>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Ventana que no se muestra en ninguna pantalla. Está disponible y tiene el foco desde que se
+         * crea. Su tamaño es el de la superficie fuera de pantalla (0 si no la hay).
+         */
+        class Headless_Window final : public Window
+        {
+        public:
+
+            class Accessor : public Window::Accessor
+            {
+            public:
+
+                Headless_Window * get ()
+                {
+                    return static_cast< Headless_Window * >(window.get ());
+                }
+
+            };
+
+        private:
+
+            Size2u size;
+
+        public:
+
+            Headless_Window(Id id, const Size2u & size) : Window(id), size(size)
+            {
+                available = true;
+                focused   = true;
+
+                event_queue.push (Event(GOT_FOCUS));
+            }
+
+        public:
+
+            Size2u get_size () override
+            {
+                return size;
+            }
+
+            unsigned get_width () override
+            {
+                return size.width;
+            }
+
+            unsigned get_height () override
+            {
+                return size.height;
+            }
+
+        };
+
+    }}
+
+#endif
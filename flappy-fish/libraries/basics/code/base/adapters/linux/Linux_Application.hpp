@@ -0,0 +1,63 @@
+/*
+ * LINUX APPLICATION
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#ifndef BASICS_LINUX_APPLICATION_HEADER
+#define BASICS_LINUX_APPLICATION_HEADER
+
+    #include <atomic>
+    #include <basics/Application>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Aplicación sin pantalla: pasa a primer plano en cuanto se crea y solo termina cuando se
+         * pide con Headless::quit() (o cuando la escena se detiene).
+         */
+        class Linux_Application : public Application
+        {
+
+            std::atomic< Application::State > state;
+
+        public:
+
+            Linux_Application()
+            {
+                state = INTERACTIVE;
+
+                push (Event(Application::Event_Id::RESUME));
+            }
+
+        public:
+
+            State get_state () const override
+            {
+                return state;
+            }
+
+            void set_state (State new_state)
+            {
+                state = new_state;
+            }
+
+            void clear_events ()
+            {
+                event_queue.clear ();
+            }
+
+        };
+
+        extern Linux_Application application;
+
+    }}
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * ALLOCATION TRACKER
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191630
+ */
+
+#ifndef BASICS_ALLOCATION_TRACKER_HEADER
+#define BASICS_ALLOCATION_TRACKER_HEADER
+
+    #include <atomic>
+    #include <cstddef>
+    #include <cstdint>
+    #include <basics/macros>
+
+    // El seguimiento está activo por defecto en las compilaciones de depuración. Se puede forzar en un
+    // sentido u otro definiendo BASICS_ALLOCATION_TRACKING_ENABLED o BASICS_ALLOCATION_TRACKING_DISABLED
+    // (debe ser igual en todas las unidades de compilación):
+
+    #if !defined(BASICS_ALLOCATION_TRACKING_ENABLED) && !defined(BASICS_ALLOCATION_TRACKING_DISABLED) && !defined(NDEBUG)
+        #define BASICS_ALLOCATION_TRACKING_ENABLED
+    #endif
+
+    namespace basics
+    {
+
+        /**
+         * Cuenta las reservas de memoria dinámica que se hacen con new y delete (los operadores
+         * globales se sustituyen cuando BASICS_ALLOCATION_TRACKING_ENABLED está definida). Las llamadas
+         * directas a malloc() no se cuentan.
+         * Cada reserva se atribuye a la etiqueta (subsistema) activa en el hilo que la hace, que se
+         * establece con Allocation_Tracker::Scope (o la macro BASICS_ALLOCATION_SCOPE). Además, dentro de
+         * un ámbito Allocation_Tracker::Forbid cualquier reserva se considera una infracción: se cuenta y
+         * se notifica al manejador que se haya instalado (el Director lo usa para comprobar que los
+         * fotogramas no reservan memoria una vez que la escena ha terminado de cargar).
+         * Cuando el seguimiento está desactivado todos los contadores valen 0.
+         */
+        class Allocation_Tracker
+        {
+        public:
+
+            struct Counters
+            {
+                uint64_t allocations;                       ///< Número de reservas
+                uint64_t deallocations;                     ///< Número de liberaciones
+                uint64_t bytes;                             ///< Bytes reservados en total
+                uint64_t live_bytes;                        ///< Bytes reservados que no se han liberado
+                uint64_t peak_bytes;                        ///< Máximo de live_bytes alcanzado
+            };
+
+            typedef void (* Violation_Handler) (size_t size, const char * tag);
+
+            #if defined(BASICS_ALLOCATION_TRACKING_ENABLED)
+                static constexpr bool enabled = true;
+            #else
+                static constexpr bool enabled = false;
+            #endif
+
+            static constexpr unsigned max_tags = 32;    ///< Incluida la etiqueta 0 ("untagged")
+
+        public:
+
+            /**
+             * Devuelve los contadores de todos los hilos.
+             */
+            static Counters get_counters ();
+
+            /**
+             * Devuelve los contadores del hilo que hace la llamada (no incluyen live_bytes ni peak_bytes
+             * porque la memoria se puede liberar en un hilo distinto del que la reservó).
+             */
+            static Counters get_thread_counters ();
+
+            /**
+             * Devuelve los contadores de las reservas atribuidas a una etiqueta.
+             * @param index Índice de la etiqueta entre 0 y get_tag_count () - 1.
+             */
+            static Counters get_tag_counters (unsigned index);
+
+            static const char * get_tag_name (unsigned index);
+
+            static unsigned get_tag_count ();
+
+            /**
+             * Devuelve el número de reservas hechas dentro de un ámbito Forbid en cualquier hilo.
+             */
+            static uint64_t get_violation_count ();
+
+            /**
+             * Instala la función a la que se llama cada vez que se hace una reserva dentro de un ámbito
+             * Forbid (p. ej. para detener la ejecución en el depurador). Se llama desde el hilo que ha
+             * hecho la reserva y las reservas que haga el propio manejador no se consideran infracciones.
+             */
+            static void set_violation_handler (Violation_Handler handler);
+
+        public:
+
+            /**
+             * Atribuye a una etiqueta las reservas que hace el hilo mientras el objeto existe. Los
+             * ámbitos se pueden anidar. El nombre debe ser una cadena literal (solo se guarda el puntero).
+             * Si se registran más de max_tags etiquetas, las nuevas se atribuyen a la última.
+             */
+            class Scope
+            {
+
+                unsigned previous;
+
+            public:
+
+                Scope(const char * tag);
+               ~Scope();
+
+            };
+
+            /**
+             * Considera infracciones las reservas que hace el hilo mientras el objeto existe (si se
+             * construye con active a false no tiene ningún efecto).
+             */
+            class Forbid
+            {
+
+                bool active;
+
+            public:
+
+                Forbid(bool active = true);
+               ~Forbid();
+
+            };
+
+        };
+
+    }
+
+    #define BASICS_ALLOCATION_CONCATENATE_(A, B) A##B
+    #define BASICS_ALLOCATION_CONCATENATE(A, B)  BASICS_ALLOCATION_CONCATENATE_(A, B)
+
+    #if defined(BASICS_ALLOCATION_TRACKING_ENABLED)
+        #define BASICS_ALLOCATION_SCOPE(TAG)  basics::Allocation_Tracker::Scope  BASICS_ALLOCATION_CONCATENATE(allocation_scope_,  __LINE__)(TAG)
+        #define BASICS_ALLOCATION_FORBID()    basics::Allocation_Tracker::Forbid BASICS_ALLOCATION_CONCATENATE(allocation_forbid_, __LINE__)
+    #else
+        #define BASICS_ALLOCATION_SCOPE(TAG)  ((void)0)
+        #define BASICS_ALLOCATION_FORBID()    ((void)0)
+    #endif
+
+#endif
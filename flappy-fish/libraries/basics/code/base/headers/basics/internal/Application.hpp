@@ -49,7 +49,7 @@
 
         protected:
 
-            Event_Queue event_queue;
+            System_Event_Queue event_queue;             ///< Todos sus eventos son del ciclo de vida, así que nunca se pierden
 
         protected:
 
@@ -69,7 +69,7 @@
 
             void push (Event && event)
             {
-                event_queue.push (event);
+                event_queue.push (std::move (event));
             }
 
             bool poll (Event & event)
@@ -48,16 +48,30 @@
             typedef std::map< Id, Slice >         Slice_Map;
             typedef std::vector< byte >           Buffer;
 
+            struct Decoded_Image
+            {
+                Color_Buffer< Rgba8888 > color_buffer;
+                Texture_2D::Options      options;
+            };
+
         private:
 
-            Texture_Handle texture;
-            Slice_Map      slices;
+            Texture_Handle                   texture;
+            Slice_Map                        slices;
+            std::unique_ptr< Decoded_Image > decoded_image;     ///< Imagen leída pero sin textura todavía
 
         public:
 
             Atlas(const std::string    & path, Graphics_Context::Accessor & context);
             Atlas(const Texture_Handle & texture);
 
+            /**
+             * Lee los slices y decodifica la imagen del atlas sin crear la textura, por lo que no
+             * necesita el contexto gráfico y se puede usar desde otro hilo (p. ej. en
+             * Scene::preload()). La textura se crea después con upload().
+             */
+            explicit Atlas(const std::string & path);
+
         public:
 
             bool good () const
@@ -65,11 +79,34 @@
                 return texture.get () != nullptr && slices.size () > 0;
             }
 
+            /**
+             * Indica si la imagen se ha decodificado y falta crear la textura con upload().
+             */
+            bool is_pending_upload () const
+            {
+                return decoded_image != nullptr && slices.size () > 0;
+            }
+
+            /**
+             * Crea la textura a partir de la imagen decodificada (y libera esta). Devuelve lo mismo
+             * que good().
+             */
+            bool upload (Graphics_Context::Accessor & context);
+
             const Texture_Handle & get_texture () const
             {
                 return texture;
             }
 
+            /**
+             * Cambia la prioridad con la que se restaura la textura del atlas tras perderse el
+             * contexto gráfico (ver Graphics_Resource::Priority).
+             */
+            void set_priority (int priority)
+            {
+                if (texture) texture->set_priority (priority);
+            }
+
             const Slice * get_slice (Id id) const
             {
                 Slice_Map::const_iterator slice = slices.find (id);
@@ -93,8 +130,9 @@
 
         private:
 
-            void parse     (Buffer           & slices_data, const std::string & path, Graphics_Context::Accessor & context);
-            void parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context);
+            void load      (const std::string    & path, Graphics_Context::Accessor * context);
+            void parse     (Buffer           & slices_data, const std::string & path, Graphics_Context::Accessor * context);
+            void parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor * context);
             void parse_dir (rapidxml::xml_node<> * dir_tag, const std::string & prefix = std::string());
             void parse_spr (rapidxml::xml_node<> * spr_tag, const std::string & id);
 
@@ -44,6 +44,8 @@
         {
         public:
 
+            static constexpr Id renderer_type = ID(canvas);
+
             enum Blending
             {
                 NONE,
@@ -82,6 +84,10 @@
 
         protected:
 
+            Canvas() : Renderer(renderer_type)
+            {
+            }
+
             virtual ~Canvas() = default;
 
         public:
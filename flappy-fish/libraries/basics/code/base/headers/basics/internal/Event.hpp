@@ -14,8 +14,11 @@
 #define BASICS_EVENT_HEADER
 
     #include <map>
+    #include <type_traits>
+    #include <basics/assert>
     #include <basics/fnv>
     #include <basics/Id>
+    #include <basics/types>
     #include <basics/Var>
 
     namespace basics
@@ -27,18 +30,81 @@
 
             typedef std::map< Id, Var > Property_List;      // REEMPLAZAR POR UN MAPA "LIGERO"
 
+            /**
+             * Tipo de los datos que acompañan al evento. Los eventos de entrada llevan sus datos en
+             * un bloque de tamaño fijo (sin reservas de memoria dinámica) y el resto de eventos usa
+             * la lista genérica de propiedades.
+             */
+            enum Type : uint8_t
+            {
+                CUSTOM,
+                TOUCH,
+                KEY
+            };
+
+            struct Touch
+            {
+                int32_t pointer_id;
+                float   x;
+                float   y;
+            };
+
+            struct Key
+            {
+                int32_t key_code;
+                int32_t meta_state;
+            };
+
+            union Payload
+            {
+                Touch touch;
+                Key   key;
+            };
+
+            static_assert(std::is_trivial< Payload >::value, "basics::Event::Payload must be trivially copyable.");
+
         public:
 
             Id            id;
             int           priority;
-            Property_List properties;
+            Type          type;
+            int64_t       timestamp;                        ///< Nanosegundos del reloj monótono de la fuente (0 si se desconoce).
+            Payload       payload;
+            Property_List properties;                       ///< Solo se usa en eventos personalizados (CUSTOM).
+
+        public:
+
+            Event(Id id = 0) : id(id), priority(0), type(CUSTOM), timestamp(0), payload()
+            {
+            }
+
+            Event(Id id, const Touch & touch, int64_t timestamp = 0) : id(id), priority(0), type(TOUCH), timestamp(timestamp)
+            {
+                payload.touch = touch;
+            }
+
+            Event(Id id, const Key & key, int64_t timestamp = 0) : id(id), priority(0), type(KEY), timestamp(timestamp)
+            {
+                payload.key = key;
+            }
 
         public:
 
-            Event(Id id = 0) : id(id), priority(0)
+            bool is (Type expected_type) const
             {
+                return type == expected_type;
             }
 
+            // Accesores tipados a los datos del evento. Solo deben usarse cuando el tipo del
+            // evento coincide con el que se pide (en depuración se comprueba con assert):
+
+                  Touch & touch ()       { assert(type == TOUCH); return payload.touch; }
+            const Touch & touch () const { assert(type == TOUCH); return payload.touch; }
+                  Key   & key   ()       { assert(type == KEY  ); return payload.key;   }
+            const Key   & key   () const { assert(type == KEY  ); return payload.key;   }
+
+        public:
+
             Var & operator [] (const Id & id)
             {
                 return properties[id];
@@ -13,13 +13,21 @@
 #ifndef BASICS_EVENT_QUEUE_HEADER
 #define BASICS_EVENT_QUEUE_HEADER
 
+    #include <atomic>
     #include <queue>
     #include <mutex>
+    #include <utility>
     #include <basics/Event>
+    #include <basics/Ring_Queue>
 
     namespace basics
     {
 
+        /**
+         * Cola de eventos protegida con un mutex. Admite cualquier número de productores y de
+         * consumidores y no tiene límite de tamaño, pero cada operación adquiere el cerrojo.
+         * Las colas sin bloqueos Spsc_Event_Queue y Mpsc_Event_Queue tienen la misma interfaz.
+         */
         class Event_Queue
         {
 
@@ -44,7 +52,7 @@
             {
                 std::lock_guard< std::mutex > lock(mutex);
 
-                queue.push (event);
+                queue.push (std::move (event));
             }
 
             bool poll (Event & event)
@@ -53,7 +61,7 @@
 
                 if (queue.size () > 0)
                 {
-                    event = queue.front ();
+                    event = std::move (queue.front ());
 
                     queue.pop ();
 
@@ -77,6 +85,127 @@
                 return false;
             }
 
+            /**
+             * Entrega al callback todos los eventos pendientes adquiriendo el cerrojo una sola vez.
+             * @return Número de eventos entregados.
+             */
+            template< typename CALLBACK >
+            size_t drain (CALLBACK && callback)
+            {
+                std::queue< Event > pending;
+
+                {
+                    std::lock_guard< std::mutex > lock(mutex);
+
+                    pending.swap (queue);
+                }
+
+                size_t count = pending.size ();
+
+                for ( ; !pending.empty (); pending.pop ()) callback (pending.front ());
+
+                return count;
+            }
+
+        };
+
+        /// Cola de eventos sin bloqueos para un hilo productor (p. ej. el hilo de entrada) y un consumidor.
+        /// Cuando se llena descarta los eventos nuevos (un flujo de entrada que nadie consume no debe
+        /// bloquear al hilo que lo produce).
+        typedef Spsc_Ring_Queue< Event, 256, Overflow_Policy::DISCARD > Spsc_Event_Queue;
+
+        /// Cola de eventos sin bloqueos para varios hilos productores y un consumidor. Cuando se llena
+        /// descarta los eventos nuevos (y los cuenta) en lugar de bloquear al productor, que puede ser
+        /// el hilo del sistema (en Android bloquearlo provoca un ANR).
+        typedef Mpsc_Ring_Queue< Event,  64, Overflow_Policy::DISCARD > Mpsc_Event_Queue;
+
+        /**
+         * Cola de los eventos que envía el sistema (ciclo de vida de la aplicación y de la ventana).
+         * Quien los consume (el Director) puede pasar un rato sin hacerlo (p. ej. mientras está en
+         * pausa o cargando una escena), pero el hilo del sistema nunca debe bloquearse esperando:
+         * - Los eventos que se pueden perder (p. ej. REDRAW) van por una cola sin bloqueos acotada
+         *   que descarta los que no caben y cuenta cuántos se han perdido.
+         * - Los eventos del ciclo de vida (pausa, reanudación, cambios de la superficie...) no se
+         *   pueden perder, así que van por una cola sin límite. Su cerrojo solo se retiene lo que
+         *   cuesta añadir o sacar un evento, y poll() solo lo adquiere cuando hay eventos pendientes.
+         * poll() entrega antes los eventos del ciclo de vida.
+         */
+        class System_Event_Queue
+        {
+
+            Event_Queue           lifecycle;
+            std::atomic< size_t > lifecycle_pending;
+            Mpsc_Event_Queue      droppable;
+
+        public:
+
+            System_Event_Queue() : lifecycle_pending(0)
+            {
+            }
+
+        public:
+
+            /**
+             * Retorna el número de eventos que se han podido perder y se han descartado por encontrar
+             * la cola llena.
+             */
+            size_t discarded_count () const
+            {
+                return droppable.discarded_count ();
+            }
+
+        public:
+
+            void push (const Event & event, bool can_be_dropped = false)
+            {
+                Event copy(event);
+
+                push (std::move (copy), can_be_dropped);
+            }
+
+            void push (Event && event, bool can_be_dropped = false)
+            {
+                if (can_be_dropped)
+                {
+                    droppable.push (std::move (event));
+                }
+                else
+                {
+                    lifecycle.push (std::move (event));
+
+                    lifecycle_pending.fetch_add (1, std::memory_order_release);
+                }
+            }
+
+            bool poll (Event & event)
+            {
+                if (lifecycle_pending.load (std::memory_order_acquire) > 0 && lifecycle.poll (event))
+                {
+                    lifecycle_pending.fetch_sub (1, std::memory_order_relaxed);
+
+                    return true;
+                }
+
+                return droppable.poll (event);
+            }
+
+            void clear ()
+            {
+                Event event;
+
+                while (poll (event));
+            }
+
+            bool peek (Event & event)
+            {
+                if (lifecycle_pending.load (std::memory_order_acquire) > 0 && lifecycle.peek (event))
+                {
+                    return true;
+                }
+
+                return droppable.peek (event);
+            }
+
         };
 
     }
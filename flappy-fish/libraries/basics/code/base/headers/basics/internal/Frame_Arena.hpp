@@ -0,0 +1,200 @@
+/*
+ * FRAME ARENA
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191700
+ */
+
+#ifndef BASICS_FRAME_ARENA_HEADER
+#define BASICS_FRAME_ARENA_HEADER
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <memory>
+    #include <new>
+    #include <type_traits>
+    #include <vector>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Reserva lineal de memoria para datos que solo viven durante un fotograma (disposiciones de
+         * texto, listas de glifos, arrays de vértices temporales, etc.). Reservar consiste en avanzar
+         * un puntero y la memoria no se libera individualmente, sino toda a la vez cuando el Director
+         * empieza un nuevo fotograma.
+         * Tiene dos búferes que se alternan en cada fotograma, por lo que lo reservado en un fotograma
+         * sigue siendo válido durante todo el siguiente (p. ej. para que otro hilo lo consuma).
+         * Si un búfer se llena, las reservas siguientes se hacen en el heap y al reiniciarlo se amplía
+         * para que quepa todo lo que se reservó en él.
+         * Solo se debe reservar desde un hilo (el del Director).
+         */
+        class Frame_Arena : Non_Copyable
+        {
+        public:
+
+            struct Stats
+            {
+                size_t   capacity;                          ///< Bytes de cada uno de los dos búferes
+                size_t   used;                              ///< Bytes reservados en el fotograma actual
+                size_t   high_water_mark;                   ///< Máximo de bytes reservados en un fotograma
+                uint64_t overflows;                         ///< Reservas que no cupieron y se hicieron en el heap
+                uint64_t frames;
+            };
+
+            static constexpr size_t default_capacity = 64 * 1024;
+
+        private:
+
+            struct Buffer
+            {
+                std::unique_ptr< char [] > memory;
+                size_t                     capacity;
+                size_t                     used;            ///< Incluye lo reservado en el heap al llenarse
+                std::vector< void * >      overflow;
+            };
+
+            Buffer   buffers[2];
+            unsigned current;
+            Stats    stats;
+
+        public:
+
+            /**
+             * Devuelve la reserva de fotograma que reinicia el Director.
+             */
+            static Frame_Arena & get_instance ();
+
+            Frame_Arena(size_t capacity = default_capacity);
+           ~Frame_Arena();
+
+        public:
+
+            /**
+             * Reserva memoria sin inicializar que será válida hasta el final del fotograma siguiente.
+             * @param alignment Potencia de 2.
+             */
+            void * allocate (size_t size, size_t alignment = alignof(std::max_align_t))
+            {
+                Buffer & buffer = buffers[current];
+
+                size_t   start  = (buffer.used + alignment - 1) & ~(alignment - 1);
+
+                if (start + size <= buffer.capacity)
+                {
+                    buffer.used = start + size;
+
+                    return buffer.memory.get () + start;
+                }
+
+                return allocate_overflow (size);
+            }
+
+            /**
+             * Libera la memoria reservada dos fotogramas antes y empieza a reservar en ese búfer.
+             */
+            void begin_frame ();
+
+            /**
+             * Libera toda la memoria reservada en los dos búferes.
+             */
+            void reset ();
+
+            Stats get_stats () const
+            {
+                Stats current_stats = stats;
+
+                current_stats.used = buffers[current].used;
+
+                return current_stats;
+            }
+
+        private:
+
+            void * allocate_overflow (size_t size);
+            void   clear             (Buffer & buffer);
+
+        };
+
+        extern Frame_Arena & frame_arena;
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Adaptador para que los contenedores de la biblioteca estándar reserven en una Frame_Arena
+         * (p. ej. std::vector< Glyph, Frame_Allocator< Glyph > >). Un Frame_Allocator construido por
+         * defecto no usa ninguna Frame_Arena sino new y delete, para que el mismo tipo de contenedor
+         * se pueda usar también con datos que duran más de un fotograma.
+         * Las copias de un contenedor (por construcción o por asignación) reservan con new y delete,
+         * ya que no tienen por qué desaparecer con el fotograma.
+         */
+        template< typename TYPE >
+        class Frame_Allocator
+        {
+
+            template< typename OTHER > friend class Frame_Allocator;
+
+            Frame_Arena * arena;
+
+        public:
+
+            typedef TYPE value_type;
+
+            typedef std::false_type propagate_on_container_copy_assignment;
+
+            Frame_Allocator() : arena(nullptr)
+            {
+            }
+
+            Frame_Allocator(Frame_Arena & arena) : arena(&arena)
+            {
+            }
+
+            template< typename OTHER >
+            Frame_Allocator(const Frame_Allocator< OTHER > & other) : arena(other.arena)
+            {
+            }
+
+        public:
+
+            Frame_Allocator select_on_container_copy_construction () const
+            {
+                return Frame_Allocator();
+            }
+
+            TYPE * allocate (size_t count)
+            {
+                return static_cast< TYPE * >
+                (
+                    arena ? arena->allocate (count * sizeof(TYPE), alignof(TYPE)) : ::operator new (count * sizeof(TYPE))
+                );
+            }
+
+            void deallocate (TYPE * pointer, size_t )
+            {
+                if (!arena) ::operator delete (pointer);
+            }
+
+            template< typename OTHER >
+            bool operator == (const Frame_Allocator< OTHER > & other) const
+            {
+                return arena == other.arena;
+            }
+
+            template< typename OTHER >
+            bool operator != (const Frame_Allocator< OTHER > & other) const
+            {
+                return arena != other.arena;
+            }
+
+        };
+
+    }
+
+#endif
@@ -24,6 +24,7 @@
     #include <basics/Graphics_Resource_Cache>
     #include <basics/Id>
     #include <basics/Point>
+    #include <basics/Renderer>
     #include <basics/Size>
     #include <basics/types>
 
@@ -128,20 +129,29 @@
 
             typedef std::map< Id, std::shared_ptr< Renderer > >          Renderer_List;
             typedef std::vector<  std::shared_ptr< Graphics_Resource > > Resource_List;
+            typedef std::vector<    std::weak_ptr< Graphics_Resource > > Pending_Resource_List;
 
         protected:
 
             Window                  & window;
             Renderer_List             renderers;
             Resource_List             resources;
+            Pending_Resource_List     pending_resources;        ///< Recursos de la caché pendientes de restaurar (el de mayor prioridad al final)
             Graphics_Resource_Cache * graphics_resource_cache;
 
+        private:
+
+            Renderer                * cached_renderer;          ///< Último renderer encontrado por get_renderer()
+            Id                        cached_renderer_id;
+
         protected:
 
             Graphics_Context(Window & window, Graphics_Resource_Cache * cache = nullptr)
             :
                 window(window),
-                graphics_resource_cache(cache)
+                graphics_resource_cache(cache),
+                cached_renderer(nullptr),
+                cached_renderer_id(0)
             {
             }
 
@@ -149,27 +159,57 @@
 
         public:
 
+            /**
+             * Devuelve el renderer con el id indicado si es del tipo RENDERER (que debe declarar su
+             * renderer_type) o nullptr en otro caso. Se llama en cada frame, así que el último
+             * renderer encontrado se recuerda para no buscarlo en el mapa y el tipo se comprueba
+             * comparando el que indicó el renderer al crearse en lugar de con dynamic_cast.
+             */
             template< class RENDERER >
             RENDERER * get_renderer (Id id)
             {
-                Renderer_List::iterator renderer = renderers.find (id);
+                if (!cached_renderer || cached_renderer_id != id)
+                {
+                    Renderer_List::iterator renderer = renderers.find (id);
+
+                    if (renderer == renderers.end ()) return nullptr;
 
-                return dynamic_cast< RENDERER * >(renderer != renderers.end () ? renderer->second.get () : nullptr);
+                    cached_renderer    = renderer->second.get ();
+                    cached_renderer_id = id;
+                }
+
+                return cached_renderer->get_renderer_type () == RENDERER::renderer_type ? static_cast< RENDERER * >(cached_renderer) : nullptr;
             }
 
             bool add (Id id, const std::shared_ptr< Renderer > & renderer)
             {
+                invalidate_renderer_cache ();
+
                 return renderers.find (id) == renderers.end () ? renderers[id] = renderer, true : false;
             }
 
+            /**
+             * Hace que get_renderer() olvide el último renderer encontrado. Se debe llamar siempre
+             * que se añadan o se eliminen renderers.
+             */
+            void invalidate_renderer_cache ()
+            {
+                cached_renderer = nullptr;
+            }
+
             // CUIDADO CON AÑADIR DUPLICADOS. PODRÍA ESTAR BIEN QUE CADA RECURSO TUVIESE UN Id ÚNICO Y
             // AÑADIRLOS A UN MAPA PARA EVITAR DUPLICIDADES.
+            // El recurso se registra en la caché para poder restaurarlo si se pierde el contexto.
             bool add (const std::shared_ptr< Graphics_Resource > & resource)
             {
                 if (resource)
                 {
                     resources.push_back (resource);
 
+                    if (graphics_resource_cache) graphics_resource_cache->add (resource);
+
+                    resource->clear_request ();
+
                     return resource->initialize ();
                 }
 
@@ -178,17 +218,36 @@
 
         public:
 
-            virtual void initialize ()
+            /**
+             * Prepara la restauración de los recursos de la caché tras crear el contexto. Los
+             * recursos no se restauran aquí, sino poco a poco llamando a restore_resources().
+             */
+            virtual void initialize ();
+
+            /**
+             * Restaura recursos pendientes por orden de prioridad hasta agotar el tiempo indicado.
+             * Los recursos que algún renderer ha solicitado (porque los necesitaba para dibujar)
+             * se restauran antes que el resto. Siempre se restaura al menos un recurso por llamada
+             * para garantizar que el proceso avanza.
+             * @param time_budget Tiempo máximo en segundos que se puede dedicar a restaurar.
+             * @return Número de recursos restaurados.
+             */
+            unsigned restore_resources (float time_budget);
+
+            bool has_pending_resources () const
             {
-                if (graphics_resource_cache)
-                {
-                    for (auto iterator = graphics_resource_cache->begin (); iterator != graphics_resource_cache->end (); ++iterator)
-                    {
-                        add (iterator->lock ());
-                    }
-                }
+                return !pending_resources.empty ();
             }
 
+            /**
+             * Elimina los recursos que solo siguen existiendo porque el contexto los conserva (nadie
+             * más tiene un shared_ptr a ellos), con lo que se libera la memoria de vídeo que ocupan.
+             * Sirve para recuperar los recursos de las escenas que se han destruido o que los han
+             * soltado ante la falta de memoria.
+             * @return Número de recursos eliminados.
+             */
+            unsigned release_unused_resources ();
+
             virtual void finalize ()
             {
                 if (graphics_resource_cache)
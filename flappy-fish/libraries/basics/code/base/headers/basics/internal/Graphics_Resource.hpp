@@ -20,15 +20,35 @@
 
         class Graphics_Resource
         {
+        public:
+
+            /**
+             * Prioridades orientativas para restaurar los recursos cuando se vuelve a crear el
+             * contexto gráfico. Los recursos con mayor prioridad se restauran antes.
+             */
+            enum Priority
+            {
+                LOW    = 0,
+                NORMAL = 1,
+                HIGH   = 2,
+            };
+
         protected:
 
             bool initialized;
 
+        private:
+
+            int          priority;
+            mutable bool requested;
+
         protected:
 
             Graphics_Resource()
             {
                 initialized = false;
+                priority    = NORMAL;
+                requested   = false;
             }
 
             virtual ~Graphics_Resource() = default;
@@ -38,6 +58,46 @@
             virtual bool initialize (/*Graphics_Context & context*/) = 0;
             virtual void finalize   () = 0;
 
+        public:
+
+            /**
+             * Indica si el recurso está disponible en el contexto gráfico actual. Tras perderse
+             * el contexto, los recursos se restauran poco a poco y mientras tanto no son usables.
+             */
+            bool is_usable () const
+            {
+                return initialized;
+            }
+
+            int get_priority () const
+            {
+                return priority;
+            }
+
+            void set_priority (int new_priority)
+            {
+                priority = new_priority;
+            }
+
+            /**
+             * Los renderers llaman a este método cuando necesitan un recurso que todavía no es
+             * usable para que el contexto gráfico lo restaure antes que el resto.
+             */
+            void request () const
+            {
+                requested = true;
+            }
+
+            bool is_requested () const
+            {
+                return requested;
+            }
+
+            void clear_request ()
+            {
+                requested = false;
+            }
+
         };
 
     }
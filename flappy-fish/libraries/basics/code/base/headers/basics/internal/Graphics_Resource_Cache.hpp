@@ -15,6 +15,7 @@
 
     #include <list>
     #include <basics/Graphics_Resource>
+    #include <basics/Small_Object_Pool>
 
     namespace basics
     {
@@ -26,7 +27,7 @@
         class Graphics_Resource_Cache
         {
 
-            typedef std::list< std::weak_ptr< Graphics_Resource > > Graphics_Resource_List;
+            typedef std::list< std::weak_ptr< Graphics_Resource >, Pool_Allocator< std::weak_ptr< Graphics_Resource > > > Graphics_Resource_List;
 
         public:
 
@@ -48,6 +49,49 @@
                 return resources.end ();
             }
 
+            /**
+             * Añade un recurso a la caché si no estaba ya en ella. De paso se eliminan las
+             * referencias a recursos que ya no existen.
+             * @return true si el recurso se ha añadido o false si ya estaba en la caché.
+             */
+            bool add (const std::shared_ptr< Graphics_Resource > & resource)
+            {
+                for (Iterator iterator = resources.begin (); iterator != resources.end (); )
+                {
+                    std::shared_ptr< Graphics_Resource > cached = iterator->lock ();
+
+                    if (!cached)
+                    {
+                        iterator = resources.erase (iterator);
+                    }
+                    else
+                    if (cached == resource)
+                    {
+                        return false;
+                    }
+                    else
+                        ++iterator;
+                }
+
+                resources.push_back (resource);
+
+                return true;
+            }
+
+            /**
+             * Da la misma prioridad de restauración a todos los recursos de la caché (p. ej. para
+             * que luego la escena actual suba la de los suyos).
+             */
+            void set_priority (int priority)
+            {
+                for (auto & cached : resources)
+                {
+                    std::shared_ptr< Graphics_Resource > resource = cached.lock ();
+
+                    if (resource) resource->set_priority (priority);
+                }
+            }
+
         };
 
     }
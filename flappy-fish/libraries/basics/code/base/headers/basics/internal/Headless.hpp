@@ -0,0 +1,78 @@
+/*
+ * HEADLESS
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#ifndef BASICS_HEADLESS_HEADER
+#define BASICS_HEADLESS_HEADER
+
+    #include <cstdint>
+    #include <string>
+    #include <basics/Non_Instantiable>
+    #include <basics/Size>
+
+    namespace basics
+    {
+
+        /**
+         * Configuración de la plataforma sin pantalla de Linux (adaptadores de base/adapters/linux),
+         * que permite ejecutar las escenas en máquinas de integración continua y de pruebas sin
+         * dispositivo. La ventana no se muestra en ningún sitio: si tiene tamaño, el contexto gráfico
+         * dibuja en una superficie fuera de pantalla (pbuffer) de ese tamaño, y si no lo tiene (0x0)
+         * el Director le da un Null_Graphics_Context: las escenas cargan sus recursos y se ejecutan
+         * igual (también render()), pero no se dibuja nada ni se usa la GPU.
+         * Los valores iniciales se toman de las variables de entorno BASICS_ASSETS_PATH (por defecto
+         * "assets"), BASICS_SURFACE_SIZE (p. ej. "720x1280", que es el valor por defecto, o "0x0") y
+         * BASICS_FRAME_LIMIT (número de fotogramas tras el que se termina, 0 por defecto, es decir,
+         * sin límite). Se deben cambiar antes de iniciar la primera escena con el Director.
+         * Solo está disponible cuando se compila para Linux.
+         */
+        class Headless : Non_Instantiable
+        {
+        public:
+
+            /**
+             * Carpeta desde la que se abren los assets (las rutas de Asset::open() son relativas a ella).
+             */
+            static void               set_assets_path (const std::string & path);
+            static const std::string & get_assets_path ();
+
+            /**
+             * Tamaño en píxeles de la superficie fuera de pantalla. Con tamaño 0 no hay superficie.
+             */
+            static void   set_surface_size (const Size2u & size);
+            static Size2u get_surface_size ();
+
+            static bool has_offscreen_surface ()
+            {
+                Size2u size = get_surface_size ();
+
+                return size.width > 0 && size.height > 0;
+            }
+
+            /**
+             * Número de fotogramas que debe ejecutar el programa antes de terminar (0 si no hay
+             * límite). No lo aplica el Director por sí mismo: el programa se lo pasa con
+             * Director::set_frame_limit().
+             */
+            static void     set_frame_limit (uint64_t frames);
+            static uint64_t get_frame_limit ();
+
+            /**
+             * Pide a la aplicación que termine (el Director acaba la escena actual al recibirlo). Se
+             * puede llamar desde cualquier hilo.
+             */
+            static void quit ();
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * HISTOGRAM
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191330
+ */
+
+#ifndef BASICS_HISTOGRAM_HEADER
+#define BASICS_HISTOGRAM_HEADER
+
+    #include <atomic>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Histograma de rango dinámico alto para medidas de tiempo (o cualquier otra magnitud entera
+         * no negativa). Los valores menores que sub_bucket_count se cuentan de forma exacta y a partir
+         * de ahí cada potencia de dos se divide en sub_bucket_count / 2 intervalos, por lo que el error
+         * relativo de los percentiles es menor del 3% para cualquier valor hasta 2^40.
+         * Añadir un valor no reserva memoria ni adquiere cerrojos y puede hacerse desde un hilo mientras
+         * otro consulta los percentiles (los contadores son atómicos con orden relajado).
+         */
+        class Histogram
+        {
+        public:
+
+            static constexpr unsigned sub_bucket_bits  = 6;
+            static constexpr unsigned sub_bucket_count = 1u << sub_bucket_bits;
+            static constexpr unsigned half_count       = sub_bucket_count / 2;
+            static constexpr unsigned max_bits         = 40;
+            static constexpr unsigned bucket_count     = sub_bucket_count + (max_bits - sub_bucket_bits) * half_count;
+
+        private:
+
+            std::atomic< uint32_t > buckets[bucket_count];
+            std::atomic< uint64_t > total;
+            std::atomic< uint64_t > sum;
+            std::atomic< uint64_t > maximum;
+
+        public:
+
+            Histogram()
+            {
+                clear ();
+            }
+
+        public:
+
+            void clear ()
+            {
+                for (auto & bucket : buckets) bucket.store (0, std::memory_order_relaxed);
+
+                total  .store (0, std::memory_order_relaxed);
+                sum    .store (0, std::memory_order_relaxed);
+                maximum.store (0, std::memory_order_relaxed);
+            }
+
+            void add (uint64_t value)
+            {
+                buckets[index_of (value)].fetch_add (1, std::memory_order_relaxed);
+
+                total.fetch_add (    1, std::memory_order_relaxed);
+                sum  .fetch_add (value, std::memory_order_relaxed);
+
+                uint64_t current = maximum.load (std::memory_order_relaxed);
+
+                while (value > current && !maximum.compare_exchange_weak (current, value, std::memory_order_relaxed));
+            }
+
+        public:
+
+            uint64_t count () const
+            {
+                return total.load (std::memory_order_relaxed);
+            }
+
+            uint64_t max () const
+            {
+                return maximum.load (std::memory_order_relaxed);
+            }
+
+            double mean () const
+            {
+                uint64_t samples = count ();
+
+                return samples ? double(sum.load (std::memory_order_relaxed)) / double(samples) : 0.0;
+            }
+
+            /**
+             * Retorna el valor por debajo del cual se encuentra el porcentaje de muestras indicado.
+             * @param percent Percentil que se quiere obtener (entre 0 y 100).
+             * @return El límite superior del intervalo que contiene el percentil (0 si no hay muestras).
+             */
+            uint64_t percentile (double percent) const
+            {
+                uint64_t samples = count ();
+
+                if (samples == 0) return 0;
+
+                uint64_t target = uint64_t(percent / 100.0 * double(samples) + 0.5);
+
+                if (target < 1      ) target = 1;
+                if (target > samples) target = samples;
+
+                uint64_t accumulated = 0;
+
+                for (unsigned index = 0; index < bucket_count; ++index)
+                {
+                    accumulated += buckets[index].load (std::memory_order_relaxed);
+
+                    if (accumulated >= target)
+                    {
+                        uint64_t upper = upper_bound_of (index);
+
+                        return upper < max () ? upper : max ();
+                    }
+                }
+
+                return max ();
+            }
+
+        public:
+
+            static unsigned index_of (uint64_t value)
+            {
+                if (value < sub_bucket_count) return unsigned(value);
+
+                unsigned top_bit = 63 - unsigned(__builtin_clzll (value));
+
+                if (top_bit >= max_bits) return bucket_count - 1;
+
+                unsigned shift = top_bit - sub_bucket_bits + 1;
+
+                return sub_bucket_count + (top_bit - sub_bucket_bits) * half_count + unsigned(value >> shift) - half_count;
+            }
+
+            static uint64_t upper_bound_of (unsigned index)
+            {
+                if (index < sub_bucket_count) return index;
+
+                unsigned group = (index - sub_bucket_count) / half_count;
+                unsigned shift = group + 1;
+                uint64_t sub   = (index - sub_bucket_count) % half_count + half_count;
+
+                return ((sub + 1) << shift) - 1;
+            }
+
+        };
+
+    }
+
+#endif
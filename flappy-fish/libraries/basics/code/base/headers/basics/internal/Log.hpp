@@ -17,18 +17,47 @@
 // Concurrencia.
 // Formateo de tipos de datos básicos.
 // Desactivación dinámica o estática de diferentes niveles de log.
+//
+// Cada llamada formatea el mensaje en un registro de tamaño fijo en la pila del hilo que la hace
+// (sin reservas de memoria dinámica ni iostreams) y lo añade a una cola sin bloqueos. Un hilo en
+// segundo plano vacía la cola y envía los mensajes a los canales registrados, por lo que la llamada
+// no hace ninguna llamada al sistema. Los mensajes de error no se descartan aunque la cola esté llena
+// y despiertan al hilo de volcado para que se escriban enseguida. Solo los mensajes fatales esperan a
+// que se escriban antes de retornar, porque la aplicación va a terminar.
 
 #ifndef BASICS_LOG_HEADER
 #define BASICS_LOG_HEADER
 
+    #include <atomic>
+    #include <condition_variable>
+    #include <cstdio>
+    #include <memory>
+    #include <mutex>
     #include <string>
+    #include <thread>
+    #include <type_traits>
+    #include <vector>
+    #include <basics/macros>
+    #include <basics/Ring_Queue>
+
+    // Nivel mínimo de los mensajes que se compilan (0 = verbose, 1 = debug, 2 = info, 3 = warning,
+    // 4 = error, 5 = fatal). Los gates de los niveles inferiores se convierten en Null_Gate y no generan
+    // código. Por defecto en las compilaciones de release se eliminan los mensajes verbose y debug:
+
+    #if !defined(BASICS_LOG_MIN_LEVEL)
+        #if defined(NDEBUG)
+            #define BASICS_LOG_MIN_LEVEL 2
+        #else
+            #define BASICS_LOG_MIN_LEVEL 0
+        #endif
+    #endif
 
     namespace basics
     {
 
         class Log final
         {
-        private:
+        public:
 
             enum Level
             {
@@ -40,18 +69,166 @@
                 FATAL
             };
 
+            static constexpr unsigned max_message_length = 231;
+
+            /**
+             * Mensaje ya formateado tal como viaja desde el hilo que lo genera hasta los canales.
+             */
+            struct Record
+            {
+                int64_t      timestamp;                     ///< Nanosegundos del reloj monótono
+                const char * tag;
+                Level        level;
+                unsigned     length;
+                char         text[max_message_length + 1];
+            };
+
         // -----------------------------------------------------------------------------------------
 
         public:
 
-          /*template< typename >
+            /**
+             * Destino de los mensajes (logcat, salida estándar, archivo, etc.). Sus métodos solo se
+             * llaman desde el hilo de volcado, por lo que no necesitan sincronización.
+             */
             class Channel
             {
             public:
 
-                void dump (Level level, const char * tag, const char * chars);
+                virtual ~Channel() = default;
+
+                virtual void write (const Record & record) = 0;
+                virtual void flush () { }
+
+            };
+
+            /**
+             * Canal que escribe los mensajes en la salida estándar.
+             */
+            class Stdout_Channel : public Channel
+            {
+            public:
+
+                void write (const Record & record) override;
+                void flush () override;
+
+            };
+
+            /**
+             * Canal que escribe los mensajes en un archivo. Cuando el archivo supera el tamaño máximo se
+             * renombra añadiendo ".1" (el anterior ".1" pasa a ".2", etc.) y se empieza uno nuevo.
+             * max_files cuenta el archivo actual y las copias, y como mínimo es 2 para que al rotar se
+             * conserve siempre el archivo anterior. Si el archivo no se puede abrir, el canal no escribe
+             * nada y se informa una vez con report_error().
+             */
+            class Rotating_File_Channel : public Channel
+            {
 
-            };*/
+                std::string path;
+                size_t      max_size;
+                unsigned    max_files;
+                size_t      size;
+                FILE      * file;
+                bool        failure_reported;
+
+            public:
+
+                Rotating_File_Channel(const std::string & path, size_t max_size = 1024 * 1024, unsigned max_files = 3);
+               ~Rotating_File_Channel();
+
+                bool good () const
+                {
+                    return file != nullptr;
+                }
+
+                void write (const Record & record) override;
+                void flush () override;
+
+            private:
+
+                void rotate ();
+                void report_open_failure ();
+
+            };
+
+            /**
+             * Crea el canal por defecto de la plataforma (logcat en Android). Lo implementa cada adaptador.
+             */
+            static std::shared_ptr< Channel > create_default_channel ();
+
+            /**
+             * Informa de un error del propio log directamente (sin pasar por la cola ni los canales) en
+             * stderr o, en Android, en el logcat. Lo implementa cada adaptador.
+             */
+            static void report_error (const char * message);
+
+        // -----------------------------------------------------------------------------------------
+
+        private:
+
+            /**
+             * Añade al texto de un registro la representación de los tipos de datos básicos.
+             */
+            class Writer final
+            {
+
+                Record & record;
+
+            public:
+
+                Writer(Record & record) : record(record)
+                {
+                    record.length  = 0;
+                    record.text[0] = 0;
+                }
+
+                void write (const char        * chars );
+                void write (const std::string & string) { write (string.c_str ()); }
+                void write (char                  value );
+                void write (bool                  value ) { write (value ? "true" : "false"); }
+                void write (long long             value );
+                void write (unsigned long long    value );
+                void write (double                value );
+                void write (const void          * value );
+
+                template< typename TYPE >
+                typename std::enable_if< std::is_integral< TYPE >::value && std::is_signed< TYPE >::value >::type
+                write (TYPE value)
+                {
+                    write (static_cast< long long >(value));
+                }
+
+                template< typename TYPE >
+                typename std::enable_if< std::is_integral< TYPE >::value && std::is_unsigned< TYPE >::value >::type
+                write (TYPE value)
+                {
+                    write (static_cast< unsigned long long >(value));
+                }
+
+                template< typename TYPE >
+                typename std::enable_if< std::is_enum< TYPE >::value >::type
+                write (TYPE value)
+                {
+                    write (static_cast< long long >(value));
+                }
+
+                void write (float value)
+                {
+                    write (double(value));
+                }
+
+                void write_all ()
+                {
+                }
+
+                template< typename FIRST, typename ... REST >
+                void write_all (const FIRST & first, const REST & ... rest)
+                {
+                    write     (first  );
+                    write_all (rest...);
+                }
+
+            };
 
         // -----------------------------------------------------------------------------------------
 
@@ -64,7 +241,6 @@
                 Log &  log;
                 Level  level;
                 bool   is_open;
-              //Buffer buffer;                  // DEBE HABER UN BUFFER POR LEVEL
 
             public:
 
@@ -85,33 +261,26 @@
                     is_open = false;
                 }
 
-                // SOBRECARGAR EL OPERADOR << PARA DIFERENTES TIPOS DE DATOS, IR ACUMULANDO
-                // EN UN BUFFER EL RESULTADO (LLAMANDO A CIERTO MÉTODO) Y TERMINAR CON ENDL.
-
-                // PERMITIR QUE EL OPERADOR () ACEPTE UN NÚMERO VARIABLE DE PARÁMETROS DE TIPOS
-                // DISTINTOS SEPARADOS POR COMAS. TRAS EL ÚLTIMO PARÁMETRO SE ENVÍA A LOG.DUMP.
-
-                Pass_Gate & operator () (const char * message)
+                /**
+                 * Compone un mensaje con la representación de todos los argumentos, uno detrás de otro
+                 * (p. ej. log.d ("width: ", width, " height: ", height)). Los mensajes que superan
+                 * max_message_length caracteres se truncan.
+                 */
+                template< typename ... ARGUMENTS >
+                Pass_Gate & operator () (const ARGUMENTS & ... arguments)
                 {
-                    if (is_open) accept (message);
+                    if (is_open)
+                    {
+                        Record record;
 
-                    return *this;
-                }
+                        Writer(record).write_all (arguments...);
 
-                Pass_Gate & operator () (const std::string & message)
-                {
-                    if (is_open) accept (message.c_str ());
+                        log.submit (level, record);
+                    }
 
                     return *this;
                 }
 
-                // PODRÍA SER CONVENIENTE QUE ESTE MÉTODO NO SEA INLINE PARA QUE EL CÓDIGO MÁQUINA
-                // SEA MÁS COMPACTO Y PARA QUE TENGA MÁS POSIBILIDADES DE RESIDIR EN EL L1 DE CÓDIGO.
-                void accept (const char * message)
-                {
-                    log.dump (level, nullptr, message);
-                }
-
             };
 
         // -----------------------------------------------------------------------------------------
@@ -133,50 +302,73 @@
                 void open  () { }
                 void close () { }
 
-                Null_Gate & operator () (const char        * ) { return *this; }
-                Null_Gate & operator () (const std::string & ) { return *this; }
+                template< typename ... ARGUMENTS >
+                Null_Gate & operator () (const ARGUMENTS & ... )
+                {
+                    return *this;
+                }
 
             };
 
+            template< Level LEVEL >
+            using Gate = typename std::conditional< (LEVEL >= BASICS_LOG_MIN_LEVEL), Pass_Gate, Null_Gate >::type;
+
         // -----------------------------------------------------------------------------------------
 
         public:
 
-            // MEDIANTE PREPROCESADO USAR PASS_GATE O NULL_GATE SEGÚN SE QUIERAN ACTIVAR
-            // O DESACTIVAR EN TIEMPO DE COMPILACIÓN. EN MODO RELASE, DESACTIVAR DEBUG Y
-            // VERBOSE POR DEFECTO.
-
-            Pass_Gate v;                        ///< Log gate for verbose messages.
-            Pass_Gate d;                        ///< Log gate for debug messages.
-            Pass_Gate i;                        ///< Log gate for information messages.
-            Pass_Gate w;                        ///< Log gate for warnings.
-            Pass_Gate e;                        ///< Log gate for error messages.
-            Pass_Gate f;                        ///< Log gate for fatal error messages.
+            Gate< VERBOSE > v;                  ///< Log gate for verbose messages.
+            Gate< DEBUG   > d;                  ///< Log gate for debug messages.
+            Gate< INFO    > i;                  ///< Log gate for information messages.
+            Gate< WARNING > w;                  ///< Log gate for warnings.
+            Gate< ERROR   > e;                  ///< Log gate for error messages.
+            Gate< FATAL   > f;                  ///< Log gate for fatal error messages.
 
         // -----------------------------------------------------------------------------------------
 
         private:
 
-            //std::list< Channel? > channels;
+            typedef Mpsc_Ring_Queue< Record, 256, Overflow_Policy::DISCARD > Record_Queue;
+
+            Record_Queue                             queue;
+            std::atomic< uint64_t >                  submitted;
+            std::atomic< uint64_t >                  dumped;
+            size_t                                   reported_discards;
+
+            std::vector< std::shared_ptr< Channel > > channels;
+            std::mutex                               channels_mutex;
+
+            std::unique_ptr< std::thread >           flusher;
+            std::atomic< bool >                      flusher_started;
+            std::atomic< bool >                      stopping;
+            std::mutex                               flusher_mutex;
+            std::condition_variable                  flusher_condition;
 
         public:
 
-            Log()
-            :
-                v(*this, VERBOSE),
-                d(*this, DEBUG  ),
-                i(*this, INFO   ),
-                w(*this, WARNING),
-                e(*this, ERROR  ),
-                f(*this, FATAL  )
-            {
-            }
+            Log();
+           ~Log();
 
-        // -----------------------------------------------------------------------------------------
+        public:
+
+            /**
+             * Añade un canal de salida. Los mensajes se envían a todos los canales registrados.
+             */
+            void add_channel (const std::shared_ptr< Channel > & channel);
+
+            void remove_channels ();
+
+            /**
+             * Espera a que todos los mensajes enviados antes de la llamada se hayan escrito en los canales.
+             */
+            void flush ();
 
         private:
 
-            void dump (Level level, const char * tag, const char * cstring);
+            void submit (Level level, Record & record);
+            void start_flusher ();
+            void flusher_loop ();
+            bool dump_pending ();
 
         };
 
@@ -0,0 +1,140 @@
+/*
+ * NULL GRAPHICS CONTEXT
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192000
+ */
+
+#ifndef BASICS_NULL_GRAPHICS_CONTEXT_HEADER
+#define BASICS_NULL_GRAPHICS_CONTEXT_HEADER
+
+    #include <cstdint>
+    #include <basics/Graphics_Context>
+    #include <basics/Window>
+
+    namespace basics
+    {
+
+        class Recording_Canvas;
+
+        /**
+         * Contexto gráfico que no dibuja nada ni usa la GPU. Sirve para medir el coste en la CPU
+         * de la lógica y del envío de dibujos de las escenas sin el del driver, junto con
+         * Recording_Canvas (ver enable< Null_Rendering > ()).
+         * Se selecciona con director.set_graphics_context_factory (Null_Graphics_Context::create).
+         */
+        class Null_Graphics_Context : public Graphics_Context
+        {
+        public:
+
+            static bool create (Window::Accessor & window, Graphics_Resource_Cache * cache);
+
+        private:
+
+            Recording_Canvas * canvas;                      ///< Canvas al que se avisa del final de cada fotograma
+            unsigned           surface_width;
+            unsigned           surface_height;
+            uint64_t           frame_count;
+            bool               available;
+
+        public:
+
+            Null_Graphics_Context(Window & window, Graphics_Resource_Cache * cache = nullptr);
+
+           ~Null_Graphics_Context()
+            {
+                finalize ();
+            }
+
+        public:
+
+            Id get_id () const override
+            {
+                return ID(null);
+            }
+
+            bool is_available () const override
+            {
+                return available;
+            }
+
+            bool is_current () const override
+            {
+                return available;
+            }
+
+            void invalidate () override
+            {
+                available = false;
+            }
+
+            void suspend () override
+            {
+            }
+
+            bool resume () override
+            {
+                return available;
+            }
+
+            bool make_current () override
+            {
+                return available;
+            }
+
+            bool set_sync_swap (bool ) override
+            {
+                return false;
+            }
+
+            unsigned get_surface_width () override
+            {
+                return surface_width;
+            }
+
+            unsigned get_surface_height () override
+            {
+                return surface_height;
+            }
+
+            void reset_viewport () override;
+
+            void set_viewport (const Point2u & , const Size2u & ) override
+            {
+            }
+
+            bool flush_and_display () override;
+
+        public:
+
+            /**
+             * Número de fotogramas presentados desde que se creó el contexto.
+             */
+            uint64_t get_frame_count () const
+            {
+                return frame_count;
+            }
+
+            /**
+             * Último Recording_Canvas creado para este contexto (nullptr si no se ha creado ninguno).
+             */
+            Recording_Canvas * get_canvas () const
+            {
+                return canvas;
+            }
+
+            void set_canvas (Recording_Canvas * new_canvas)
+            {
+                canvas = new_canvas;
+            }
+
+        };
+
+    }
+
+#endif
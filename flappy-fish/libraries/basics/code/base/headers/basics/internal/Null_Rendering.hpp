@@ -0,0 +1,27 @@
+/*
+ * NULL RENDERING
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192000
+ */
+
+#ifndef BASICS_NULL_RENDERING_HEADER
+#define BASICS_NULL_RENDERING_HEADER
+
+    namespace basics
+    {
+
+        /**
+         * enable< Null_Rendering > () registra Recording_Canvas y Null_Texture_2D para los
+         * contextos creados con Null_Graphics_Context::create.
+         */
+        class Null_Rendering;
+
+    }
+
+#endif
@@ -0,0 +1,59 @@
+/*
+ * NULL TEXTURE 2D
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192000
+ */
+
+#ifndef BASICS_NULL_TEXTURE_2D_HEADER
+#define BASICS_NULL_TEXTURE_2D_HEADER
+
+    #include <basics/Texture_2D>
+
+    namespace basics
+    {
+
+        /**
+         * Textura del Null_Graphics_Context. Solo conserva su tamaño (los texels se descartan).
+         */
+        class Null_Texture_2D : public Texture_2D
+        {
+        public:
+
+            static std::shared_ptr< Texture_2D > create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
+
+        public:
+
+            static void enable ()
+            {
+                register_factory (ID(null), Null_Texture_2D::create);
+            }
+
+        public:
+
+            Null_Texture_2D(unsigned width, unsigned height) : Texture_2D(width, height, ID(null))
+            {
+            }
+
+        public:
+
+            bool initialize () override
+            {
+                return initialized = true;
+            }
+
+            void finalize () override
+            {
+                initialized = false;
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ * RANDOM
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192500
+ */
+
+#ifndef BASICS_RANDOM_HEADER
+#define BASICS_RANDOM_HEADER
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <basics/Id>
+
+    namespace basics
+    {
+
+        /**
+         * Generador PCG32 (XSH-RR con 64 bits de estado y 32 de salida). Es rápido, su estado cabe en
+         * dos enteros y cada objeto tiene su propio estado, así que a diferencia de rand() no se
+         * comparte entre subsistemas ni entre hilos.
+         * El segundo parámetro del constructor elige una de las 2^63 secuencias (streams) posibles:
+         * con la misma semilla y streams distintos se obtienen secuencias independientes.
+         * Cumple los requisitos de UniformRandomBitGenerator, por lo que se puede usar con las
+         * distribuciones de <random>.
+         */
+        class Pcg32
+        {
+        public:
+
+            typedef uint32_t result_type;
+
+            static constexpr uint64_t multiplier = 6364136223846793005ull;
+
+        private:
+
+            uint64_t state;
+            uint64_t increment;                             ///< Siempre impar. Determina el stream
+
+        public:
+
+            explicit Pcg32(uint64_t seed = 0x853C49E6748FEA9Bull, uint64_t stream = 0xDA3E39CB94B95BDBull)
+            {
+                this->seed (seed, stream);
+            }
+
+            void seed (uint64_t seed, uint64_t stream = 0xDA3E39CB94B95BDBull)
+            {
+                state     = 0;
+                increment = (stream << 1) | 1;
+
+                next ();
+
+                state += seed;
+
+                next ();
+            }
+
+        public:
+
+            static constexpr result_type min ()
+            {
+                return 0;
+            }
+
+            static constexpr result_type max ()
+            {
+                return 0xFFFFFFFFu;
+            }
+
+            result_type operator () ()
+            {
+                return next ();
+            }
+
+            uint32_t next ()
+            {
+                uint64_t old_state = state;
+
+                state = old_state * multiplier + increment;
+
+                return output (old_state);
+            }
+
+            /**
+             * Devuelve un número en [0, bound) sin el sesgo de next() % bound (bound debe ser mayor
+             * que 0).
+             */
+            uint32_t next_below (uint32_t bound)
+            {
+                const uint32_t threshold = (0u - bound) % bound;
+
+                for (;;)
+                {
+                    uint32_t value = next ();
+
+                    if (value >= threshold) return value % bound;
+                }
+            }
+
+            /**
+             * Devuelve un float en [0, 1) con los 24 bits de la mantisa aleatorios.
+             */
+            float next_float ()
+            {
+                return float(next () >> 8) * (1.f / 16777216.f);
+            }
+
+            /**
+             * Salta delta números de la secuencia en O(log delta) pasos en lugar de generarlos. Como
+             * la aritmética es módulo 2^64, advance(uint64_t(-n)) retrocede n números.
+             * Sirve para repartir una secuencia entre hilos o partidas simuladas en paralelo.
+             */
+            void advance (uint64_t delta);
+
+            /**
+             * Llena el array con los siguientes count números, los mismos (y en el mismo orden) que
+             * darían count llamadas a next(). Avanza varias copias del generador separadas entre sí
+             * en lugar de una, de modo que no hay dependencia entre iteraciones y el compilador puede
+             * vectorizar el bucle.
+             */
+            void fill (uint32_t * values, size_t count);
+
+        public:
+
+            static uint32_t output (uint64_t state)
+            {
+                uint32_t xorshifted = uint32_t(((state >> 18) ^ state) >> 27);
+                uint32_t rotation   = uint32_t(state >> 59);
+
+                return (xorshifted >> rotation) | (xorshifted << ((0u - rotation) & 31));
+            }
+
+        };
+
+        /**
+         * Generador basado en contador: el número de la posición counter de la secuencia se calcula
+         * directamente a partir de la clave y de counter (es SplitMix64), sin estado que avanzar.
+         * Sirve cuando el orden en el que se piden los números no es fijo (varias simulaciones que
+         * avanzan en paralelo, carriles SIMD, repeticiones que empiezan a mitad) o para saltar
+         * adelante y atrás sin coste.
+         */
+        class Counter_Random
+        {
+
+            uint64_t key;
+
+        public:
+
+            /**
+             * Se mezclan los bits de la semilla para que semillas seguidas den secuencias sin relación.
+             */
+            explicit Counter_Random(uint64_t seed = 0) : key(mix (seed))
+            {
+            }
+
+            uint64_t get_key () const
+            {
+                return key;
+            }
+
+            uint32_t at (uint64_t counter) const
+            {
+                return generate (key, counter);
+            }
+
+            /**
+             * Llena el array con los números de las posiciones [first, first + count). Las
+             * iteraciones son independientes, así que el bucle se vectoriza.
+             */
+            void fill (uint64_t first, uint32_t * values, size_t count) const
+            {
+                for (size_t index = 0; index < count; ++index)
+                {
+                    values[index] = generate (key, first + index);
+                }
+            }
+
+        public:
+
+            static uint32_t generate (uint64_t key, uint64_t counter)
+            {
+                return uint32_t(mix (key + counter * 0x9E3779B97F4A7C15ull) >> 32);
+            }
+
+            /**
+             * Mezcla los bits de un entero de 64 bits (el final de SplitMix64): cada bit de la entrada
+             * afecta a todos los de la salida.
+             */
+            static uint64_t mix (uint64_t value)
+            {
+                value += 0x9E3779B97F4A7C15ull;
+                value  = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+                value  = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+                return value ^ (value >> 31);
+            }
+
+        };
+
+        /**
+         * Reparte una semilla (p. ej. la de una sesión) en generadores independientes para cada
+         * subsistema: el mismo subsistema recibe siempre la misma secuencia para la misma semilla y
+         * lo que consuma uno no cambia lo que reciben los demás.
+         */
+        class Random_Streams
+        {
+
+            uint64_t seed;
+
+        public:
+
+            explicit Random_Streams(uint64_t seed = 0) : seed(seed)
+            {
+            }
+
+            uint64_t get_seed () const
+            {
+                return seed;
+            }
+
+            /**
+             * El estado inicial depende de la semilla y del subsistema, y el subsistema elige además
+             * el stream, así que dos subsistemas no comparten ni el punto de partida ni la secuencia.
+             */
+            Pcg32 get_stream (Id subsystem) const
+            {
+                return Pcg32(Counter_Random::mix (seed ^ Counter_Random::mix (subsystem)), subsystem);
+            }
+
+            Counter_Random get_counter_stream (Id subsystem) const
+            {
+                return Counter_Random(seed ^ Counter_Random::mix (subsystem));
+            }
+
+        };
+
+    }
+
+#endif
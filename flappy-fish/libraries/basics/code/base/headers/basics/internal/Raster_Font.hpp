@@ -63,6 +63,15 @@
                 return metrics;
             }
 
+            /**
+             * Cambia la prioridad con la que se restaura la textura de los glifos tras perderse el
+             * contexto gráfico (ver Graphics_Resource::Priority).
+             */
+            void set_priority (int priority)
+            {
+                if (atlas) atlas->set_priority (priority);
+            }
+
             const Character * get_character (uint32_t code) const
             {
                 Character_Map::const_iterator item = character_map.find (code);
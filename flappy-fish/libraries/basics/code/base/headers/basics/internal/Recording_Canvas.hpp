@@ -0,0 +1,214 @@
+/*
+ * RECORDING CANVAS
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192000
+ */
+
+#ifndef BASICS_RECORDING_CANVAS_HEADER
+#define BASICS_RECORDING_CANVAS_HEADER
+
+    #include <cstdint>
+    #include <initializer_list>
+    #include <vector>
+    #include <basics/Canvas>
+
+    namespace basics
+    {
+
+        /**
+         * Canvas que acepta todas las llamadas sin dibujar nada. Cuenta las llamadas de cada tipo
+         * en cada fotograma (el Null_Graphics_Context le avisa cuando termina uno) y, si se activa
+         * con set_recording(), guarda también la secuencia completa de llamadas con sus argumentos.
+         * Sirve para medir el coste de enviar los dibujos y para detectar cambios en el número
+         * de sprites o de cambios de estado por fotograma.
+         */
+        class Recording_Canvas : public Canvas
+        {
+        public:
+
+            static Canvas * create (Id id, Graphics_Context::Accessor & context, const Options & options);
+
+        public:
+
+            static void enable ()
+            {
+                register_factory (ID(null), Recording_Canvas::create);
+            }
+
+        public:
+
+            struct Counters
+            {
+                uint64_t clears;
+                uint64_t points;
+                uint64_t segments;
+                uint64_t triangles;                         ///< draw_triangle() y fill_triangle()
+                uint64_t rectangles;                        ///< draw_rectangle() y fill_rectangle() sin textura
+                uint64_t sprites;                           ///< fill_rectangle() con una textura o una porción de atlas
+                uint64_t texts;                             ///< draw_text()
+                uint64_t glyphs;                            ///< Glifos dibujados por draw_text() (no cuentan como sprites)
+                uint64_t state_changes;                     ///< Llamadas que cambian el estado del canvas
+                uint64_t texture_changes;                   ///< Sprites con una textura distinta de la del sprite anterior
+
+                uint64_t get_draw_calls () const
+                {
+                    return clears + points + segments + triangles + rectangles + sprites + glyphs;
+                }
+            };
+
+            enum Call_Type : uint8_t
+            {
+                RESET_STATE,
+                SET_SIZE,
+                SET_CLEAR_COLOR,
+                SET_COLOR,
+                SET_OPACITY,
+                SET_BLENDING,
+                SET_TRANSFORM,
+                APPLY_TRANSFORM,
+                CLEAR,
+                DRAW_POINT,
+                DRAW_SEGMENT,
+                DRAW_TRIANGLE,
+                FILL_TRIANGLE,
+                DRAW_RECTANGLE,
+                FILL_RECTANGLE,
+                FILL_TEXTURED_RECTANGLE,
+                FILL_SLICE,
+                DRAW_TEXT,
+                END_FRAME,
+            };
+
+            /**
+             * Llamada guardada. Los valores son los argumentos numéricos en el orden en que se
+             * pasan (las transformaciones guardan las dos primeras filas de la matriz).
+             */
+            struct Call
+            {
+                Call_Type    type;
+                int          handling;                      ///< Anclaje y volteo, o modo de mezcla en SET_BLENDING
+                float        values[6];
+                const void * resource;                      ///< Textura, porción de atlas o Text_Layout
+            };
+
+            typedef std::vector< Call > Call_List;
+
+        private:
+
+            Counters           current;
+            Counters           last_frame;
+            Counters           total;
+            uint64_t           frame_count;
+            const Texture_2D * last_texture;
+            bool               recording;
+            bool               drawing_text;            ///< Dentro de draw_text(), que dibuja los glifos con fill_rectangle()
+            Call_List          calls;
+
+        public:
+
+            Recording_Canvas();
+
+        public:
+
+            void set_recording (bool enabled)
+            {
+                recording = enabled;
+            }
+
+            bool is_recording () const
+            {
+                return recording;
+            }
+
+            const Call_List & get_calls () const
+            {
+                return calls;
+            }
+
+            void clear_calls ()
+            {
+                calls.clear ();
+            }
+
+            /**
+             * Contadores del último fotograma terminado.
+             */
+            const Counters & get_frame_counters () const
+            {
+                return last_frame;
+            }
+
+            /**
+             * Contadores del fotograma en curso.
+             */
+            const Counters & get_current_counters () const
+            {
+                return current;
+            }
+
+            /**
+             * Contadores acumulados de todos los fotogramas terminados.
+             */
+            const Counters & get_total_counters () const
+            {
+                return total;
+            }
+
+            uint64_t get_frame_count () const
+            {
+                return frame_count;
+            }
+
+            void reset_counters ();
+
+            /**
+             * Cierra el fotograma en curso. Lo llama Null_Graphics_Context::flush_and_display().
+             */
+            void end_frame ();
+
+        public:
+
+            void reset_state     () override;
+
+        public:
+
+            void set_size        (const Size2u & size) override;
+
+        public:
+
+            void set_clear_color (float r, float g, float b) override;
+            void set_color       (float r, float g, float b) override;
+            void set_opacity     (float opacity) override;
+            void set_blending    (Blending blending) override;
+            void set_transform   (const Transformation2f & transform) override;
+            void apply_transform (const Transformation2f & transform) override;
+
+        public:
+
+            void clear           () override;
+            void draw_point      (const Point2f & position) override;
+            void draw_segment    (const Point2f & a, const Point2f & b) override;
+            void draw_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void fill_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void draw_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Texture_2D * texture, int handling = CENTER) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling = CENTER) override;
+            void draw_text       (const Point2f & where, const Text_Layout & text_layout, int handling = TOP | LEFT) override;
+
+        private:
+
+            void record (Call_Type type, std::initializer_list< float > values, const void * resource = nullptr, int handling = 0);
+            void count_texture (const Texture_2D * texture);
+
+        };
+
+    }
+
+#endif
@@ -13,17 +13,35 @@
 #ifndef BASICS_RENDERER_HEADER
 #define BASICS_RENDERER_HEADER
 
+    #include <basics/Id>
+
     namespace basics
     {
 
         class Renderer
         {
 
+            Id renderer_type;                               ///< Tipo de renderer (p. ej. Canvas::renderer_type)
+
         protected:
 
-            Renderer() = default;
+            Renderer(Id type) : renderer_type(type)
+            {
+            }
+
             virtual ~Renderer() = default;
 
+        public:
+
+            /**
+             * Devuelve el tipo de renderer que se indicó al crearlo. Graphics_Context::get_renderer()
+             * lo compara con el tipo pedido en lugar de usar dynamic_cast.
+             */
+            Id get_renderer_type () const
+            {
+                return renderer_type;
+            }
+
         };
 
     }
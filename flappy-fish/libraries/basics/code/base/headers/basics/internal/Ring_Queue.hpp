@@ -0,0 +1,425 @@
+/*
+ * RING QUEUE
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191200
+ */
+
+#ifndef BASICS_RING_QUEUE_HEADER
+#define BASICS_RING_QUEUE_HEADER
+
+    #include <atomic>
+    #include <cstddef>
+    #include <thread>
+    #include <utility>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Indica qué hacer cuando se intenta añadir un elemento a una cola circular llena.
+         */
+        enum class Overflow_Policy
+        {
+            DISCARD,                                    ///< El elemento nuevo se descarta y push() retorna false.
+            WAIT                                        ///< El productor cede el hilo hasta que el consumidor libere un hueco.
+        };
+
+        namespace internal
+        {
+
+            /// Tamaño que se asume para una línea de caché (se usa para separar los índices de productor
+            /// y de consumidor, de modo que cada hilo escriba en una línea distinta).
+            constexpr size_t cache_line_size = 64;
+
+            template< size_t CAPACITY >
+            struct Ring_Capacity
+            {
+                static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "The capacity of a ring queue must be a power of two.");
+
+                static constexpr size_t value = CAPACITY;
+                static constexpr size_t mask  = CAPACITY - 1;
+            };
+
+        }
+
+        /**
+         * Cola circular acotada y sin bloqueos para un único hilo productor y un único hilo consumidor.
+         * Los índices de lectura y escritura se mantienen en líneas de caché distintas y cada lado guarda
+         * una copia local del índice del otro, de modo que en el caso habitual push() y poll() no tocan
+         * memoria compartida más que para publicar su propio avance.
+         * push() solo puede llamarse desde el hilo productor y poll(), peek(), drain() y clear() solo desde
+         * el hilo consumidor.
+         * @tparam ITEM Tipo de los elementos. Debe poder construirse por defecto y asignarse por movimiento.
+         * @tparam CAPACITY Número máximo de elementos pendientes. Debe ser una potencia de dos.
+         * @tparam POLICY Qué hacer cuando la cola está llena.
+         */
+        template< typename ITEM, size_t CAPACITY, Overflow_Policy POLICY = Overflow_Policy::DISCARD >
+        class Spsc_Ring_Queue : Non_Copyable
+        {
+
+            typedef internal::Ring_Capacity< CAPACITY > Capacity;
+
+            // Lado del consumidor (alineado para no compartir línea con lo que preceda a la cola):
+
+            alignas(internal::cache_line_size)
+            std::atomic< size_t > head;
+            size_t                cached_tail;
+            char                  consumer_padding[internal::cache_line_size - sizeof(std::atomic< size_t >) - sizeof(size_t)];
+
+            // Lado del productor:
+
+            alignas(internal::cache_line_size)
+            std::atomic< size_t > tail;
+            size_t                cached_head;
+            std::atomic< size_t > discarded;
+            char                  producer_padding[internal::cache_line_size - sizeof(std::atomic< size_t >) * 2 - sizeof(size_t)];
+
+            ITEM                  slots[CAPACITY];
+
+        public:
+
+            Spsc_Ring_Queue() : head(0), cached_tail(0), tail(0), cached_head(0), discarded(0)
+            {
+            }
+
+        public:
+
+            static constexpr size_t capacity ()
+            {
+                return CAPACITY;
+            }
+
+            /**
+             * Retorna el número de elementos que se han descartado por encontrar la cola llena.
+             */
+            size_t discarded_count () const
+            {
+                return discarded.load (std::memory_order_relaxed);
+            }
+
+            /**
+             * Retorna una estimación del número de elementos pendientes (exacta si no hay otros hilos
+             * modificando la cola en ese momento).
+             */
+            size_t size () const
+            {
+                return tail.load (std::memory_order_acquire) - head.load (std::memory_order_acquire);
+            }
+
+            bool empty () const
+            {
+                return size () == 0;
+            }
+
+        public:
+
+            bool push (const ITEM & item)
+            {
+                ITEM copy(item);
+
+                return push (std::move (copy));
+            }
+
+            bool push (ITEM && item)
+            {
+                const size_t position = tail.load (std::memory_order_relaxed);
+
+                if (position - cached_head == CAPACITY)
+                {
+                    cached_head = head.load (std::memory_order_acquire);
+
+                    while (position - cached_head == CAPACITY)
+                    {
+                        if (POLICY == Overflow_Policy::DISCARD)
+                        {
+                            discarded.fetch_add (1, std::memory_order_relaxed);
+
+                            return false;
+                        }
+
+                        std::this_thread::yield ();
+
+                        cached_head = head.load (std::memory_order_acquire);
+                    }
+                }
+
+                slots[position & Capacity::mask] = std::move (item);
+
+                tail.store (position + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            bool poll (ITEM & item)
+            {
+                const size_t position = head.load (std::memory_order_relaxed);
+
+                if (position == cached_tail)
+                {
+                    cached_tail = tail.load (std::memory_order_acquire);
+
+                    if (position == cached_tail) return false;
+                }
+
+                item = std::move (slots[position & Capacity::mask]);
+
+                head.store (position + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            bool peek (ITEM & item)
+            {
+                const size_t position = head.load (std::memory_order_relaxed);
+
+                if (position == cached_tail)
+                {
+                    cached_tail = tail.load (std::memory_order_acquire);
+
+                    if (position == cached_tail) return false;
+                }
+
+                item = slots[position & Capacity::mask];
+
+                return true;
+            }
+
+            /**
+             * Entrega al callback todos los elementos pendientes en el momento de la llamada (los que se
+             * añadan mientras tanto quedan para la siguiente) y libera sus huecos de una sola vez.
+             * @param callback Función u objeto invocable con la firma void(ITEM &).
+             * @return Número de elementos entregados.
+             */
+            template< typename CALLBACK >
+            size_t drain (CALLBACK && callback)
+            {
+                const size_t first = head.load (std::memory_order_relaxed);
+                const size_t last  = cached_tail = tail.load (std::memory_order_acquire);
+
+                for (size_t position = first; position != last; ++position)
+                {
+                    callback (slots[position & Capacity::mask]);
+                }
+
+                head.store (last, std::memory_order_release);
+
+                return last - first;
+            }
+
+            void clear ()
+            {
+                head.store (cached_tail = tail.load (std::memory_order_acquire), std::memory_order_release);
+            }
+
+        };
+
+        /**
+         * Cola circular acotada y sin bloqueos para varios hilos productores y un único hilo consumidor.
+         * Cada hueco lleva un número de secuencia que indica si está libre o si ya contiene un elemento
+         * publicado, de modo que los productores solo compiten al reservar su posición (con una operación
+         * compare-and-swap) y nunca esperan unos a otros mientras copian sus datos.
+         * push() puede llamarse desde cualquier hilo y poll(), peek(), drain() y clear() solo desde el
+         * hilo consumidor.
+         * @tparam ITEM Tipo de los elementos. Debe poder construirse por defecto y asignarse por movimiento.
+         * @tparam CAPACITY Número máximo de elementos pendientes. Debe ser una potencia de dos.
+         * @tparam POLICY Qué hacer cuando la cola está llena.
+         */
+        template< typename ITEM, size_t CAPACITY, Overflow_Policy POLICY = Overflow_Policy::DISCARD >
+        class Mpsc_Ring_Queue : Non_Copyable
+        {
+
+            typedef internal::Ring_Capacity< CAPACITY > Capacity;
+
+            struct Slot
+            {
+                std::atomic< size_t > sequence;
+                ITEM                  item;
+            };
+
+            // Lado del consumidor (alineado para no compartir línea con lo que preceda a la cola):
+
+            alignas(internal::cache_line_size)
+            std::atomic< size_t > head;
+            char                  consumer_padding[internal::cache_line_size - sizeof(std::atomic< size_t >)];
+
+            // Lado de los productores:
+
+            alignas(internal::cache_line_size)
+            std::atomic< size_t > tail;
+            std::atomic< size_t > discarded;
+            char                  producer_padding[internal::cache_line_size - sizeof(std::atomic< size_t >) * 2];
+
+            Slot                  slots[CAPACITY];
+
+        public:
+
+            Mpsc_Ring_Queue() : head(0), tail(0), discarded(0)
+            {
+                for (size_t index = 0; index < CAPACITY; ++index)
+                {
+                    slots[index].sequence.store (index, std::memory_order_relaxed);
+                }
+            }
+
+        public:
+
+            static constexpr size_t capacity ()
+            {
+                return CAPACITY;
+            }
+
+            size_t discarded_count () const
+            {
+                return discarded.load (std::memory_order_relaxed);
+            }
+
+            size_t size () const
+            {
+                const size_t first = head.load (std::memory_order_acquire);
+                const size_t last  = tail.load (std::memory_order_acquire);
+
+                return last > first ? last - first : 0;
+            }
+
+            bool empty () const
+            {
+                return size () == 0;
+            }
+
+        public:
+
+            bool push (const ITEM & item)
+            {
+                ITEM copy(item);
+
+                return push (std::move (copy));
+            }
+
+            bool push (ITEM && item)
+            {
+                size_t position = tail.load (std::memory_order_relaxed);
+
+                for (;;)
+                {
+                    Slot & slot     = slots[position & Capacity::mask];
+                    size_t sequence = slot.sequence.load (std::memory_order_acquire);
+
+                    if (sequence == position)
+                    {
+                        // El hueco está libre: se intenta reservar la posición (si otro productor se
+                        // adelanta, compare_exchange actualiza position y se vuelve a intentar):
+
+                        if (tail.compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+                        {
+                            slot.item = std::move (item);
+
+                            slot.sequence.store (position + 1, std::memory_order_release);
+
+                            return true;
+                        }
+                    }
+                    else
+                    if (sequence < position)
+                    {
+                        // El hueco aún contiene un elemento de la vuelta anterior: la cola está llena.
+
+                        if (POLICY == Overflow_Policy::DISCARD)
+                        {
+                            discarded.fetch_add (1, std::memory_order_relaxed);
+
+                            return false;
+                        }
+
+                        std::this_thread::yield ();
+
+                        position = tail.load (std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        position = tail.load (std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            bool poll (ITEM & item)
+            {
+                const size_t position = head.load (std::memory_order_relaxed);
+                Slot       & slot     = slots[position & Capacity::mask];
+
+                if (slot.sequence.load (std::memory_order_acquire) != position + 1) return false;
+
+                item = std::move (slot.item);
+
+                release (slot, position);
+
+                return true;
+            }
+
+            bool peek (ITEM & item)
+            {
+                const size_t position = head.load (std::memory_order_relaxed);
+                Slot       & slot     = slots[position & Capacity::mask];
+
+                if (slot.sequence.load (std::memory_order_acquire) != position + 1) return false;
+
+                item = slot.item;
+
+                return true;
+            }
+
+            /**
+             * Entrega al callback los elementos publicados consecutivos a partir del primero pendiente.
+             * Se detiene al llegar a un hueco que un productor ha reservado pero todavía no ha publicado.
+             * @param callback Función u objeto invocable con la firma void(ITEM &).
+             * @return Número de elementos entregados.
+             */
+            template< typename CALLBACK >
+            size_t drain (CALLBACK && callback)
+            {
+                const size_t first    = head.load (std::memory_order_relaxed);
+                size_t       position = first;
+
+                for (;;)
+                {
+                    Slot & slot = slots[position & Capacity::mask];
+
+                    if (slot.sequence.load (std::memory_order_acquire) != position + 1) break;
+
+                    callback (slot.item);
+
+                    release (slot, position++);
+                }
+
+                return position - first;
+            }
+
+            void clear ()
+            {
+                ITEM item;
+
+                while (poll (item));
+            }
+
+        private:
+
+            void release (Slot & slot, size_t position)
+            {
+                // El hueco queda libre para la siguiente vuelta de los productores:
+
+                slot.sequence.store (position + CAPACITY, std::memory_order_release);
+
+                head.store (position + 1, std::memory_order_release);
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,153 @@
+/*
+ * SMALL OBJECT POOL
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191730
+ */
+
+#ifndef BASICS_SMALL_OBJECT_POOL_HEADER
+#define BASICS_SMALL_OBJECT_POOL_HEADER
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <memory>
+    #include <new>
+    #include <utility>
+    #include <basics/Non_Instantiable>
+
+    namespace basics
+    {
+
+        /**
+         * Reserva de bloques de memoria pequeños (hasta max_size bytes) agrupados por clases de tamaño.
+         * Cada clase obtiene la memoria en trozos grandes que se dividen en bloques iguales, de modo que
+         * los objetos pequeños que se crean y destruyen durante toda la sesión (bloques de control de
+         * shared_ptr, texturas, assets, nodos de listas, etc.) no fragmentan el heap general.
+         * Cada hilo tiene una caché de bloques libres de cada clase, por lo que la mayoría de las
+         * reservas y liberaciones no necesitan sincronización. La memoria de los trozos no se devuelve
+         * al sistema.
+         * Los bloques mayores que max_size se reservan con new y delete.
+         */
+        class Small_Object_Pool : Non_Instantiable
+        {
+        public:
+
+            static constexpr size_t   max_size    = 512;
+            static constexpr size_t   granularity = 16;         ///< Alineación de los bloques
+            static constexpr unsigned class_count = 16;
+
+            struct Class_Stats
+            {
+                size_t block_size;
+                size_t reserved_blocks;                     ///< Bloques de todos los trozos reservados
+                size_t cached_blocks;                       ///< Bloques libres en las cachés de los hilos
+                size_t free_blocks;                         ///< Bloques libres compartidos por todos los hilos
+                size_t used_blocks;
+            };
+
+            struct Stats
+            {
+                size_t      reserved_bytes;                 ///< Memoria de todos los trozos
+                size_t      used_bytes;                     ///< Memoria de los bloques en uso
+                float       occupancy;                      ///< used_bytes / reserved_bytes
+                float       fragmentation;                  ///< 1 - occupancy: memoria reservada que no se usa
+                uint64_t    large_allocations;              ///< Reservas mayores que max_size
+                Class_Stats classes[class_count];
+            };
+
+        public:
+
+            static void * allocate (size_t size);
+
+            /**
+             * @param size Debe ser el mismo tamaño con el que se reservó el bloque.
+             */
+            static void deallocate (void * pointer, size_t size);
+
+            /**
+             * Devuelve al almacén compartido los bloques de la caché del hilo que hace la llamada.
+             * Se hace automáticamente cuando el hilo termina.
+             */
+            static void flush_thread_cache ();
+
+            /**
+             * Devuelve el estado de la reserva. Como los hilos siguen reservando mientras tanto, los
+             * valores son aproximados.
+             */
+            static Stats get_stats ();
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Adaptador para que los contenedores de la biblioteca estándar y std::allocate_shared()
+         * reserven en Small_Object_Pool. Los bloques solo están alineados a granularity bytes, así
+         * que no admite tipos con una alineación mayor (p. ej. con alignas(64)).
+         */
+        template< typename TYPE >
+        class Pool_Allocator
+        {
+            static_assert
+            (
+                alignof(TYPE) <= Small_Object_Pool::granularity,
+                "The blocks of Small_Object_Pool aren't aligned enough for this type: use std::make_shared or new."
+            );
+
+        public:
+
+            typedef TYPE value_type;
+
+            Pool_Allocator() = default;
+
+            template< typename OTHER >
+            Pool_Allocator(const Pool_Allocator< OTHER > & )
+            {
+            }
+
+        public:
+
+            TYPE * allocate (size_t count)
+            {
+                return static_cast< TYPE * >(Small_Object_Pool::allocate (count * sizeof(TYPE)));
+            }
+
+            void deallocate (TYPE * pointer, size_t count)
+            {
+                Small_Object_Pool::deallocate (pointer, count * sizeof(TYPE));
+            }
+
+            template< typename OTHER >
+            bool operator == (const Pool_Allocator< OTHER > & ) const
+            {
+                return true;
+            }
+
+            template< typename OTHER >
+            bool operator != (const Pool_Allocator< OTHER > & ) const
+            {
+                return false;
+            }
+
+        };
+
+        /**
+         * Equivalente a std::make_shared() que reserva el objeto junto con su bloque de control en
+         * Small_Object_Pool. Si juntos ocupan más de max_size bytes se reservan con new, como haría
+         * std::make_shared(), pero cuentan en Stats::large_allocations: los objetos grandes que se
+         * crean pocas veces (p. ej. las escenas) se deben crear directamente con std::make_shared().
+         */
+        template< typename TYPE, typename ... ARGUMENTS >
+        inline std::shared_ptr< TYPE > make_pooled (ARGUMENTS && ... arguments)
+        {
+            return std::allocate_shared< TYPE > (Pool_Allocator< TYPE >(), std::forward< ARGUMENTS > (arguments)...);
+        }
+
+    }
+
+#endif
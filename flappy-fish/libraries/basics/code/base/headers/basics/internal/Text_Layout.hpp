@@ -15,6 +15,7 @@
 
     #include <string>
     #include <vector>
+    #include <basics/Frame_Arena>
     #include <basics/Raster_Font>
     #include <basics/Point>
     #include <basics/Size>
@@ -39,7 +40,7 @@
                 }
             };
 
-            typedef std::vector< Glyph > Glyph_List;
+            typedef std::vector< Glyph, Frame_Allocator< Glyph > > Glyph_List;
 
         private:
 
@@ -49,7 +50,23 @@
 
         public:
 
-            Text_Layout(const Raster_Font & font, const std::wstring & text);
+            /**
+             * @param allocator Si se pasa frame_arena, la lista de glifos se reserva en la memoria del
+             *     fotograma y la disposición solo es válida hasta el final del fotograma siguiente (es lo
+             *     adecuado para el texto que se vuelve a componer en cada fotograma).
+             */
+            Text_Layout(const Raster_Font & font, const std::wstring & text, const Glyph_List::allocator_type & allocator = Glyph_List::allocator_type())
+            :
+                Text_Layout(font, text.data (), text.length (), allocator)
+            {
+            }
+
+            /**
+             * Igual que el anterior con un texto que no está en un std::wstring (p. ej. uno compuesto
+             * con swprintf() en la memoria del fotograma), de modo que no hace falta reservar memoria
+             * para él.
+             */
+            Text_Layout(const Raster_Font & font, const wchar_t * text, size_t length, const Glyph_List::allocator_type & allocator = Glyph_List::allocator_type());
 
         public:
 
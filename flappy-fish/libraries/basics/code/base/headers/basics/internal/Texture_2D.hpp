@@ -57,17 +57,29 @@
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options = {});
 
+            /**
+             * Lee y decodifica la imagen de un asset sin crear la textura, por lo que no necesita el
+             * contexto gráfico y se puede llamar desde otro hilo (p. ej. en Scene::preload()). La
+             * textura se crea después con create() a partir de color_buffer y options.
+             */
+            static bool decode (const std::string & asset_path, Color_Buffer< Rgba8888 > & color_buffer, Options & options);
+
         protected:
 
             float width;
             float height;
 
+        private:
+
+            Id    backend;                                  ///< Id del contexto gráfico cuya implementación creó la textura
+
         protected:
 
-            Texture_2D(unsigned width, unsigned height)
+            Texture_2D(unsigned width, unsigned height, Id backend)
             :
-                width (float(width )),
-                height(float(height))
+                width  (float(width )),
+                height (float(height)),
+                backend(backend)
             {
             }
 
@@ -87,6 +99,16 @@
                 return height;
             }
 
+            /**
+             * Devuelve el id del contexto gráfico (el mismo con el que se registra su factoría) de la
+             * implementación que creó la textura. Los canvas lo comparan con el suyo para convertir
+             * la textura a su tipo con static_cast en lugar de usar dynamic_cast en cada dibujo.
+             */
+            Id get_backend () const
+            {
+                return backend;
+            }
+
         };
 
     }
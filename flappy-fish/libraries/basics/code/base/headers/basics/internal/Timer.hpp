@@ -14,6 +14,7 @@
 #define BASICS_TIMER_HEADER
 
     #include <chrono>
+    #include <cstdint>
 
     namespace basics
     {
@@ -66,6 +67,19 @@
                 .count ();
             }
 
+            /**
+             * Retorna el instante actual del reloj monótono en nanosegundos. En Android y en Linux se
+             * trata del mismo reloj (CLOCK_MONOTONIC) que da las marcas de tiempo de los eventos de entrada.
+             */
+            static int64_t get_monotonic_time ()
+            {
+                return duration_cast< std::chrono::nanoseconds >
+                (
+                    std::chrono::steady_clock::now ().time_since_epoch ()
+                )
+                .count ();
+            }
+
         };
 
     }
@@ -0,0 +1,136 @@
+/*
+ * TOUCH HISTORY
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191300
+ */
+
+#ifndef BASICS_TOUCH_HISTORY_HEADER
+#define BASICS_TOUCH_HISTORY_HEADER
+
+    #include <cstddef>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Guarda todas las muestras de movimiento táctil recibidas durante un fotograma, en el orden en
+         * que se produjeron. Cuando los movimientos consecutivos de un mismo puntero se funden en un solo
+         * evento, las escenas que necesiten la trayectoria completa (p. ej. para reconocer gestos)
+         * pueden recuperar aquí las muestras intermedias con sus marcas de tiempo.
+         * El almacenamiento es de tamaño fijo: si se llena, las muestras siguientes se descartan.
+         */
+        class Touch_History
+        {
+        public:
+
+            struct Sample
+            {
+                int32_t pointer_id;
+                float   x;
+                float   y;
+                int64_t timestamp;                      ///< Nanosegundos del reloj monótono de la fuente (0 si se desconoce).
+            };
+
+            static constexpr size_t capacity = 512;
+
+        private:
+
+            Sample samples[capacity];
+            size_t count;
+            size_t discarded;
+
+        public:
+
+            Touch_History() : count(0), discarded(0)
+            {
+            }
+
+        public:
+
+            void clear ()
+            {
+                count     = 0;
+                discarded = 0;
+            }
+
+            bool add (const Sample & sample)
+            {
+                if (count < capacity)
+                {
+                    samples[count++] = sample;
+                    return true;
+                }
+
+                ++discarded;
+                return false;
+            }
+
+        public:
+
+            size_t size () const
+            {
+                return count;
+            }
+
+            bool empty () const
+            {
+                return count == 0;
+            }
+
+            /**
+             * Retorna el número de muestras que no cupieron en el fotograma actual.
+             */
+            size_t discarded_count () const
+            {
+                return discarded;
+            }
+
+            const Sample & operator [] (size_t index) const
+            {
+                return samples[index];
+            }
+
+            const Sample * begin () const
+            {
+                return samples;
+            }
+
+            const Sample * end () const
+            {
+                return samples + count;
+            }
+
+            /**
+             * Invoca el callback con cada muestra del puntero indicado, de la más antigua a la más reciente.
+             * @param callback Función u objeto invocable con la firma void(const Sample &).
+             * @return Número de muestras del puntero.
+             */
+            template< typename CALLBACK >
+            size_t for_each (int32_t pointer_id, CALLBACK && callback) const
+            {
+                size_t matches = 0;
+
+                for (const Sample & sample : *this)
+                {
+                    if (sample.pointer_id == pointer_id)
+                    {
+                        callback (sample);
+                        ++matches;
+                    }
+                }
+
+                return matches;
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,216 @@
+/*
+ * TRACE
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191530
+ */
+
+#ifndef BASICS_TRACE_HEADER
+#define BASICS_TRACE_HEADER
+
+    #include <atomic>
+    #include <string>
+    #include <basics/macros>
+    #include <basics/Ring_Queue>
+    #include <basics/Timer>
+
+    // El trazado está activo por defecto en las compilaciones de depuración. Se puede forzar en un sentido
+    // u otro definiendo BASICS_TRACE_ENABLED o BASICS_TRACE_DISABLED:
+
+    #if !defined(BASICS_TRACE_ENABLED) && !defined(BASICS_TRACE_DISABLED) && !defined(NDEBUG)
+        #define BASICS_TRACE_ENABLED
+    #endif
+
+    namespace basics
+    {
+
+        /**
+         * Registro de trazas de ejecución para analizar a dónde va el tiempo (carga de recursos, envío de
+         * dibujos, hilos de carga, etc.). Cada hilo escribe sus marcas en su propio búfer circular sin
+         * bloqueos y se exportan en el formato JSON de trazas de Chrome, que pueden abrirse con
+         * chrome://tracing o con Perfetto (ui.perfetto.dev). Los búferes tienen un tamaño fijo, así que
+         * durante una exportación larga hay que vaciarlos periódicamente con export_pending() (el
+         * Director lo hace cuando se le indica un archivo, ver Director::set_trace_path()). Las marcas
+         * que no caben en un búfer lleno se descartan y se cuentan en la exportación.
+         * No se debe usar directamente sino a través de las macros BASICS_TRACE_*, que desaparecen por
+         * completo cuando BASICS_TRACE_ENABLED no está definida.
+         * Los nombres deben ser cadenas literales (solo se guarda el puntero).
+         */
+        class Trace
+        {
+        public:
+
+            enum Type : char
+            {
+                COMPLETE = 'X',                             ///< Intervalo de tiempo (marca de ámbito)
+                INSTANT  = 'i',                             ///< Suceso puntual
+                COUNTER  = 'C'                              ///< Valor de un contador
+            };
+
+            struct Record
+            {
+                const char * name;
+                Type         type;
+                int64_t      timestamp;                     ///< Nanosegundos del reloj monótono
+                int64_t      value;                         ///< Duración en nanosegundos o valor del contador
+            };
+
+            static constexpr size_t records_per_thread = 4096;
+
+            // Búfer de un hilo. Cuando el hilo termina, el búfer pasa al siguiente hilo que se cree (que
+            // aparece en las trazas como el mismo hilo, ya que no coinciden en el tiempo):
+
+            struct Thread_Buffer
+            {
+                unsigned                                        thread_id;
+                std::atomic< const char * >                     thread_name;
+                std::atomic< bool >                             in_use;
+                size_t                                          reported_discards;
+                Spsc_Ring_Queue< Record, records_per_thread >   records;
+                Thread_Buffer                                 * next;
+            };
+
+        private:
+
+            static std::atomic< bool > recording;
+
+            static thread_local Thread_Buffer * thread_buffer;
+
+        public:
+
+            /**
+             * Activa o desactiva la grabación de trazas en tiempo de ejecución (está activa al comenzar).
+             */
+            static void set_recording (bool enabled)
+            {
+                recording.store (enabled, std::memory_order_relaxed);
+            }
+
+            static bool is_recording ()
+            {
+                return recording.load (std::memory_order_relaxed);
+            }
+
+            static void add (const char * name, Type type, int64_t timestamp, int64_t value)
+            {
+                if (is_recording ())
+                {
+                    get_thread_buffer ().records.push (Record{ name, type, timestamp, value });
+                }
+            }
+
+            static void instant (const char * name)
+            {
+                add (name, INSTANT, Timer::get_monotonic_time (), 0);
+            }
+
+            static void counter (const char * name, int64_t value)
+            {
+                add (name, COUNTER, Timer::get_monotonic_time (), value);
+            }
+
+            /**
+             * Da nombre al hilo que hace la llamada en las trazas exportadas.
+             */
+            static void set_thread_name (const char * name)
+            {
+                get_thread_buffer ().thread_name.store (name, std::memory_order_relaxed);
+            }
+
+            /**
+             * Empieza a exportar a un archivo las marcas grabadas (JSON de trazas de Chrome). Las
+             * funciones de exportación vacían los búferes de los hilos, por lo que solo debe usarlas un
+             * hilo a la vez.
+             */
+            static bool begin_export (const std::string & path);
+
+            /**
+             * Escribe en el archivo de la exportación en curso las marcas pendientes de todos los hilos.
+             */
+            static void export_pending ();
+
+            /**
+             * Escribe las marcas pendientes, los nombres de los hilos y cuántas marcas se han descartado
+             * en cada uno y cierra el archivo.
+             * @return false si no había una exportación en curso o no se ha podido escribir el archivo.
+             */
+            static bool end_export ();
+
+            static bool is_exporting ();
+
+            /**
+             * Escribe en un archivo las marcas grabadas desde la exportación anterior.
+             */
+            static bool save (const std::string & path)
+            {
+                return begin_export (path) && end_export ();
+            }
+
+            /**
+             * Retorna cuántas marcas se han descartado en total por encontrar lleno el búfer de su hilo.
+             */
+            static size_t get_discarded_count ();
+
+        private:
+
+            static Thread_Buffer & get_thread_buffer ()
+            {
+                return thread_buffer ? *thread_buffer : *(thread_buffer = acquire_thread_buffer ());
+            }
+
+            static Thread_Buffer * acquire_thread_buffer ();
+            static void            release_thread_buffer (void * buffer);
+
+        public:
+
+            /**
+             * Marca el intervalo de tiempo que dura su ámbito.
+             */
+            class Scope
+            {
+
+                const char * name;
+                int64_t      start;
+
+            public:
+
+                Scope(const char * name) : name(name), start(Timer::get_monotonic_time ())
+                {
+                }
+
+               ~Scope()
+                {
+                    add (name, COMPLETE, start, Timer::get_monotonic_time () - start);
+                }
+
+            };
+
+        };
+
+    }
+
+    #define BASICS_TRACE_CONCATENATE_(A, B) A##B
+    #define BASICS_TRACE_CONCATENATE(A, B)  BASICS_TRACE_CONCATENATE_(A, B)
+
+    #if defined(BASICS_TRACE_ENABLED)
+
+        #define BASICS_TRACE_SCOPE(NAME)          basics::Trace::Scope BASICS_TRACE_CONCATENATE(trace_scope_, __LINE__)(NAME)
+        #define BASICS_TRACE_INSTANT(NAME)        basics::Trace::instant (NAME)
+        #define BASICS_TRACE_COUNTER(NAME, VALUE) basics::Trace::counter (NAME, int64_t(VALUE))
+        #define BASICS_TRACE_THREAD_NAME(NAME)    basics::Trace::set_thread_name (NAME)
+
+    #else
+
+        #define BASICS_TRACE_SCOPE(NAME)          ((void)0)
+        #define BASICS_TRACE_INSTANT(NAME)        ((void)0)
+        #define BASICS_TRACE_COUNTER(NAME, VALUE) ((void)0)
+        #define BASICS_TRACE_THREAD_NAME(NAME)    ((void)0)
+
+    #endif
+
+#endif
@@ -138,7 +138,7 @@
             std::atomic< bool > available;
             std::atomic< bool > focused;
 
-            Event_Queue event_queue;
+            System_Event_Queue event_queue;             ///< Solo REDRAW se puede descartar si la cola se llena
 
             struct
             {
@@ -235,12 +235,14 @@
 
             void push (const Event & event)
             {
-                event_queue.push (event);
+                event_queue.push (event, event.id == REDRAW);
             }
 
             void push (Event && event)
             {
-                event_queue.push (event);
+                const bool can_be_dropped = event.id == REDRAW;
+
+                event_queue.push (std::move (event), can_be_dropped);
             }
 
             bool poll (Event & event)
@@ -253,6 +255,11 @@
                 return event_queue.peek (event);
             }
 
+            size_t discarded_event_count () const
+            {
+                return event_queue.discarded_count ();
+            }
+
         };
 
         constexpr Id default_window_id = FNV(default-window);
@@ -0,0 +1,127 @@
+/*
+ * WORK STEALING POOL
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192400
+ */
+
+#ifndef BASICS_WORK_STEALING_POOL_HEADER
+#define BASICS_WORK_STEALING_POOL_HEADER
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <cstddef>
+    #include <cstdint>
+    #include <deque>
+    #include <memory>
+    #include <mutex>
+    #include <thread>
+    #include <type_traits>
+    #include <vector>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Hilos que reparten entre ellos los trozos de un rango de índices. Cada hilo empieza con una
+         * parte contigua del rango en su propia cola y, cuando la termina, roba trozos del principio
+         * de las colas de los demás, de modo que el trabajo se equilibra aunque unos trozos cuesten
+         * mucho más que otros (p. ej. partidas que duran más).
+         * El hilo que llama a parallel_for() también trabaja (es el trabajador 0), así que con un solo
+         * hilo no se crea ninguno adicional.
+         */
+        class Work_Stealing_Pool : Non_Copyable
+        {
+
+            struct Range
+            {
+                size_t begin;
+                size_t end;
+            };
+
+            struct Worker_Queue
+            {
+                std::mutex          mutex;
+                std::deque< Range > ranges;
+                uint64_t            steals = 0;             ///< Trozos que este trabajador ha robado
+            };
+
+            typedef void (* Invoker) (void * body, size_t begin, size_t end, unsigned worker);
+
+            std::vector< std::unique_ptr< Worker_Queue > > queues;          ///< Separadas en el heap para que no compartan líneas de caché
+            std::vector< std::thread >                      workers;
+
+            std::mutex                 mutex;
+            std::condition_variable    work_ready;
+            std::condition_variable    work_done;
+            uint64_t                   generation;          ///< Cuenta los trabajos para que los hilos sepan cuándo hay uno nuevo
+            unsigned                   busy_workers;
+            bool                       stopping;
+
+            Invoker                    invoker;
+            void                     * body;
+            std::atomic< size_t >      pending_ranges;
+
+        public:
+
+            /**
+             * @param thread_count Número de trabajadores contando el hilo que llama (0 para usar
+             *     todos los núcleos).
+             */
+            Work_Stealing_Pool(unsigned thread_count = 0);
+
+           ~Work_Stealing_Pool();
+
+        public:
+
+            unsigned get_thread_count () const
+            {
+                return unsigned(queues.size ());
+            }
+
+            /**
+             * Devuelve el número total de trozos robados desde que se creó (sirve para ver si el
+             * reparto inicial estaba equilibrado).
+             */
+            uint64_t get_steal_count () const;
+
+            /**
+             * Llama a body(begin, end, worker) con trozos de como mucho grain índices que cubren
+             * [0, count) y espera a que terminen todos. worker es el índice del trabajador que
+             * ejecuta el trozo (menor que get_thread_count()), por lo que sirve para acumular
+             * resultados por hilo sin sincronización.
+             * No se puede llamar desde body().
+             */
+            template< typename BODY >
+            void parallel_for (size_t count, size_t grain, BODY && body)
+            {
+                run
+                (
+                    count,
+                    grain,
+                    [] (void * body, size_t begin, size_t end, unsigned worker)
+                    {
+                        (*static_cast< typename std::remove_reference< BODY >::type * >(body)) (begin, end, worker);
+                    },
+                    const_cast< void * >(static_cast< const void * >(&body))
+                );
+            }
+
+        private:
+
+            void run         (size_t count, size_t grain, Invoker invoker, void * body);
+            void work        (unsigned worker);
+            bool take        (unsigned worker, Range & range);
+            void worker_loop (unsigned worker);
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,322 @@
+/*
+ * ALLOCATION TRACKER
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191630
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <basics/Allocation_Tracker>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Todas las variables tienen inicialización estática (a cero) para que se puedan usar desde las
+        // reservas que se hacen antes de que se construyan los objetos globales:
+
+        struct Atomic_Counters
+        {
+            std::atomic< const char * > name;
+            std::atomic< uint64_t     > allocations;
+            std::atomic< uint64_t     > deallocations;
+            std::atomic< uint64_t     > bytes;
+            std::atomic< uint64_t     > live_bytes;
+            std::atomic< uint64_t     > peak_bytes;
+        };
+
+        struct Thread_State
+        {
+            unsigned tag;
+            unsigned forbidden;                             ///< Número de ámbitos Forbid activos
+            bool     reporting;                             ///< Se está llamando al manejador de infracciones
+            uint64_t allocations;
+            uint64_t deallocations;
+            uint64_t bytes;
+        };
+
+        Atomic_Counters                                     totals;
+        Atomic_Counters                                     tags[Allocation_Tracker::max_tags];
+        std::atomic< unsigned >                             tag_count;
+        std::atomic< uint64_t >                             violations;
+        std::atomic< Allocation_Tracker::Violation_Handler > violation_handler;
+
+        thread_local Thread_State thread_state;
+
+        Allocation_Tracker::Counters load (const Atomic_Counters & counters)
+        {
+            return
+            {
+                counters.allocations  .load (std::memory_order_relaxed),
+                counters.deallocations.load (std::memory_order_relaxed),
+                counters.bytes        .load (std::memory_order_relaxed),
+                counters.live_bytes   .load (std::memory_order_relaxed),
+                counters.peak_bytes   .load (std::memory_order_relaxed),
+            };
+        }
+
+    }
+
+    #if defined(BASICS_ALLOCATION_TRACKING_ENABLED)
+
+        namespace
+        {
+
+            unsigned register_tag (const char * tag)
+            {
+                for (unsigned index = 1; index < Allocation_Tracker::max_tags; ++index)
+                {
+                    const char * name = tags[index].name.load (std::memory_order_acquire);
+
+                    if (name == nullptr)
+                    {
+                        if (tags[index].name.compare_exchange_strong (name, tag, std::memory_order_acq_rel))
+                        {
+                            tag_count.fetch_add (1, std::memory_order_relaxed);
+
+                            return index;
+                        }
+                    }
+
+                    if (name == tag || std::strcmp (name, tag) == 0)
+                    {
+                        return index;
+                    }
+                }
+
+                return Allocation_Tracker::max_tags - 1;
+            }
+
+            // Cada bloque lleva delante una cabecera con su tamaño y su etiqueta para poder descontarlo
+            // al liberarlo. Su tamaño es el de la alineación máxima para que el bloque la conserve:
+
+            union Header
+            {
+                struct
+                {
+                    size_t   size;
+                    unsigned tag;
+                }
+                info;
+
+                std::max_align_t alignment;
+            };
+
+            void add (Atomic_Counters & counters, size_t size)
+            {
+                counters.allocations.fetch_add (1,    std::memory_order_relaxed);
+                counters.bytes      .fetch_add (size, std::memory_order_relaxed);
+
+                uint64_t live = counters.live_bytes.fetch_add (size, std::memory_order_relaxed) + size;
+                uint64_t peak = counters.peak_bytes.load (std::memory_order_relaxed);
+
+                while (live > peak && !counters.peak_bytes.compare_exchange_weak (peak, live, std::memory_order_relaxed));
+            }
+
+            void subtract (Atomic_Counters & counters, size_t size)
+            {
+                counters.deallocations.fetch_add (1,    std::memory_order_relaxed);
+                counters.live_bytes   .fetch_sub (size, std::memory_order_relaxed);
+            }
+
+            void * allocate (size_t size)
+            {
+                Header * header = static_cast< Header * >(std::malloc (sizeof(Header) + size));
+
+                if (!header) return nullptr;
+
+                Thread_State & state = thread_state;
+
+                header->info.size = size;
+                header->info.tag  = state.tag;
+
+                add (totals,          size);
+                add (tags[state.tag], size);
+
+                state.allocations += 1;
+                state.bytes       += size;
+
+                if (state.forbidden && !state.reporting)
+                {
+                    violations.fetch_add (1, std::memory_order_relaxed);
+
+                    Allocation_Tracker::Violation_Handler handler = violation_handler.load (std::memory_order_acquire);
+
+                    if (handler)
+                    {
+                        state.reporting = true;
+
+                        handler (size, Allocation_Tracker::get_tag_name (state.tag));
+
+                        state.reporting = false;
+                    }
+                }
+
+                return header + 1;
+            }
+
+            void * allocate_or_fail (size_t size)
+            {
+                for (;;)
+                {
+                    void * pointer = allocate (size);
+
+                    if (pointer) return pointer;
+
+                    std::new_handler handler = std::get_new_handler ();
+
+                    if (!handler)
+                    {
+                        #if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+                            throw std::bad_alloc();
+                        #else
+                            std::abort ();
+                        #endif
+                    }
+
+                    handler ();
+                }
+            }
+
+            void deallocate (void * pointer)
+            {
+                if (pointer)
+                {
+                    Header * header = static_cast< Header * >(pointer) - 1;
+
+                    subtract (totals,                  header->info.size);
+                    subtract (tags[header->info.tag],  header->info.size);
+
+                    thread_state.deallocations += 1;
+
+                    std::free (header);
+                }
+            }
+
+        }
+
+    #endif
+
+    // ---------------------------------------------------------------------------------------------
+
+    Allocation_Tracker::Counters Allocation_Tracker::get_counters ()
+    {
+        return load (totals);
+    }
+
+    Allocation_Tracker::Counters Allocation_Tracker::get_thread_counters ()
+    {
+        const Thread_State & state = thread_state;
+
+        return { state.allocations, state.deallocations, state.bytes, 0, 0 };
+    }
+
+    Allocation_Tracker::Counters Allocation_Tracker::get_tag_counters (unsigned index)
+    {
+        return load (tags[index < max_tags ? index : max_tags - 1]);
+    }
+
+    const char * Allocation_Tracker::get_tag_name (unsigned index)
+    {
+        const char * name = index > 0 && index < max_tags ? tags[index].name.load (std::memory_order_acquire) : nullptr;
+
+        return name ? name : "untagged";
+    }
+
+    unsigned Allocation_Tracker::get_tag_count ()
+    {
+        return tag_count.load (std::memory_order_relaxed) + 1;
+    }
+
+    uint64_t Allocation_Tracker::get_violation_count ()
+    {
+        return violations.load (std::memory_order_relaxed);
+    }
+
+    void Allocation_Tracker::set_violation_handler (Violation_Handler handler)
+    {
+        violation_handler.store (handler, std::memory_order_release);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Allocation_Tracker::Scope::Scope(const char * tag) : previous(thread_state.tag)
+    {
+        #if defined(BASICS_ALLOCATION_TRACKING_ENABLED)
+            thread_state.tag = register_tag (tag);
+        #else
+            (void)tag;
+        #endif
+    }
+
+    Allocation_Tracker::Scope::~Scope()
+    {
+        thread_state.tag = previous;
+    }
+
+    Allocation_Tracker::Forbid::Forbid(bool active) : active(active)
+    {
+        if (active) thread_state.forbidden += 1;
+    }
+
+    Allocation_Tracker::Forbid::~Forbid()
+    {
+        if (active) thread_state.forbidden -= 1;
+    }
+
+}
+
+#if defined(BASICS_ALLOCATION_TRACKING_ENABLED)
+
+    // Sustitución de los operadores globales de reserva y liberación de memoria:
+
+    void * operator new (std::size_t size)
+    {
+        return basics::allocate_or_fail (size);
+    }
+
+    void * operator new[] (std::size_t size)
+    {
+        return basics::allocate_or_fail (size);
+    }
+
+    void * operator new (std::size_t size, const std::nothrow_t & ) noexcept
+    {
+        return basics::allocate (size);
+    }
+
+    void * operator new[] (std::size_t size, const std::nothrow_t & ) noexcept
+    {
+        return basics::allocate (size);
+    }
+
+    void operator delete (void * pointer) noexcept
+    {
+        basics::deallocate (pointer);
+    }
+
+    void operator delete[] (void * pointer) noexcept
+    {
+        basics::deallocate (pointer);
+    }
+
+    void operator delete (void * pointer, const std::nothrow_t & ) noexcept
+    {
+        basics::deallocate (pointer);
+    }
+
+    void operator delete[] (void * pointer, const std::nothrow_t & ) noexcept
+    {
+        basics::deallocate (pointer);
+    }
+
+#endif
@@ -13,6 +13,7 @@
 #include <basics/assert>
 #include <basics/Asset>
 #include <basics/Atlas>
+#include <basics/Trace>
 #include <cstring>
 
 #include <basics/Log>
@@ -25,17 +26,7 @@ namespace basics
 
     Atlas::Atlas(const string & path, Graphics_Context::Accessor & context)
     {
-        shared_ptr< Asset > slices_file = Asset::open (path);
-
-        if (slices_file->good ())
-        {
-            Buffer slices_data;
-
-            if (slices_file->read_all (slices_data))
-            {
-                parse (slices_data, path, context);
-            }
-        }
+        load (path, &context);
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -48,6 +39,29 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
+    Atlas::Atlas(const string & path)
+    {
+        load (path, nullptr);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas::upload (Graphics_Context::Accessor & context)
+    {
+        if (decoded_image)
+        {
+            texture = Texture_2D::create (0, context, decoded_image->color_buffer, decoded_image->options);
+
+            if (texture) context->add (texture);
+
+            decoded_image.reset ();
+        }
+
+        return good ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     Atlas::Slice * Atlas::add_slice (Id id, const Point2f & position, const Size2f & size)
     {
         if (slices.count (id) == 0)
@@ -69,8 +83,27 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
-    void Atlas::parse (Buffer & slices_data, const std::string & path, Graphics_Context::Accessor & context)
+    void Atlas::load (const string & path, Graphics_Context::Accessor * context)
     {
+        shared_ptr< Asset > slices_file = Asset::open (path);
+
+        if (slices_file->good ())
+        {
+            Buffer slices_data;
+
+            if (slices_file->read_all (slices_data))
+            {
+                parse (slices_data, path, context);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas::parse (Buffer & slices_data, const std::string & path, Graphics_Context::Accessor * context)
+    {
+        BASICS_TRACE_SCOPE("Atlas::parse");
+
         // Se pone un caracter nulo al final para que el parseador de rapidxml sepa dónde está el
         // final de los datos:
 
@@ -94,7 +127,7 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
-    void Atlas::parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context)
+    void Atlas::parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor * context)
     {
         // Se busca el atributo "name" del tag "img", el cual indica el nombre del archivo de la textura:
 
@@ -123,16 +156,28 @@ namespace basics
                 texture_path = path.substr (0, backslash + 1);
             }
 
-            // Se intenta cargar la textura:
-
-            texture = Texture_2D::create (0, context, texture_path + name_attribute->value ());
+            // Se intenta cargar la textura o, sin contexto gráfico, solo su imagen:
 
-            assert(texture);
+            if (context)
+            {
+                texture = Texture_2D::create (0, *context, texture_path + name_attribute->value ());
 
-            if (texture)
+                if (texture) (*context)->add (texture);
+            }
+            else
             {
-                context->add (texture);
+                decoded_image.reset (new Decoded_Image);
 
+                if (!Texture_2D::decode (texture_path + name_attribute->value (), decoded_image->color_buffer, decoded_image->options))
+                {
+                    decoded_image.reset ();
+                }
+            }
+
+            assert(texture || decoded_image);
+
+            if (texture || decoded_image)
+            {
                 // Se comprueba que las dimensiones de la textura coinciden con lo que indica el XML:
 
                 //xml_attribute<> * w_attribute = img_tag->first_attribute ("w");
@@ -0,0 +1,110 @@
+/*
+ * FRAME ARENA
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191700
+ */
+
+#include <basics/Frame_Arena>
+
+namespace basics
+{
+
+    Frame_Arena & frame_arena = Frame_Arena::get_instance ();
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Arena & Frame_Arena::get_instance ()
+    {
+        static Frame_Arena instance;
+        return instance;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Arena::Frame_Arena(size_t capacity)
+    :
+        current(0)
+    {
+        for (Buffer & buffer : buffers)
+        {
+            buffer.memory.reset (new char[capacity]);
+            buffer.capacity = capacity;
+            buffer.used     = 0;
+        }
+
+        stats.capacity        = capacity;
+        stats.used            = 0;
+        stats.high_water_mark = 0;
+        stats.overflows       = 0;
+        stats.frames          = 0;
+    }
+
+    Frame_Arena::~Frame_Arena()
+    {
+        reset ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Arena::begin_frame ()
+    {
+        if (buffers[current].used > stats.high_water_mark)
+        {
+            stats.high_water_mark = buffers[current].used;
+        }
+
+        current ^= 1;
+
+        clear (buffers[current]);
+
+        stats.frames++;
+    }
+
+    void Frame_Arena::reset ()
+    {
+        clear (buffers[0]);
+        clear (buffers[1]);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void * Frame_Arena::allocate_overflow (size_t size)
+    {
+        Buffer & buffer = buffers[current];
+
+        void * memory = ::operator new (size);
+
+        buffer.overflow.push_back (memory);
+        buffer.used += size;
+
+        stats.overflows++;
+
+        return memory;
+    }
+
+    void Frame_Arena::clear (Buffer & buffer)
+    {
+        for (void * memory : buffer.overflow) ::operator delete (memory);
+
+        buffer.overflow.clear ();
+
+        // Si el búfer se llenó, se amplía para que la próxima vez quepa en él lo mismo:
+
+        if (buffer.used > buffer.capacity)
+        {
+            buffer.capacity = buffer.used + buffer.used / 4;
+            buffer.memory.reset (new char[buffer.capacity]);
+
+            if (buffer.capacity > stats.capacity) stats.capacity = buffer.capacity;
+        }
+
+        buffer.used = 0;
+    }
+
+}
@@ -10,10 +10,116 @@
  * C1801161300
  */
 
+#include <algorithm>
 #include <basics/Graphics_Context>
 #include <basics/Graphics_Resource_Cache>
+#include <basics/Timer>
 
 namespace basics
 {
 
+    void Graphics_Context::initialize ()
+    {
+        pending_resources.clear ();
+
+        if (graphics_resource_cache)
+        {
+            for (auto iterator = graphics_resource_cache->begin (); iterator != graphics_resource_cache->end (); ++iterator)
+            {
+                std::shared_ptr< Graphics_Resource > resource = iterator->lock ();
+
+                if (resource && !resource->is_usable ())
+                {
+                    pending_resources.push_back (resource);
+                }
+            }
+
+            // Se ordenan de menor a mayor prioridad para poder extraerlos desde el final:
+
+            std::stable_sort
+            (
+                pending_resources.begin (),
+                pending_resources.end   (),
+                [] (const std::weak_ptr< Graphics_Resource > & a, const std::weak_ptr< Graphics_Resource > & b)
+                {
+                    std::shared_ptr< Graphics_Resource > resource_a = a.lock ();
+                    std::shared_ptr< Graphics_Resource > resource_b = b.lock ();
+
+                    return (resource_a ? resource_a->get_priority () : 0) < (resource_b ? resource_b->get_priority () : 0);
+                }
+            );
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Graphics_Context::restore_resources (float time_budget)
+    {
+        unsigned restored = 0;
+        Timer    timer;
+
+        while (!pending_resources.empty ())
+        {
+            // Se busca el recurso solicitado de mayor prioridad o, si ninguno lo está, el último:
+
+            Pending_Resource_List::iterator next = pending_resources.end () - 1;
+
+            for (auto iterator = pending_resources.rbegin (); iterator != pending_resources.rend (); ++iterator)
+            {
+                std::shared_ptr< Graphics_Resource > resource = iterator->lock ();
+
+                if (resource && resource->is_requested ())
+                {
+                    next = iterator.base () - 1;
+                    break;
+                }
+            }
+
+            std::shared_ptr< Graphics_Resource > resource = next->lock ();
+
+            pending_resources.erase (next);
+
+            // Puede que el recurso ya no exista o que se haya añadido de nuevo mientras tanto:
+
+            if (resource && !resource->is_usable ())
+            {
+                resources.push_back (resource);
+
+                resource->clear_request ();
+                resource->initialize    ();
+
+                ++restored;
+
+                if (timer.get_elapsed_seconds () >= time_budget) break;
+            }
+        }
+
+        return restored;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Graphics_Context::release_unused_resources ()
+    {
+        // Al eliminar la última referencia se destruye el recurso, lo cual libera su memoria de vídeo:
+
+        size_t count = resources.size ();
+
+        resources.erase
+        (
+            std::remove_if
+            (
+                resources.begin (),
+                resources.end   (),
+                [] (const std::shared_ptr< Graphics_Resource > & resource)
+                {
+                    return resource.use_count () == 1;
+                }
+            ),
+            resources.end ()
+        );
+
+        return unsigned(count - resources.size ());
+    }
+
 }
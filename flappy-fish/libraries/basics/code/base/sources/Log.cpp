@@ -0,0 +1,411 @@
+/*
+ * LOG
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191600
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <basics/Log>
+#include <basics/Timer>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        const char level_letters[] = { 'V', 'D', 'I', 'W', 'E', 'F' };
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::Writer::write (const char * chars)
+    {
+        if (!chars) chars = "(null)";
+
+        unsigned length = record.length;
+
+        while (*chars && length < max_message_length)
+        {
+            record.text[length++] = *chars++;
+        }
+
+        record.text[record.length = length] = 0;
+    }
+
+    void Log::Writer::write (char value)
+    {
+        if (record.length < max_message_length)
+        {
+            record.text[  record.length] = value;
+            record.text[++record.length] = 0;
+        }
+    }
+
+    void Log::Writer::write (long long value)
+    {
+        // Se trabaja con la magnitud sin signo para que el valor mínimo no se desborde al negarlo:
+
+        unsigned long long magnitude = value < 0 ? 0ull - static_cast< unsigned long long >(value) : value;
+
+        if (value < 0) write ('-');
+
+        write (magnitude);
+    }
+
+    void Log::Writer::write (unsigned long long value)
+    {
+        char   digits[24];
+        char * first = digits + sizeof(digits);
+
+        *--first = 0;
+
+        do
+        {
+            *--first = char('0' + value % 10);
+            value   /= 10;
+        }
+        while (value);
+
+        write (static_cast< const char * >(first));
+    }
+
+    void Log::Writer::write (double value)
+    {
+        char buffer[32];
+
+        snprintf (buffer, sizeof(buffer), "%g", value);
+
+        write (static_cast< const char * >(buffer));
+    }
+
+    void Log::Writer::write (const void * value)
+    {
+        char buffer[24];
+
+        snprintf (buffer, sizeof(buffer), "%p", value);
+
+        write (static_cast< const char * >(buffer));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::Stdout_Channel::write (const Record & record)
+    {
+        fprintf (stdout, "%c/%s: %s\n", level_letters[record.level], record.tag ? record.tag : "*", record.text);
+    }
+
+    void Log::Stdout_Channel::flush ()
+    {
+        fflush (stdout);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Log::Rotating_File_Channel::Rotating_File_Channel(const std::string & path, size_t max_size, unsigned max_files)
+    :
+        path            (path     ),
+        max_size        (max_size ),
+        max_files       (std::max (max_files, 2u)),
+        size            (0        ),
+        file            (fopen (path.c_str (), "a")),
+        failure_reported(false    )
+    {
+        if (file)
+        {
+            fseek (file, 0, SEEK_END);
+
+            long position = ftell (file);
+
+            size = position > 0 ? size_t(position) : 0;
+        }
+        else
+            report_open_failure ();
+    }
+
+    Log::Rotating_File_Channel::~Rotating_File_Channel()
+    {
+        if (file) fclose (file);
+    }
+
+    void Log::Rotating_File_Channel::write (const Record & record)
+    {
+        if (file)
+        {
+            int written = fprintf
+            (
+                file,
+                "%12.6f %c/%s: %s\n",
+                double(record.timestamp) / 1000000000.0,
+                level_letters[record.level],
+                record.tag ? record.tag : "*",
+                record.text
+            );
+
+            if (written > 0) size += size_t(written);
+
+            if (size >= max_size) rotate ();
+        }
+    }
+
+    void Log::Rotating_File_Channel::flush ()
+    {
+        if (file) fflush (file);
+    }
+
+    void Log::Rotating_File_Channel::rotate ()
+    {
+        fclose (file);
+
+        // Se desplazan los archivos anteriores (el más antiguo se sobrescribe) y el actual pasa a ser ".1":
+
+        for (unsigned index = max_files - 1; index > 1; --index)
+        {
+            std::string from = path + '.' + std::to_string (index - 1);
+            std::string to   = path + '.' + std::to_string (index);
+
+            ::rename (from.c_str (), to.c_str ());
+        }
+
+        ::rename (path.c_str (), (path + ".1").c_str ());
+
+        file = fopen (path.c_str (), "w");
+        size = 0;
+
+        if (!file) report_open_failure ();
+    }
+
+    void Log::Rotating_File_Channel::report_open_failure ()
+    {
+        // Sin el archivo el canal deja de escribir, así que se avisa (solo la primera vez):
+
+        if (!failure_reported)
+        {
+            std::string message = "log file " + path + " couldn't be opened (" + strerror (errno) + "), its messages are discarded";
+
+            report_error (message.c_str ());
+
+            failure_reported = true;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Log::Log()
+    :
+        v(*this, VERBOSE),
+        d(*this, DEBUG  ),
+        i(*this, INFO   ),
+        w(*this, WARNING),
+        e(*this, ERROR  ),
+        f(*this, FATAL  ),
+        submitted        (0),
+        dumped           (0),
+        reported_discards(0),
+        flusher_started  (false),
+        stopping         (false)
+    {
+        std::shared_ptr< Channel > channel = create_default_channel ();
+
+        if (channel) add_channel (channel);
+    }
+
+    Log::~Log()
+    {
+        if (flusher)
+        {
+            stopping = true;
+
+            flusher_condition.notify_all ();
+            flusher->join ();
+        }
+
+        dump_pending ();
+
+        std::lock_guard< std::mutex > lock(channels_mutex);
+
+        for (auto & channel : channels) channel->flush ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::add_channel (const std::shared_ptr< Channel > & channel)
+    {
+        std::lock_guard< std::mutex > lock(channels_mutex);
+
+        channels.push_back (channel);
+    }
+
+    void Log::remove_channels ()
+    {
+        std::lock_guard< std::mutex > lock(channels_mutex);
+
+        channels.clear ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::submit (Level level, Record & record)
+    {
+        record.timestamp = Timer::get_monotonic_time ();
+        record.tag       = nullptr;
+        record.level     = level;
+
+        if (!flusher_started.load (std::memory_order_acquire))
+        {
+            start_flusher ();
+        }
+
+        bool pushed = queue.push (record);
+
+        // Los errores no se descartan aunque la cola esté llena: se despierta al hilo de volcado y se
+        // espera a que deje sitio:
+
+        if (level >= ERROR)
+        {
+            while (!pushed && !stopping)
+            {
+                flusher_condition.notify_all ();
+
+                std::this_thread::yield ();
+
+                pushed = queue.push (record);
+            }
+        }
+
+        if (pushed)
+        {
+            submitted.fetch_add (1, std::memory_order_release);
+        }
+
+        // Los errores se escriben sin esperar a la siguiente vuelta del hilo de volcado, pero sin
+        // bloquear al hilo que los envía. Los fatales sí se esperan, porque la aplicación va a terminar:
+
+        if (level == FATAL)
+        {
+            flush ();
+        }
+        else
+        if (level >= ERROR)
+        {
+            flusher_condition.notify_all ();
+        }
+    }
+
+    void Log::start_flusher ()
+    {
+        std::lock_guard< std::mutex > lock(flusher_mutex);
+
+        if (!flusher_started.load (std::memory_order_relaxed))
+        {
+            flusher.reset (new std::thread(&Log::flusher_loop, this));
+
+            flusher_started.store (true, std::memory_order_release);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::flush ()
+    {
+        if (!flusher_started.load (std::memory_order_acquire) || stopping)
+        {
+            return;
+        }
+
+        uint64_t target = submitted.load (std::memory_order_acquire);
+
+        std::unique_lock< std::mutex > lock(flusher_mutex);
+
+        flusher_condition.notify_all ();
+
+        while (dumped.load (std::memory_order_acquire) < target && !stopping)
+        {
+            flusher_condition.wait_for (lock, std::chrono::milliseconds(10));
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::flusher_loop ()
+    {
+        bool pending_flush = false;
+
+        while (!stopping)
+        {
+            if (dump_pending ())
+            {
+                pending_flush = true;
+            }
+            else
+            {
+                // Cuando la cola se queda vacía se vuelcan los búferes de los canales, se avisa a los
+                // hilos que esperan en flush() y se duerme hasta que llegue más trabajo:
+
+                if (pending_flush)
+                {
+                    std::lock_guard< std::mutex > lock(channels_mutex);
+
+                    for (auto & channel : channels) channel->flush ();
+
+                    pending_flush = false;
+                }
+
+                std::unique_lock< std::mutex > lock(flusher_mutex);
+
+                flusher_condition.notify_all ();
+
+                if (!stopping && queue.empty ())
+                {
+                    flusher_condition.wait_for (lock, std::chrono::milliseconds(10));
+                }
+            }
+        }
+    }
+
+    bool Log::dump_pending ()
+    {
+        std::lock_guard< std::mutex > lock(channels_mutex);
+
+        size_t count = queue.drain
+        (
+            [this] (const Record & record)
+            {
+                for (auto & channel : channels) channel->write (record);
+            }
+        );
+
+        // Se informa de los mensajes que se han perdido porque la cola estaba llena:
+
+        size_t discards = queue.discarded_count ();
+
+        if (discards != reported_discards)
+        {
+            Record record;
+
+            Writer(record).write_all ("log queue full: ", discards - reported_discards, " messages discarded");
+
+            record.timestamp  = Timer::get_monotonic_time ();
+            record.tag        = nullptr;
+            record.level      = WARNING;
+            reported_discards = discards;
+
+            for (auto & channel : channels) channel->write (record);
+        }
+
+        dumped.fetch_add (count, std::memory_order_release);
+
+        return count > 0;
+    }
+
+}
@@ -0,0 +1,66 @@
+/*
+ * NULL GRAPHICS CONTEXT
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192000
+ */
+
+#include <basics/Null_Graphics_Context>
+#include <basics/Recording_Canvas>
+
+namespace basics
+{
+
+    bool Null_Graphics_Context::create (Window::Accessor & window, Graphics_Resource_Cache * cache)
+    {
+        if (window && window->is_available () && !window->has_graphics_context ())
+        {
+            std::shared_ptr< Graphics_Context > context(new Null_Graphics_Context(*window.operator -> (), cache));
+
+            if (window->set_graphics_context (context))
+            {
+                return context->make_current ();
+            }
+        }
+
+        return false;
+    }
+
+    Null_Graphics_Context::Null_Graphics_Context(Window & window, Graphics_Resource_Cache * cache)
+    :
+        Graphics_Context(window, cache),
+        canvas          (nullptr),
+        surface_width   (0),
+        surface_height  (0),
+        frame_count     (0),
+        available       (true)
+    {
+        reset_viewport ();
+    }
+
+    void Null_Graphics_Context::reset_viewport ()
+    {
+        surface_width  = window.get_width  ();
+        surface_height = window.get_height ();
+    }
+
+    bool Null_Graphics_Context::flush_and_display ()
+    {
+        if (available)
+        {
+            if (canvas) canvas->end_frame ();
+
+            frame_count++;
+
+            return true;
+        }
+
+        return false;
+    }
+
+}
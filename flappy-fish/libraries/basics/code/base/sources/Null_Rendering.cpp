@@ -0,0 +1,30 @@
+/*
+ * NULL RENDERING
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192000
+ */
+
+#include <basics/enable>
+#include <basics/Null_Rendering>
+#include <basics/Null_Texture_2D>
+#include <basics/Recording_Canvas>
+
+namespace basics
+{
+
+    template< >
+    bool enable< Null_Rendering > ()
+    {
+        Recording_Canvas::enable ();
+        Null_Texture_2D ::enable ();
+
+        return true;
+    }
+
+}
@@ -0,0 +1,24 @@
+/*
+ * NULL TEXTURE 2D
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192000
+ */
+
+#include <basics/Null_Texture_2D>
+#include <basics/Small_Object_Pool>
+
+namespace basics
+{
+
+    std::shared_ptr< Texture_2D > Null_Texture_2D::create (Id , Color_Buffer< Rgba8888 > & , const Options & options)
+    {
+        return make_pooled< Null_Texture_2D > (options.width, options.height);
+    }
+
+}
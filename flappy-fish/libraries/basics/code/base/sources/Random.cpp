@@ -0,0 +1,98 @@
+/*
+ * RANDOM
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192500
+ */
+
+#include <basics/Random>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Calcula el multiplicador y el incremento que avanzan delta pasos de golpe el generador
+        // congruencial state * multiplier + increment (Brown, "Random number generation with
+        // arbitrary strides", 1994):
+
+        void jump (uint64_t delta, uint64_t multiplier, uint64_t increment, uint64_t & jump_multiplier, uint64_t & jump_increment)
+        {
+            jump_multiplier = 1;
+            jump_increment  = 0;
+
+            while (delta > 0)
+            {
+                if (delta & 1)
+                {
+                    jump_multiplier *= multiplier;
+                    jump_increment   = jump_increment * multiplier + increment;
+                }
+
+                increment  *= multiplier + 1;
+                multiplier *= multiplier;
+                delta     >>= 1;
+            }
+        }
+
+    }
+
+    void Pcg32::advance (uint64_t delta)
+    {
+        uint64_t jump_multiplier, jump_increment;
+
+        jump (delta, multiplier, increment, jump_multiplier, jump_increment);
+
+        state = state * jump_multiplier + jump_increment;
+    }
+
+    void Pcg32::fill (uint32_t * values, size_t count)
+    {
+        static const unsigned lanes = 8;
+
+        if (count >= lanes * 4)
+        {
+            // La copia lane empieza lane números más adelante y todas avanzan lanes números por
+            // iteración, así que entre todas dan la secuencia en orden:
+
+            uint64_t lane_states[lanes];
+
+            for (unsigned lane = 0; lane < lanes; ++lane)
+            {
+                lane_states[lane] = state;
+
+                state = state * multiplier + increment;
+            }
+
+            uint64_t jump_multiplier, jump_increment;
+
+            jump (lanes, multiplier, increment, jump_multiplier, jump_increment);
+
+            const size_t blocks = count / lanes;
+
+            for (size_t block = 0; block < blocks; ++block, values += lanes)
+            {
+                for (unsigned lane = 0; lane < lanes; ++lane)
+                {
+                    values     [lane] = output (lane_states[lane]);
+                    lane_states[lane] = lane_states[lane] * jump_multiplier + jump_increment;
+                }
+            }
+
+            state  = lane_states[0];
+            count -= blocks * lanes;
+        }
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            values[index] = next ();
+        }
+    }
+
+}
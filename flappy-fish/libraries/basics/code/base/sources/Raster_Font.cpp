@@ -13,6 +13,7 @@
 #include <cstring>
 #include <rapidxml.hpp>
 #include <basics/Raster_Font>
+#include <basics/Trace>
 
 using namespace std;
 using namespace rapidxml;
@@ -44,6 +45,8 @@ namespace basics
         Graphics_Context::Accessor & context
     )
     {
+        BASICS_TRACE_SCOPE("Raster_Font::parse");
+
         // Se pone un caracter nulo al final para que el parseador de rapidxml sepa dónde está el
         // final de los datos:
 
@@ -0,0 +1,255 @@
+/*
+ * RECORDING CANVAS
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192000
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <basics/Null_Graphics_Context>
+#include <basics/Recording_Canvas>
+#include <basics/Small_Object_Pool>
+
+namespace basics
+{
+
+    Canvas * Recording_Canvas::create (Id id, Graphics_Context::Accessor & context, const Options & options)
+    {
+        std::shared_ptr< Recording_Canvas > canvas = make_pooled< Recording_Canvas > ();
+
+        context->add (id, canvas);
+
+        // Este factory solo se registra para los contextos con el id de Null_Graphics_Context:
+
+        static_cast< Null_Graphics_Context * >(context.operator -> ())->set_canvas (canvas.get ());
+
+        canvas->set_size (options.size);
+
+        return canvas.get ();
+    }
+
+    Recording_Canvas::Recording_Canvas()
+    :
+        frame_count (0),
+        last_texture(nullptr),
+        recording   (false),
+        drawing_text(false)
+    {
+        reset_counters ();
+    }
+
+    void Recording_Canvas::reset_counters ()
+    {
+        std::memset (&current,    0, sizeof(current   ));
+        std::memset (&last_frame, 0, sizeof(last_frame));
+        std::memset (&total,      0, sizeof(total     ));
+
+        frame_count = 0;
+    }
+
+    void Recording_Canvas::end_frame ()
+    {
+        total.clears          += current.clears;
+        total.points          += current.points;
+        total.segments        += current.segments;
+        total.triangles       += current.triangles;
+        total.rectangles      += current.rectangles;
+        total.sprites         += current.sprites;
+        total.texts           += current.texts;
+        total.glyphs          += current.glyphs;
+        total.state_changes   += current.state_changes;
+        total.texture_changes += current.texture_changes;
+
+        last_frame = current;
+
+        std::memset (&current, 0, sizeof(current));
+
+        // Como en un driver real, la primera textura de cada fotograma cuenta como un cambio:
+
+        last_texture = nullptr;
+
+        frame_count++;
+
+        record (END_FRAME, { });
+    }
+
+    void Recording_Canvas::record (Call_Type type, std::initializer_list< float > values, const void * resource, int handling)
+    {
+        // Las llamadas que hace draw_text() para dibujar los glifos ya están representadas por DRAW_TEXT:
+
+        if (recording && !drawing_text)
+        {
+            Call call;
+
+            call.type     = type;
+            call.handling = handling;
+            call.resource = resource;
+
+            std::memset (call.values, 0, sizeof(call.values));
+            std::copy   (values.begin (), values.begin () + std::min (values.size (), size_t(6)), call.values);
+
+            calls.push_back (call);
+        }
+    }
+
+    void Recording_Canvas::count_texture (const Texture_2D * texture)
+    {
+        if (drawing_text) current.glyphs++; else current.sprites++;
+
+        if (texture != last_texture)
+        {
+            current.texture_changes++;
+            last_texture = texture;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Recording_Canvas::reset_state ()
+    {
+        current.state_changes++;
+
+        record (RESET_STATE, { });
+    }
+
+    void Recording_Canvas::set_size (const Size2u & size)
+    {
+        current.state_changes++;
+
+        record (SET_SIZE, { float(size.width), float(size.height) });
+    }
+
+    void Recording_Canvas::set_clear_color (float r, float g, float b)
+    {
+        current.state_changes++;
+
+        record (SET_CLEAR_COLOR, { r, g, b });
+    }
+
+    void Recording_Canvas::set_color (float r, float g, float b)
+    {
+        current.state_changes++;
+
+        record (SET_COLOR, { r, g, b });
+    }
+
+    void Recording_Canvas::set_opacity (float opacity)
+    {
+        current.state_changes++;
+
+        record (SET_OPACITY, { opacity });
+    }
+
+    void Recording_Canvas::set_blending (Blending blending)
+    {
+        current.state_changes++;
+
+        record (SET_BLENDING, { }, nullptr, blending);
+    }
+
+    void Recording_Canvas::set_transform (const Transformation2f & transform)
+    {
+        current.state_changes++;
+
+        const auto & matrix = transform.matrix;
+
+        record (SET_TRANSFORM, { matrix[0][0], matrix[0][1], matrix[0][2], matrix[1][0], matrix[1][1], matrix[1][2] });
+    }
+
+    void Recording_Canvas::apply_transform (const Transformation2f & transform)
+    {
+        current.state_changes++;
+
+        const auto & matrix = transform.matrix;
+
+        record (APPLY_TRANSFORM, { matrix[0][0], matrix[0][1], matrix[0][2], matrix[1][0], matrix[1][1], matrix[1][2] });
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Recording_Canvas::clear ()
+    {
+        current.clears++;
+
+        record (CLEAR, { });
+    }
+
+    void Recording_Canvas::draw_point (const Point2f & position)
+    {
+        current.points++;
+
+        record (DRAW_POINT, { position[0], position[1] });
+    }
+
+    void Recording_Canvas::draw_segment (const Point2f & a, const Point2f & b)
+    {
+        current.segments++;
+
+        record (DRAW_SEGMENT, { a[0], a[1], b[0], b[1] });
+    }
+
+    void Recording_Canvas::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        current.triangles++;
+
+        record (DRAW_TRIANGLE, { a[0], a[1], b[0], b[1], c[0], c[1] });
+    }
+
+    void Recording_Canvas::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        current.triangles++;
+
+        record (FILL_TRIANGLE, { a[0], a[1], b[0], b[1], c[0], c[1] });
+    }
+
+    void Recording_Canvas::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        current.rectangles++;
+
+        record (DRAW_RECTANGLE, { bottom_left[0], bottom_left[1], size.width, size.height });
+    }
+
+    void Recording_Canvas::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        current.rectangles++;
+
+        record (FILL_RECTANGLE, { bottom_left[0], bottom_left[1], size.width, size.height });
+    }
+
+    void Recording_Canvas::fill_rectangle (const Point2f & where, const Size2f & size, const Texture_2D * texture, int handling)
+    {
+        count_texture (texture);
+
+        record (FILL_TEXTURED_RECTANGLE, { where[0], where[1], size.width, size.height }, texture, handling);
+    }
+
+    void Recording_Canvas::fill_rectangle (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling)
+    {
+        count_texture (slice && slice->atlas ? slice->atlas->get_texture ().get () : nullptr);
+
+        record (FILL_SLICE, { where[0], where[1], size.width, size.height }, slice, handling);
+    }
+
+    void Recording_Canvas::draw_text (const Point2f & where, const Text_Layout & text_layout, int handling)
+    {
+        current.texts++;
+
+        record (DRAW_TEXT, { where[0], where[1] }, &text_layout, handling);
+
+        // Canvas::draw_text() dibuja cada glifo con fill_rectangle(), que aquí se cuenta como glifo y
+        // no como sprite (los cambios de estado y de textura sí se cuentan, porque también los hace):
+
+        drawing_text = true;
+
+        Canvas::draw_text (where, text_layout, handling);
+
+        drawing_text = false;
+    }
+
+}
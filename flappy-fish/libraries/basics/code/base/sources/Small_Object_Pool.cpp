@@ -0,0 +1,332 @@
+/*
+ * SMALL OBJECT POOL
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191730
+ */
+
+#include <atomic>
+#include <mutex>
+#include <pthread.h>
+#include <basics/Small_Object_Pool>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        struct Block
+        {
+            Block * next;
+        };
+
+        const size_t class_sizes[Small_Object_Pool::class_count] =
+        {
+             16,  32,  48,  64,  80,  96, 112, 128,
+            160, 192, 224, 256, 320, 384, 448, 512
+        };
+
+        // Clase de tamaño que corresponde a cada tamaño redondeado a múltiplos de 16 ((size - 1) / 16):
+
+        const unsigned char size_classes[Small_Object_Pool::max_size / Small_Object_Pool::granularity] =
+        {
+             0,  1,  2,  3,  4,  5,  6,  7,  8,  8,  9,  9, 10, 10, 11, 11,
+            12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15
+        };
+
+        const size_t   chunk_size = 64 * 1024;          ///< Bytes que se reservan de una vez para una clase
+        const unsigned batch_size = 32;                 ///< Bloques que se pasan de una vez entre el almacén y las cachés
+        const unsigned max_cached = 64;                 ///< Bloques libres de cada clase que puede acumular una caché
+
+        // Almacén compartido de bloques libres de cada clase (se inicializa estáticamente):
+
+        struct Central_List
+        {
+            std::mutex mutex;
+            Block    * free            = nullptr;
+            size_t     free_blocks     = 0;
+            size_t     reserved_blocks = 0;
+        };
+
+        Central_List central_lists[Small_Object_Pool::class_count];
+
+        // Caché de cada hilo. Solo la modifica el hilo que la usa; los contadores son atómicos para
+        // que get_stats() los pueda leer desde otro hilo. Las cachés de los hilos que terminan se
+        // vacían y se reutilizan en los hilos nuevos:
+
+        struct Thread_Cache
+        {
+            Block                 * heads[Small_Object_Pool::class_count];
+            std::atomic< size_t >   counts[Small_Object_Pool::class_count];
+            std::atomic< bool >     in_use;
+            Thread_Cache          * next;
+        };
+
+        std::atomic< Thread_Cache * > thread_caches(nullptr);
+        std::atomic< uint64_t       > large_allocations(0);
+
+        thread_local Thread_Cache   * thread_cache = nullptr;
+
+        // -----------------------------------------------------------------------------------------
+
+        void move_to_central (Thread_Cache & cache, unsigned index, size_t count)
+        {
+            Block * first = cache.heads[index];
+            Block * last  = first;
+
+            if (!first || count == 0) return;
+
+            size_t moved = 1;
+
+            while (moved < count && last->next)
+            {
+                last = last->next;
+                moved++;
+            }
+
+            cache.heads[index] = last->next;
+            cache.counts[index].store (cache.counts[index].load (std::memory_order_relaxed) - moved, std::memory_order_relaxed);
+
+            Central_List & central = central_lists[index];
+
+            std::lock_guard< std::mutex > lock(central.mutex);
+
+            last->next           = central.free;
+            central.free         = first;
+            central.free_blocks += moved;
+        }
+
+        void flush (Thread_Cache & cache)
+        {
+            for (unsigned index = 0; index < Small_Object_Pool::class_count; ++index)
+            {
+                move_to_central (cache, index, cache.counts[index].load (std::memory_order_relaxed));
+            }
+        }
+
+        void release_thread_cache (void * cache)
+        {
+            flush (*static_cast< Thread_Cache * >(cache));
+
+            static_cast< Thread_Cache * >(cache)->in_use.store (false, std::memory_order_release);
+
+            thread_cache = nullptr;
+        }
+
+        pthread_key_t get_thread_cache_key ()
+        {
+            // La función que se asocia a la clave vacía la caché cuando el hilo termina:
+
+            static struct Key
+            {
+                pthread_key_t key;
+
+                Key()
+                {
+                    pthread_key_create (&key, release_thread_cache);
+                }
+            }
+            key;
+
+            return key.key;
+        }
+
+        Thread_Cache & get_thread_cache ()
+        {
+            if (thread_cache) return *thread_cache;
+
+            // Se reutiliza la caché de un hilo que haya terminado o se crea una nueva:
+
+            Thread_Cache * cache = thread_caches.load (std::memory_order_acquire);
+
+            for ( ; cache; cache = cache->next)
+            {
+                bool in_use = false;
+
+                if (cache->in_use.compare_exchange_strong (in_use, true, std::memory_order_acq_rel)) break;
+            }
+
+            if (!cache)
+            {
+                cache = new Thread_Cache;
+
+                for (unsigned index = 0; index < Small_Object_Pool::class_count; ++index)
+                {
+                    cache->heads [index] = nullptr;
+                    cache->counts[index].store (0, std::memory_order_relaxed);
+                }
+
+                cache->in_use.store (true, std::memory_order_relaxed);
+                cache->next = thread_caches.load (std::memory_order_relaxed);
+
+                while (!thread_caches.compare_exchange_weak (cache->next, cache, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            pthread_setspecific (get_thread_cache_key (), cache);
+
+            return *(thread_cache = cache);
+        }
+
+        void refill (Thread_Cache & cache, unsigned index)
+        {
+            Central_List & central    = central_lists[index];
+            const size_t   block_size = class_sizes[index];
+
+            std::lock_guard< std::mutex > lock(central.mutex);
+
+            if (central.free_blocks == 0)
+            {
+                // Se reserva un trozo nuevo alineado a la granularidad y se divide en bloques:
+
+                char * memory = static_cast< char * >(::operator new (chunk_size + Small_Object_Pool::granularity));
+                char * chunk  = reinterpret_cast< char * >
+                (
+                    (reinterpret_cast< uintptr_t >(memory) + Small_Object_Pool::granularity - 1) & ~uintptr_t(Small_Object_Pool::granularity - 1)
+                );
+
+                size_t count = chunk_size / block_size;
+
+                for (size_t block = count; block-- > 0; )
+                {
+                    Block * free = reinterpret_cast< Block * >(chunk + block * block_size);
+
+                    free->next   = central.free;
+                    central.free = free;
+                }
+
+                central.free_blocks     += count;
+                central.reserved_blocks += count;
+            }
+
+            size_t moved = 0;
+
+            while (moved < batch_size && central.free)
+            {
+                Block * block = central.free;
+
+                central.free       = block->next;
+                block->next        = cache.heads[index];
+                cache.heads[index] = block;
+
+                moved++;
+            }
+
+            central.free_blocks -= moved;
+
+            cache.counts[index].store (cache.counts[index].load (std::memory_order_relaxed) + moved, std::memory_order_relaxed);
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void * Small_Object_Pool::allocate (size_t size)
+    {
+        if (size > max_size)
+        {
+            large_allocations.fetch_add (1, std::memory_order_relaxed);
+
+            return ::operator new (size);
+        }
+
+        const unsigned index = size_classes[size > 0 ? (size - 1) / granularity : 0];
+
+        Thread_Cache & cache = get_thread_cache ();
+
+        if (!cache.heads[index]) refill (cache, index);
+
+        Block * block = cache.heads[index];
+
+        cache.heads[index] = block->next;
+
+        cache.counts[index].store (cache.counts[index].load (std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+        return block;
+    }
+
+    void Small_Object_Pool::deallocate (void * pointer, size_t size)
+    {
+        if (!pointer) return;
+
+        if (size > max_size)
+        {
+            ::operator delete (pointer);
+            return;
+        }
+
+        const unsigned index = size_classes[size > 0 ? (size - 1) / granularity : 0];
+
+        Thread_Cache & cache = get_thread_cache ();
+        Block        * block = static_cast< Block * >(pointer);
+
+        block->next        = cache.heads[index];
+        cache.heads[index] = block;
+
+        size_t count = cache.counts[index].load (std::memory_order_relaxed) + 1;
+
+        cache.counts[index].store (count, std::memory_order_relaxed);
+
+        // Si la caché acumula demasiados bloques libres devuelve una parte al almacén para que los
+        // puedan usar otros hilos:
+
+        if (count > max_cached)
+        {
+            move_to_central (cache, index, batch_size);
+        }
+    }
+
+    void Small_Object_Pool::flush_thread_cache ()
+    {
+        if (thread_cache) flush (*thread_cache);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Small_Object_Pool::Stats Small_Object_Pool::get_stats ()
+    {
+        Stats stats;
+
+        stats.reserved_bytes    = 0;
+        stats.used_bytes        = 0;
+        stats.large_allocations = large_allocations.load (std::memory_order_relaxed);
+
+        for (unsigned index = 0; index < class_count; ++index)
+        {
+            Class_Stats & class_stats = stats.classes[index];
+
+            class_stats.block_size    = class_sizes[index];
+            class_stats.cached_blocks = 0;
+
+            {
+                std::lock_guard< std::mutex > lock(central_lists[index].mutex);
+
+                class_stats.reserved_blocks = central_lists[index].reserved_blocks;
+                class_stats.free_blocks     = central_lists[index].free_blocks;
+            }
+
+            for (Thread_Cache * cache = thread_caches.load (std::memory_order_acquire); cache; cache = cache->next)
+            {
+                class_stats.cached_blocks += cache->counts[index].load (std::memory_order_relaxed);
+            }
+
+            size_t free_blocks = class_stats.free_blocks + class_stats.cached_blocks;
+
+            class_stats.used_blocks = class_stats.reserved_blocks > free_blocks ? class_stats.reserved_blocks - free_blocks : 0;
+
+            stats.reserved_bytes += class_stats.reserved_blocks * class_stats.block_size;
+            stats.used_bytes     += class_stats.used_blocks     * class_stats.block_size;
+        }
+
+        stats.occupancy     = stats.reserved_bytes ? float(stats.used_bytes) / float(stats.reserved_bytes) : 1.f;
+        stats.fragmentation = 1.f - stats.occupancy;
+
+        return stats;
+    }
+
+}
@@ -15,21 +15,24 @@
 namespace basics
 {
 
-    Text_Layout::Text_Layout(const Raster_Font & font, const std::wstring & text)
+    Text_Layout::Text_Layout(const Raster_Font & font, const wchar_t * text, size_t length, const Glyph_List::allocator_type & allocator)
     :
+        glyphs(allocator),
         width (0.f),
         height(0.f)
     {
         Raster_Font::Metrics metrics = font.get_metrics ();
 
-        glyphs.reserve (text.length ());
+        glyphs.reserve (length);
 
         float current_x  = 0;
         float current_y  = -metrics.line_height;
         float line_width = 0;
 
-        for (auto & c : text)
+        for (const wchar_t * end = text + length; text < end; ++text)
         {
+            const wchar_t c = *text;
+
             if (c == L'\n')
             {
                 if (current_x > width) width = current_x;
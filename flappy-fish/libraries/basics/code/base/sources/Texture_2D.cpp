@@ -10,6 +10,7 @@
  * C1801161300
  */
 
+#include <basics/assert>
 #include <basics/png_decode>
 #include <basics/Texture_2D>
 
@@ -28,7 +29,13 @@ namespace basics
         {
             if (texture_2d_specialization_ids[index] == context_id)
             {
-                return texture_2d_specialization_factories[index] (id, color_buffer, options);
+                std::shared_ptr< Texture_2D > texture = texture_2d_specialization_factories[index] (id, color_buffer, options);
+
+                // Los canvas confían en esta etiqueta para convertir la textura sin RTTI:
+
+                assert(!texture || texture->get_backend () == context_id);
+
+                return texture;
             }
         }
 
@@ -36,6 +43,19 @@ namespace basics
     }
 
     std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options)
+    {
+        Color_Buffer< Rgba8888 > color_buffer;
+        Texture_2D::Options      decoded_options;
+
+        if (decode (asset_path, color_buffer, decoded_options))
+        {
+            return Texture_2D::create (id, context, color_buffer, decoded_options);
+        }
+
+        return std::shared_ptr< Texture_2D >();
+    }
+
+    bool Texture_2D::decode (const std::string & asset_path, Color_Buffer< Rgba8888 > & color_buffer, Options & options)
     {
         std::shared_ptr< Asset > asset = Asset::open (asset_path);
 
@@ -45,17 +65,11 @@ namespace basics
 
             if (asset->read_all (data))
             {
-                Color_Buffer< Rgba8888 > color_buffer;
-                Texture_2D::Options      options;
-
-                if (png_decode (data, color_buffer, options.width, options.height))
-                {
-                    return Texture_2D::create (id, context, color_buffer, options);
-                }
+                return png_decode (data, color_buffer, options.width, options.height);
             }
         }
 
-        return std::shared_ptr< Texture_2D >();
+        return false;
     }
 
 }
@@ -0,0 +1,249 @@
+/*
+ * TRACE
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191530
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <pthread.h>
+#include <basics/Trace>
+
+namespace basics
+{
+
+    std::atomic< bool > Trace::recording(true);
+
+    thread_local Trace::Thread_Buffer * Trace::thread_buffer = nullptr;
+
+    namespace
+    {
+
+        // Lista de los búferes de todos los hilos que han grabado alguna marca. Los búferes no se
+        // liberan para que las marcas de los hilos que ya han terminado se puedan exportar, pero los
+        // de los hilos que terminan se reutilizan en los hilos nuevos:
+
+        std::atomic< Trace::Thread_Buffer * > thread_buffers(nullptr);
+        std::atomic< unsigned >               thread_count  (0);
+
+        // Exportación en curso:
+
+        FILE * export_file  = nullptr;
+        bool   export_first = true;
+
+        void write_string (FILE * file, const char * string)
+        {
+            fputc ('"', file);
+
+            for ( ; *string; ++string)
+            {
+                if (*string == '"' || *string == '\\') fputc ('\\', file);
+
+                fputc (*string, file);
+            }
+
+            fputc ('"', file);
+        }
+
+        const char * get_separator ()
+        {
+            const char * separator = export_first ? "\n" : ",\n";
+
+            export_first = false;
+
+            return separator;
+        }
+
+        void write_records (Trace::Thread_Buffer & buffer)
+        {
+            buffer.records.drain
+            (
+                [&] (const Trace::Record & record)
+                {
+                    fprintf (export_file, "%s{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":", get_separator (), record.type, buffer.thread_id, record.timestamp / 1000.0);
+                    write_string (export_file, record.name);
+
+                    switch (record.type)
+                    {
+                        case Trace::COMPLETE: fprintf (export_file, ",\"dur\":%.3f}", record.value / 1000.0); break;
+                        case Trace::INSTANT:  fputs   (",\"s\":\"t\"}", export_file); break;
+                        case Trace::COUNTER:
+                        {
+                            fputs   (",\"args\":{", export_file);
+                            write_string (export_file, record.name);
+                            fprintf (export_file, ":%lld}}", (long long)record.value);
+                            break;
+                        }
+                    }
+                }
+            );
+        }
+
+        pthread_key_t get_thread_buffer_key (void (* release) (void * ))
+        {
+            // La función que se asocia a la clave libera el búfer cuando el hilo termina:
+
+            static struct Key
+            {
+                pthread_key_t key;
+
+                Key(void (* release) (void * ))
+                {
+                    pthread_key_create (&key, release);
+                }
+            }
+            key(release);
+
+            return key.key;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Trace::Thread_Buffer * Trace::acquire_thread_buffer ()
+    {
+        // Se reutiliza el búfer de un hilo que haya terminado o se crea uno nuevo:
+
+        Thread_Buffer * buffer = thread_buffers.load (std::memory_order_acquire);
+
+        for ( ; buffer; buffer = buffer->next)
+        {
+            bool in_use = false;
+
+            if (buffer->in_use.compare_exchange_strong (in_use, true, std::memory_order_acq_rel)) break;
+        }
+
+        if (!buffer)
+        {
+            // new no respeta en C++11 la alineación de la cola (alignas), por lo que se reserva a mano:
+
+            void * memory = nullptr;
+
+            if (posix_memalign (&memory, alignof(Thread_Buffer), sizeof(Thread_Buffer)) != 0) throw std::bad_alloc();
+
+            buffer = new (memory) Thread_Buffer;
+
+            buffer->thread_id         = ++thread_count;
+            buffer->reported_discards = 0;
+            buffer->thread_name.store (nullptr, std::memory_order_relaxed);
+            buffer->in_use     .store (true,    std::memory_order_relaxed);
+            buffer->next              = thread_buffers.load (std::memory_order_relaxed);
+
+            while (!thread_buffers.compare_exchange_weak (buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        pthread_setspecific (get_thread_buffer_key (release_thread_buffer), buffer);
+
+        return buffer;
+    }
+
+    void Trace::release_thread_buffer (void * buffer)
+    {
+        static_cast< Thread_Buffer * >(buffer)->in_use.store (false, std::memory_order_release);
+
+        thread_buffer = nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Trace::begin_export (const std::string & path)
+    {
+        if (export_file) return false;
+
+        export_file = fopen (path.c_str (), "w");
+
+        if (!export_file) return false;
+
+        export_first = true;
+
+        fputs ("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", export_file);
+
+        return true;
+    }
+
+    void Trace::export_pending ()
+    {
+        if (!export_file) return;
+
+        for (Thread_Buffer * buffer = thread_buffers.load (std::memory_order_acquire); buffer; buffer = buffer->next)
+        {
+            write_records (*buffer);
+        }
+    }
+
+    bool Trace::end_export ()
+    {
+        if (!export_file) return false;
+
+        export_pending ();
+
+        int64_t now = Timer::get_monotonic_time ();
+
+        for (Thread_Buffer * buffer = thread_buffers.load (std::memory_order_acquire); buffer; buffer = buffer->next)
+        {
+            const char * thread_name = buffer->thread_name.load (std::memory_order_relaxed);
+
+            if (thread_name)
+            {
+                fprintf (export_file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", get_separator (), buffer->thread_id);
+                write_string (export_file, thread_name);
+                fputs ("}}", export_file);
+            }
+
+            // Las marcas que se han perdido porque el búfer estaba lleno se indican con un suceso:
+
+            size_t discards = buffer->records.discarded_count ();
+
+            if (discards != buffer->reported_discards)
+            {
+                fprintf
+                (
+                    export_file,
+                    "%s{\"ph\":\"i\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":\"trace records discarded\",\"s\":\"t\",\"args\":{\"count\":%zu}}",
+                    get_separator (),
+                    buffer->thread_id,
+                    now / 1000.0,
+                    discards - buffer->reported_discards
+                );
+
+                buffer->reported_discards = discards;
+            }
+        }
+
+        fputs ("\n]}\n", export_file);
+
+        bool success = ferror (export_file) == 0;
+
+        fclose (export_file);
+
+        export_file = nullptr;
+
+        return success;
+    }
+
+    bool Trace::is_exporting ()
+    {
+        return export_file != nullptr;
+    }
+
+    size_t Trace::get_discarded_count ()
+    {
+        size_t discards = 0;
+
+        for (Thread_Buffer * buffer = thread_buffers.load (std::memory_order_acquire); buffer; buffer = buffer->next)
+        {
+            discards += buffer->records.discarded_count ();
+        }
+
+        return discards;
+    }
+
+}
@@ -0,0 +1,211 @@
+/*
+ * WORK STEALING POOL
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192400
+ */
+
+#include <algorithm>
+#include <basics/Work_Stealing_Pool>
+
+namespace basics
+{
+
+    Work_Stealing_Pool::Work_Stealing_Pool(unsigned thread_count)
+    :
+        generation     (0),
+        busy_workers   (0),
+        stopping       (false),
+        invoker        (nullptr),
+        body           (nullptr),
+        pending_ranges (0)
+    {
+        if (thread_count == 0) thread_count = std::max (std::thread::hardware_concurrency (), 1u);
+
+        for (unsigned index = 0; index < thread_count; ++index)
+        {
+            queues.emplace_back (new Worker_Queue);
+        }
+
+        // El trabajador 0 es el hilo que llama a parallel_for():
+
+        for (unsigned index = 1; index < thread_count; ++index)
+        {
+            workers.emplace_back (&Work_Stealing_Pool::worker_loop, this, index);
+        }
+    }
+
+    Work_Stealing_Pool::~Work_Stealing_Pool()
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            stopping = true;
+        }
+
+        work_ready.notify_all ();
+
+        for (std::thread & worker : workers) worker.join ();
+    }
+
+    uint64_t Work_Stealing_Pool::get_steal_count () const
+    {
+        uint64_t steals = 0;
+
+        for (const auto & queue : queues)
+        {
+            std::lock_guard< std::mutex > lock(queue->mutex);
+
+            steals += queue->steals;
+        }
+
+        return steals;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Work_Stealing_Pool::run (size_t count, size_t grain, Invoker new_invoker, void * new_body)
+    {
+        if (count == 0) return;
+
+        if (grain == 0) grain = 1;
+
+        // Cada trabajador recibe una parte contigua de los trozos:
+
+        const size_t   range_count  = (count + grain - 1) / grain;
+        const unsigned thread_count = get_thread_count ();
+
+        for (unsigned worker = 0; worker < thread_count; ++worker)
+        {
+            size_t first = range_count *  worker      / thread_count;
+            size_t last  = range_count * (worker + 1) / thread_count;
+
+            std::lock_guard< std::mutex > lock(queues[worker]->mutex);
+
+            for (size_t range = first; range < last; ++range)
+            {
+                queues[worker]->ranges.push_back (Range{ range * grain, std::min ((range + 1) * grain, count) });
+            }
+        }
+
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            invoker        = new_invoker;
+            body           = new_body;
+            busy_workers   = unsigned(workers.size ());
+            pending_ranges = range_count;
+
+            ++generation;
+        }
+
+        work_ready.notify_all ();
+
+        work (0);
+
+        // Se espera a que los demás hilos terminen sus trozos (y dejen de usar body):
+
+        std::unique_lock< std::mutex > lock(mutex);
+
+        work_done.wait (lock, [this] { return busy_workers == 0; });
+
+        invoker = nullptr;
+        body    = nullptr;
+    }
+
+    void Work_Stealing_Pool::work (unsigned worker)
+    {
+        Range range;
+
+        while (pending_ranges.load (std::memory_order_acquire) > 0 && take (worker, range))
+        {
+            invoker (body, range.begin, range.end, worker);
+
+            pending_ranges.fetch_sub (1, std::memory_order_acq_rel);
+        }
+    }
+
+    bool Work_Stealing_Pool::take (unsigned worker, Range & range)
+    {
+        // Primero se toma el último trozo de la cola propia (el más reciente)...
+
+        {
+            Worker_Queue & own = *queues[worker];
+
+            std::lock_guard< std::mutex > lock(own.mutex);
+
+            if (!own.ranges.empty ())
+            {
+                range = own.ranges.back ();
+
+                own.ranges.pop_back ();
+
+                return true;
+            }
+        }
+
+        // ...y si no queda ninguno se roba el primero de la cola de otro trabajador, que es el que
+        // más tardaría en llegar a él:
+
+        const unsigned thread_count = get_thread_count ();
+
+        for (unsigned offset = 1; offset < thread_count; ++offset)
+        {
+            Worker_Queue & victim = *queues[(worker + offset) % thread_count];
+
+            std::unique_lock< std::mutex > lock(victim.mutex);
+
+            if (!victim.ranges.empty ())
+            {
+                range = victim.ranges.front ();
+
+                victim.ranges.pop_front ();
+
+                lock.unlock ();
+
+                std::lock_guard< std::mutex > own_lock(queues[worker]->mutex);
+
+                queues[worker]->steals++;
+
+                return true;
+            }
+        }
+
+        // No se crean trozos nuevos mientras se trabaja, así que si todas las colas están vacías
+        // este trabajador ha terminado:
+
+        return false;
+    }
+
+    void Work_Stealing_Pool::worker_loop (unsigned worker)
+    {
+        uint64_t seen_generation = 0;
+
+        for (;;)
+        {
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                work_ready.wait (lock, [&] { return stopping || generation != seen_generation; });
+
+                if (stopping) return;
+
+                seen_generation = generation;
+            }
+
+            work (worker);
+
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                if (--busy_workers == 0) work_done.notify_all ();
+            }
+        }
+    }
+
+}
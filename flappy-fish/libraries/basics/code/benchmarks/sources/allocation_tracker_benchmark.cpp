@@ -0,0 +1,229 @@
+/*
+ * ALLOCATION TRACKER BENCHMARK
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191630
+ */
+
+// Comprueba en el host el seguimiento de reservas de memoria y mide su coste:
+//
+//  - Coste de new/delete con el seguimiento activo comparado con malloc/free.
+//  - Fotogramas simulados dentro de un ámbito Forbid: uno que no reserva memoria y otro que hace lo
+//    mismo que un fotograma típico de la escena (to_wstring, vectores de glifos y shared_ptr nuevos),
+//    que debe contar infracciones.
+//  - Reparto de las reservas entre etiquetas.
+//
+// Este programa se compila con BASICS_ALLOCATION_TRACKING_ENABLED definida. Termina con un código de
+// error si los contadores no son los esperados.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include <basics/Allocation_Tracker>
+
+using namespace basics;
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+
+    typedef steady_clock Clock;
+
+    unsigned handler_calls = 0;
+
+    // Evita que el compilador elimine las reservas cuyo resultado no se usa:
+
+    void * volatile sink;
+
+    void count_violation (size_t , const char * )
+    {
+        ++handler_calls;
+    }
+
+    struct Glyph
+    {
+        float x, y, width, height;
+    };
+
+    // Fotograma que reutiliza la memoria reservada previamente:
+
+    void steady_frame (vector< Glyph > & glyphs, unsigned score)
+    {
+        glyphs.clear ();
+
+        for (unsigned digit = score; digit; digit /= 10)
+        {
+            glyphs.push_back ({ float(digit % 10), 0.f, 16.f, 24.f });
+        }
+    }
+
+    // Fotograma que reserva memoria como lo hace hoy la escena de juego:
+
+    void allocating_frame (unsigned score)
+    {
+        wstring           text   = L"Score: " + to_wstring (score);
+        vector< Glyph >   glyphs;
+        shared_ptr< int > value  = make_shared< int > (int(score));
+
+        for (wchar_t character : text)
+        {
+            glyphs.push_back ({ float(character), 0.f, 16.f, 24.f });
+        }
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    const unsigned iterations = number_of_arguments > 1 ? unsigned(atoi (arguments[1])) : 1000000;
+
+    int failures = 0;
+
+    // Coste de las reservas:
+
+    {
+        vector< void * > blocks(64);
+
+        Clock::time_point start = Clock::now ();
+
+        for (unsigned iteration = 0; iteration < iterations; ++iteration)
+        {
+            void *& block = blocks[iteration & 63];
+
+            free (block);
+
+            block = malloc (32 + (iteration & 255));
+
+            sink  = block;
+        }
+
+        double malloc_time = duration< double, nano >(Clock::now () - start).count () / iterations;
+
+        for (void * block : blocks) free (block);
+
+        vector< char * > arrays(64, nullptr);
+
+        start = Clock::now ();
+
+        for (unsigned iteration = 0; iteration < iterations; ++iteration)
+        {
+            char *& array = arrays[iteration & 63];
+
+            delete [] array;
+
+            array = new char[32 + (iteration & 255)];
+
+            sink  = array;
+        }
+
+        double new_time = duration< double, nano >(Clock::now () - start).count () / iterations;
+
+        for (char * array : arrays) delete [] array;
+
+        printf ("malloc/free: %7.1f ns    tracked new/delete: %7.1f ns\n\n", malloc_time, new_time);
+    }
+
+    Allocation_Tracker::set_violation_handler (count_violation);
+
+    // Fotogramas sin reservas:
+
+    {
+        vector< Glyph > glyphs;
+
+        glyphs.reserve (16);
+
+        uint64_t violations = Allocation_Tracker::get_violation_count ();
+
+        for (unsigned frame = 0; frame < 1000; ++frame)
+        {
+            Allocation_Tracker::Forbid forbid;
+
+            steady_frame (glyphs, frame * 7);
+        }
+
+        uint64_t count = Allocation_Tracker::get_violation_count () - violations;
+
+        printf ("steady frames:     %6llu allocations\n", (unsigned long long)count);
+
+        if (count != 0) ++failures;
+    }
+
+    // Fotogramas con reservas:
+
+    {
+        uint64_t                     violations = Allocation_Tracker::get_violation_count ();
+        Allocation_Tracker::Counters before     = Allocation_Tracker::get_thread_counters ();
+
+        for (unsigned frame = 0; frame < 1000; ++frame)
+        {
+            BASICS_ALLOCATION_SCOPE("frame");
+
+            Allocation_Tracker::Forbid forbid;
+
+            allocating_frame (frame * 7);
+        }
+
+        Allocation_Tracker::Counters after = Allocation_Tracker::get_thread_counters ();
+
+        uint64_t count = Allocation_Tracker::get_violation_count () - violations;
+
+        printf
+        (
+            "allocating frames: %6llu allocations (%.1f per frame, %.1f bytes per frame), %u reported\n",
+            (unsigned long long)count,
+            double(after.allocations - before.allocations) / 1000.0,
+            double(after.bytes       - before.bytes      ) / 1000.0,
+            handler_calls
+        );
+
+        if (count == 0 || count != after.allocations - before.allocations || handler_calls != count) ++failures;
+    }
+
+    // Reparto por etiquetas:
+
+    {
+        BASICS_ALLOCATION_SCOPE("textures");
+
+        unique_ptr< char [] > texture(new char[512 * 512 * 4]);
+
+        sink = texture.get ();
+
+        {
+            BASICS_ALLOCATION_SCOPE("text");
+
+            vector< wstring > lines(100, wstring(40, L' '));
+        }
+
+        printf ("\n%-12s %12s %12s %12s\n", "tag", "allocations", "live bytes", "peak bytes");
+
+        for (unsigned index = 0, count = Allocation_Tracker::get_tag_count (); index < count; ++index)
+        {
+            Allocation_Tracker::Counters counters = Allocation_Tracker::get_tag_counters (index);
+
+            printf
+            (
+                "%-12s %12llu %12llu %12llu\n",
+                Allocation_Tracker::get_tag_name (index),
+                (unsigned long long)counters.allocations,
+                (unsigned long long)counters.live_bytes,
+                (unsigned long long)counters.peak_bytes
+            );
+        }
+
+        if (Allocation_Tracker::get_tag_counters (2).live_bytes < 512 * 512 * 4) ++failures;
+        if (Allocation_Tracker::get_tag_counters (3).live_bytes != 0            ) ++failures;
+    }
+
+    if (failures) printf ("\n%d checks failed\n", failures);
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,397 @@
+/*
+ * BASICS SUITES
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192100
+ */
+
+// Suites de benchmark_suite con los caminos más frecuentes de la biblioteca. Lo que necesita un
+// contexto gráfico (cargar atlas y fuentes, dibujar texto) usa Null_Graphics_Context y
+// Recording_Canvas, por lo que solo se mide el trabajo de la CPU.
+
+#include <algorithm>
+#include <cstdio>
+#include <dirent.h>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <basics/Atlas>
+#include <basics/Canvas>
+#include <basics/Event_Queue>
+#include <basics/Headless>
+#include <basics/Null_Graphics_Context>
+#include <basics/Null_Rendering>
+#include <basics/Raster_Font>
+#include <basics/Recording_Canvas>
+#include <basics/Rotation>
+#include <basics/Scaling>
+#include <basics/Text_Layout>
+#include <basics/Transformation>
+#include <basics/Translation>
+#include <basics/Window>
+#include <basics/enable>
+#include <basics/fnv>
+#include <basics/png_decode>
+#include "benchmark_suite.hpp"
+
+using namespace basics;
+using namespace basics::benchmarks;
+using namespace std;
+
+namespace
+{
+
+    /**
+     * Crea la ventana por defecto de la plataforma sin pantalla con un Null_Graphics_Context y la
+     * destruye al terminar (el Director solo la usa mientras ejecuta una escena).
+     */
+    class Null_Context_Fixture
+    {
+
+        Window::Handle window_handle;
+
+    public:
+
+        Null_Context_Fixture(const string & assets_path)
+        {
+            enable< Null_Rendering > ();
+
+            Headless::set_assets_path (assets_path);
+
+            window_handle = Window::create_window (default_window_id);
+
+            Window::Accessor window = window_handle.lock ();
+
+            if (window) Null_Graphics_Context::create (window, nullptr);
+        }
+
+       ~Null_Context_Fixture()
+        {
+            // El Director recibirá después los avisos de creación y destrucción de la ventana,
+            // pero no le afectan porque él crea la suya antes de atenderlos:
+
+            Window::destroy_window (default_window_id);
+        }
+
+        Graphics_Context::Accessor lock ()
+        {
+            Window::Accessor window = window_handle.lock ();
+
+            return window ? window->lock_graphics_context () : Graphics_Context::Accessor();
+        }
+
+    };
+
+    bool load_file (const string & path, vector< byte > & data)
+    {
+        FILE * file = fopen (path.c_str (), "rb");
+
+        if (!file) return false;
+
+        fseek (file, 0, SEEK_END);
+        data.resize (size_t(ftell (file)));
+        fseek (file, 0, SEEK_SET);
+
+        bool read = fread (data.data (), 1, data.size (), file) == data.size ();
+
+        fclose (file);
+
+        return read;
+    }
+
+    vector< string > list_files (const string & folder, const string & extension)
+    {
+        vector< string > names;
+
+        if (DIR * directory = opendir (folder.c_str ()))
+        {
+            while (dirent * entry = readdir (directory))
+            {
+                string name = entry->d_name;
+
+                if (name.size () > extension.size () && name.compare (name.size () - extension.size (), extension.size (), extension) == 0)
+                {
+                    names.push_back (name);
+                }
+            }
+
+            closedir (directory);
+        }
+
+        sort (names.begin (), names.end ());
+
+        return names;
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------
+
+BASICS_BENCHMARK_SUITE(png_decode)
+{
+    for (const string & name : list_files (context.get_assets_path (), ".png"))
+    {
+        vector< byte > encoded;
+
+        if (!load_file (context.get_assets_path () + '/' + name, encoded))
+        {
+            fprintf (stderr, "couldn't read %s\n", name.c_str ());
+            continue;
+        }
+
+        Color_Buffer< Rgba8888 > color_buffer(1, 1);
+        unsigned                 width  = 0;
+        unsigned                 height = 0;
+
+        context.measure
+        (
+            name, 1.,
+            [&] ()
+            {
+                png_decode (encoded, color_buffer, width, height);
+                keep (color_buffer);
+            }
+        );
+
+        context.add_counter ("pixels", double(width) * height);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+BASICS_BENCHMARK_SUITE(asset_loading)
+{
+    Null_Context_Fixture       fixture(context.get_assets_path ());
+    Graphics_Context::Accessor graphics_context = fixture.lock ();
+
+    if (!graphics_context) return;
+
+    for (const string & name : list_files (context.get_assets_path (), ".sprites"))
+    {
+        context.measure
+        (
+            "atlas/" + name, 1.,
+            [&] ()
+            {
+                Atlas atlas(name, graphics_context);
+                keep (atlas);
+            }
+        );
+    }
+
+    for (const string & name : list_files (context.get_assets_path (), ".fnt"))
+    {
+        context.measure
+        (
+            "raster_font/" + name, 1.,
+            [&] ()
+            {
+                Raster_Font font(name, graphics_context);
+                keep (font);
+            }
+        );
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+BASICS_BENCHMARK_SUITE(text)
+{
+    Null_Context_Fixture       fixture(context.get_assets_path ());
+    Graphics_Context::Accessor graphics_context = fixture.lock ();
+
+    if (!graphics_context) return;
+
+    Raster_Font font("myfont.fnt", graphics_context);
+
+    if (!font.good ()) return;
+
+    // La fuente del juego solo tiene los dígitos:
+
+    const wstring score = L"42";
+    const wstring lines = L"0123456789012345\n6789012345678901\n2345678901234567\n8901234567890123";
+
+    context.measure ("text_layout/score", 1., [&] () { Text_Layout layout(font, score); keep (layout); });
+    context.measure ("text_layout/lines", 1., [&] () { Text_Layout layout(font, lines); keep (layout); });
+
+    Canvas * canvas = Canvas::create (ID(canvas), graphics_context, {{ 720, 1280 }});
+
+    if (!canvas) return;
+
+    const Text_Layout score_layout(font, score);
+    const Text_Layout lines_layout(font, lines);
+
+    context.measure ("draw_text/score", 1., [&] () { canvas->draw_text ({ 360.f, 1216.f }, score_layout, TOP | CENTER); });
+
+    context.add_counter ("glyphs", double(score_layout.get_glyphs ().size ()));
+
+    context.measure ("draw_text/lines", 1., [&] () { canvas->draw_text ({ 0.f, 1280.f }, lines_layout); });
+
+    context.add_counter ("glyphs", double(lines_layout.get_glyphs ().size ()));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+    // La cola con mutex no retorna nada en push(), por lo que se envuelve para tener la misma
+    // interfaz que las colas sin bloqueos:
+
+    struct Locked_Queue : Event_Queue
+    {
+        bool push (Event && event)
+        {
+            Event_Queue::push (std::move (event));
+            return true;
+        }
+    };
+
+    // new no respeta en C++11 la alineación de las colas (alignas), así que se construyen con
+    // placement new en un almacenamiento alineado:
+
+    template< class QUEUE >
+    class Aligned_Queue
+    {
+
+        typename std::aligned_storage< sizeof(QUEUE), alignof(QUEUE) >::type storage;
+
+        QUEUE * queue;
+
+    public:
+
+        Aligned_Queue() : queue(new (&storage) QUEUE)
+        {
+        }
+
+       ~Aligned_Queue()
+        {
+            queue->~QUEUE ();
+        }
+
+        QUEUE * operator -> ()
+        {
+            return queue;
+        }
+
+        QUEUE & operator * ()
+        {
+            return *queue;
+        }
+
+    };
+
+    template< class QUEUE >
+    void transfer (unsigned count)
+    {
+        Aligned_Queue< QUEUE > queue;
+
+        std::thread producer
+        (
+            [&queue, count] ()
+            {
+                for (unsigned index = 0; index < count; ++index)
+                {
+                    Event event(ID(touch-moved), Event::Touch{ 0, float(index), float(index) });
+
+                    while (!queue->push (std::move (event))) std::this_thread::yield ();
+                }
+            }
+        );
+
+        Event    event;
+        unsigned received = 0;
+
+        while (received < count)
+        {
+            if (queue->poll (event)) ++received; else std::this_thread::yield ();
+        }
+
+        producer.join ();
+    }
+
+}
+
+BASICS_BENCHMARK_SUITE(event_queue)
+{
+    // Un hilo productor y el hilo principal como consumidor. Se mide el tiempo por evento:
+
+    const unsigned count = 10000;
+
+    context.measure ("push_poll/mutex", count, [] () { transfer< Locked_Queue     > (count); });
+    context.measure ("push_poll/spsc",  count, [] () { transfer< Spsc_Event_Queue > (count); });
+    context.measure ("push_poll/mpsc",  count, [] () { transfer< Mpsc_Event_Queue > (count); });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+BASICS_BENCHMARK_SUITE(transformation)
+{
+    // Composición típica de un sprite (trasladar, girar y escalar) y de una cadena de nodos:
+
+    float angle = 0.f;
+
+    context.measure
+    (
+        "compose_2d", 1.,
+        [&] ()
+        {
+            angle += 0.001f;
+
+            Transformation2f transform = Translation2f(100.f, 200.f) * Rotation2f(angle) * Scaling2f(1.5f, 0.5f);
+
+            keep (transform);
+        }
+    );
+
+    Transformation2f chain[16];
+
+    for (unsigned index = 0; index < 16; ++index) chain[index] = Translation2f(float(index), 1.f) * Rotation2f(index * 0.1f);
+
+    context.measure
+    (
+        "chain_2d", 16.,
+        [&] ()
+        {
+            Transformation2f transform;
+
+            for (const Transformation2f & node : chain) transform = transform * node;
+
+            keep (transform);
+        }
+    );
+
+    Matrix44f a = Matrix44f::identity;
+    Matrix44f b = Matrix44f::identity;
+
+    b[0][3] = 1.f;
+    b[1][0] = 0.5f;
+
+    context.measure
+    (
+        "matrix_4x4", 1.,
+        [&] ()
+        {
+            a = a * b;
+            keep (a);
+        }
+    );
+}
+
+// -------------------------------------------------------------------------------------------------
+
+BASICS_BENCHMARK_SUITE(fnv)
+{
+    const string short_text = "game-assets";
+    const string long_text (256, 'x');
+
+    context.measure ("fnv32/11",  short_text.size (), [&] () { uint32_t hash = fnv32 (short_text); keep (hash); });
+    context.measure ("fnv32/256", long_text .size (), [&] () { uint32_t hash = fnv32 (long_text ); keep (hash); });
+}
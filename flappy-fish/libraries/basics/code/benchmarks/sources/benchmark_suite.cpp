@@ -0,0 +1,411 @@
+/*
+ * BENCHMARK SUITE
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192100
+ */
+
+// Ejecuta las suites registradas con BASICS_BENCHMARK_SUITE, muestra los resultados y opcionalmente
+// los guarda en JSON y los compara con los de una ejecución anterior:
+//
+//   basics_benchmark_suite [opciones]
+//
+//     --filter <texto>       Solo mide lo que contenga el texto en "suite/nombre".
+//     --min-time <segundos>  Duración mínima de cada repetición (0.1 por defecto).
+//     --repetitions <n>      Repeticiones de cada medición (5 por defecto).
+//     --assets <carpeta>     Carpeta de los assets (BASICS_ASSETS_PATH o "assets" por defecto).
+//     --output <archivo>     Guarda los resultados en JSON (--json es sinónimo).
+//     --baseline <archivo>   Compara con los resultados guardados en el archivo.
+//     --threshold <%>        Diferencia a partir de la cual se marca una regresión (10 por defecto).
+//     --help                 Muestra las opciones.
+//
+// Al comparar, el programa termina con código 1 si alguna medición es más lenta que la de referencia
+// o si alguno de sus valores adicionales (p. ej. los sprites por fotograma) ha crecido más allá del
+// umbral, de modo que se puede usar en integración continua.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include "benchmark_suite.hpp"
+
+using namespace std;
+
+namespace basics { namespace benchmarks
+{
+
+    namespace
+    {
+
+        typedef map< string, Suite_Function > Suite_Map;
+
+        Suite_Map & get_suites ()
+        {
+            static Suite_Map suites;
+            return suites;
+        }
+
+    }
+
+    Suite_Registrar::Suite_Registrar(const char * name, Suite_Function function)
+    {
+        get_suites ()[name] = function;
+    }
+
+    void Suite_Context::add_result (const string & name, double items, uint64_t iterations, vector< double > samples)
+    {
+        measured = false;
+
+        if (samples.empty () || iterations == 0 || items <= 0. || !wants (name)) return;
+
+        sort (samples.begin (), samples.end ());
+
+        const double scale  = 1e9 / (double(iterations) * items);
+        const double median = samples.size () % 2
+                            ?  samples[samples.size () / 2]
+                            : (samples[samples.size () / 2 - 1] + samples[samples.size () / 2]) * 0.5;
+
+        Result result;
+
+        result.suite            = suite;
+        result.name             = name;
+        result.iterations       = iterations;
+        result.repetitions      = unsigned(samples.size ());
+        result.ns_per_item      = median * scale;
+        result.min_ns_per_item  = samples.front () * scale;
+        result.items_per_second = result.ns_per_item > 0. ? 1e9 / result.ns_per_item : 0.;
+
+        results.push_back (result);
+
+        measured = true;
+
+        printf ("%-48s %14.1f ns %16.0f /s %10llu x %u\n", (suite + '/' + name).c_str (), result.ns_per_item, result.items_per_second, (unsigned long long)iterations, result.repetitions);
+        fflush (stdout);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    namespace
+    {
+
+        string escape (const string & text)
+        {
+            string escaped;
+
+            for (char character : text)
+            {
+                if (character == '"' || character == '\\') escaped += '\\';
+
+                escaped += character;
+            }
+
+            return escaped;
+        }
+
+        bool write_json (const string & path, const vector< Result > & results)
+        {
+            ofstream file(path);
+
+            if (!file) return false;
+
+            char   date[32];
+            time_t now = time (nullptr);
+
+            strftime (date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime (&now));
+
+            file << "{\n";
+            file << "  \"context\": { \"date\": \"" << date << "\", \"cores\": " << thread::hardware_concurrency ();
+
+            #if defined(NDEBUG)
+                file << ", \"build\": \"release\"";
+            #else
+                file << ", \"build\": \"debug\"";
+            #endif
+
+            file << ", \"compiler\": \"" << escape (__VERSION__) << "\" },\n";
+            file << "  \"benchmarks\":\n  [\n";
+
+            // Cada medición ocupa una línea para que las diferencias entre versiones sean legibles:
+
+            for (size_t index = 0; index < results.size (); ++index)
+            {
+                const Result & result = results[index];
+
+                file.precision (10);
+
+                file << "    { \"suite\": \""         << escape (result.suite)
+                     << "\", \"name\": \""           << escape (result.name)
+                     << "\", \"iterations\": "       << result.iterations
+                     <<   ", \"repetitions\": "      << result.repetitions
+                     <<   ", \"ns_per_item\": "      << result.ns_per_item
+                     <<   ", \"min_ns_per_item\": "  << result.min_ns_per_item
+                     <<   ", \"items_per_second\": " << result.items_per_second
+                     <<   ", \"counters\": {";
+
+                for (size_t counter = 0; counter < result.counters.size (); ++counter)
+                {
+                    file << (counter ? ", \"" : " \"") << escape (result.counters[counter].first) << "\": " << result.counters[counter].second;
+                }
+
+                file << (result.counters.empty () ? "}" : " }") << " }" << (index + 1 < results.size () ? ",\n" : "\n");
+            }
+
+            file << "  ]\n}\n";
+
+            return bool(file);
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        // Lectura de los archivos escritos por write_json(). No es un lector de JSON general: solo
+        // entiende una medición por línea con las claves en el orden en que se escriben.
+
+        bool read_string (const string & line, const char * key, string & value)
+        {
+            size_t start = line.find (string("\"") + key + "\": \"");
+
+            if (start == string::npos) return false;
+
+            value.clear ();
+
+            for (size_t index = start + strlen (key) + 5; index < line.size (); ++index)
+            {
+                if (line[index] == '\\' && index + 1 < line.size ()) value += line[++index]; else
+                if (line[index] == '"') return true;
+                else
+                    value += line[index];
+            }
+
+            return false;
+        }
+
+        bool read_number (const string & line, const char * key, double & value)
+        {
+            size_t start = line.find (string("\"") + key + "\": ");
+
+            if (start == string::npos) return false;
+
+            value = strtod (line.c_str () + start + strlen (key) + 4, nullptr);
+
+            return true;
+        }
+
+        void read_counters (const string & line, Result::Counter_List & counters)
+        {
+            size_t start = line.find ("\"counters\": {");
+            size_t end   = line.find ('}', start);
+
+            if (start == string::npos || end == string::npos) return;
+
+            istringstream pairs(line.substr (start + 13, end - start - 13));
+            string        pair;
+
+            while (getline (pairs, pair, ','))
+            {
+                size_t open  = pair.find ('"');
+                size_t close = pair.find ("\":", open + 1);
+
+                if (open != string::npos && close != string::npos)
+                {
+                    counters.emplace_back (pair.substr (open + 1, close - open - 1), strtod (pair.c_str () + close + 2, nullptr));
+                }
+            }
+        }
+
+        bool read_json (const string & path, vector< Result > & results)
+        {
+            ifstream file(path);
+
+            if (!file) return false;
+
+            string line;
+
+            while (getline (file, line))
+            {
+                Result result;
+
+                if (read_string (line, "suite", result.suite) && read_string (line, "name", result.name) && read_number (line, "ns_per_item", result.ns_per_item))
+                {
+                    read_counters (line, result.counters);
+
+                    results.push_back (result);
+                }
+            }
+
+            return true;
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        unsigned compare (const vector< Result > & baseline, const vector< Result > & results, double threshold)
+        {
+            map< string, const Result * > previous;
+
+            for (const Result & result : baseline) previous[result.suite + '/' + result.name] = &result;
+
+            printf ("\n%-48s %14s %14s %9s\n", "comparison", "baseline ns", "current ns", "change");
+
+            unsigned regressions = 0;
+
+            for (const Result & result : results)
+            {
+                const string name  = result.suite + '/' + result.name;
+                auto         found = previous.find (name);
+
+                if (found == previous.end ())
+                {
+                    printf ("%-48s %14s %14.1f %9s  new\n", name.c_str (), "-", result.ns_per_item, "");
+                    continue;
+                }
+
+                const Result & reference = *found->second;
+                const double   change    = reference.ns_per_item > 0. ? result.ns_per_item / reference.ns_per_item - 1. : 0.;
+                const char   * verdict   = change > threshold ? "REGRESSION" : change < -threshold ? "faster" : "";
+
+                if (change > threshold) ++regressions;
+
+                printf ("%-48s %14.1f %14.1f %+8.1f%%  %s\n", name.c_str (), reference.ns_per_item, result.ns_per_item, change * 100., verdict);
+
+                // Los valores adicionales suelen ser cuentas (dibujos, cambios de estado...) que
+                // no deberían crecer:
+
+                for (const auto & counter : result.counters)
+                {
+                    for (const auto & reference_counter : reference.counters)
+                    {
+                        if (reference_counter.first == counter.first && counter.second > reference_counter.second * (1. + threshold) + 1e-9)
+                        {
+                            printf ("%-48s %14.2f %14.2f %9s  REGRESSION\n", ("  " + counter.first).c_str (), reference_counter.second, counter.second, "");
+
+                            ++regressions;
+                        }
+                    }
+                }
+            }
+
+            printf ("\n%u regression%s above %.0f%%\n", regressions, regressions == 1 ? "" : "s", threshold * 100.);
+
+            return regressions;
+        }
+
+    }
+
+}}
+
+using namespace basics::benchmarks;
+
+namespace
+{
+
+    void print_usage (FILE * stream, const char * program)
+    {
+        fprintf
+        (
+            stream,
+            "usage: %s [options]\n"
+            "\n"
+            "  --filter <text>        only measure what contains the text in \"suite/name\"\n"
+            "  --min-time <seconds>   minimum duration of each repetition (0.1 by default)\n"
+            "  --repetitions <n>      repetitions of each measurement (5 by default)\n"
+            "  --assets <folder>      assets folder (BASICS_ASSETS_PATH or \"assets\" by default)\n"
+            "  --output <file>        save the results as JSON (also --json <file>)\n"
+            "  --baseline <file>      compare with the results saved in the file\n"
+            "  --threshold <%%>        difference reported as a regression (10 by default)\n"
+            "  --help                 show this message\n",
+            program
+        );
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    const char * assets_variable = getenv ("BASICS_ASSETS_PATH");
+
+    string   filter;
+    string   output;
+    string   baseline;
+    string   assets_path = assets_variable ? assets_variable : "assets";
+    double   min_time    = 0.1;
+    double   threshold   = 0.1;
+    unsigned repetitions = 5;
+
+    for (int index = 1; index < number_of_arguments; ++index)
+    {
+        const string option = arguments[index];
+        const char * value  = index + 1 < number_of_arguments ? arguments[index + 1] : nullptr;
+
+        if (option == "--help" || option == "-h")
+        {
+            print_usage (stdout, arguments[0]);
+            return 0;
+        }
+
+        if (!value)
+        {
+            fprintf (stderr, "missing value for %s\n\n", option.c_str ());
+            print_usage (stderr, arguments[0]);
+            return 2;
+        }
+
+        if (option == "--filter"     ) filter      = value;                              else
+        if (option == "--output"     ) output      = value;                              else
+        if (option == "--json"       ) output      = value;                              else
+        if (option == "--baseline"   ) baseline    = value;                              else
+        if (option == "--assets"     ) assets_path = value;                              else
+        if (option == "--min-time"   ) min_time    = atof (value);                       else
+        if (option == "--threshold"  ) threshold   = atof (value) / 100.;                else
+        if (option == "--repetitions") repetitions = max (unsigned(atoi (value)), 1u);
+        else
+        {
+            fprintf (stderr, "unknown option %s\n\n", option.c_str ());
+            print_usage (stderr, arguments[0]);
+            return 2;
+        }
+
+        ++index;
+    }
+
+    Suite_Context context(filter, assets_path, min_time, repetitions);
+
+    printf ("%-48s %17s %18s %15s\n", "benchmark", "time per item", "items per second", "iterations");
+
+    for (const auto & suite : get_suites ())
+    {
+        context.begin_suite (suite.first);
+
+        suite.second (context);
+    }
+
+    if (!output.empty () && !write_json (output, context.get_results ()))
+    {
+        fprintf (stderr, "couldn't write %s\n", output.c_str ());
+        return 2;
+    }
+
+    if (!baseline.empty ())
+    {
+        vector< Result > reference;
+
+        if (!read_json (baseline, reference))
+        {
+            fprintf (stderr, "couldn't read %s\n", baseline.c_str ());
+            return 2;
+        }
+
+        return compare (reference, context.get_results (), threshold) ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    return EXIT_SUCCESS;
+}
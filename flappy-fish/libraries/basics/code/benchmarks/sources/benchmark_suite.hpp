@@ -0,0 +1,201 @@
+/*
+ * BENCHMARK SUITE
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192100
+ */
+
+#ifndef BASICS_BENCHMARK_SUITE_HEADER
+#define BASICS_BENCHMARK_SUITE_HEADER
+
+    #include <chrono>
+    #include <cstdint>
+    #include <string>
+    #include <utility>
+    #include <vector>
+
+    namespace basics { namespace benchmarks
+    {
+
+        /**
+         * Resultado de una medición. El tiempo es la mediana de las repeticiones dividida entre el
+         * número de elementos que procesa cada iteración (un evento, un glifo, un fotograma...).
+         */
+        struct Result
+        {
+            typedef std::vector< std::pair< std::string, double > > Counter_List;
+
+            std::string  suite;
+            std::string  name;
+            uint64_t     iterations;                        ///< Iteraciones de cada repetición
+            unsigned     repetitions;
+            double       ns_per_item;                       ///< Mediana
+            double       min_ns_per_item;
+            double       items_per_second;
+            Counter_List counters;                          ///< Valores adicionales (p. ej. sprites por fotograma)
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Evita que el compilador elimine el cálculo que produce el valor.
+         */
+        template< typename TYPE >
+        inline void keep (const TYPE & value)
+        {
+            asm volatile ("" : : "r"(&value) : "memory");
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Es lo que recibe cada suite para medir. Solo se mide lo que pasa el filtro de la línea de
+         * órdenes.
+         */
+        class Suite_Context
+        {
+        public:
+
+            typedef std::chrono::steady_clock Clock;
+
+        private:
+
+            std::string           suite;
+            std::string           filter;
+            std::string           assets_path;
+            double                min_time;             ///< Segundos que debe durar cada repetición como mínimo
+            unsigned              repetitions;
+            bool                  measured;             ///< Si se guardó la última medición pedida
+            std::vector< Result > results;
+
+        public:
+
+            Suite_Context(const std::string & filter, const std::string & assets_path, double min_time, unsigned repetitions)
+            :
+                filter      (filter     ),
+                assets_path (assets_path),
+                min_time    (min_time   ),
+                repetitions (repetitions),
+                measured    (false      )
+            {
+            }
+
+        public:
+
+            void begin_suite (const std::string & name)
+            {
+                suite = name;
+            }
+
+            const std::string & get_assets_path () const
+            {
+                return assets_path;
+            }
+
+            unsigned get_repetitions () const
+            {
+                return repetitions;
+            }
+
+            const std::vector< Result > & get_results () const
+            {
+                return results;
+            }
+
+            /**
+             * Indica si el filtro deja pasar la medición "suite/name".
+             */
+            bool wants (const std::string & name) const
+            {
+                return filter.empty () || (suite + '/' + name).find (filter) != std::string::npos;
+            }
+
+            /**
+             * Mide body(), que procesa items elementos en cada llamada. Primero se busca cuántas
+             * iteraciones hacen falta para que una repetición dure al menos min_time y luego se
+             * repite la medición.
+             */
+            template< typename BODY >
+            void measure (const std::string & name, double items, BODY && body)
+            {
+                measured = false;
+
+                if (!wants (name)) return;
+
+                body ();                                    // Calentamiento (cachés, memoria reservada...)
+
+                uint64_t iterations = 1;
+
+                for (double seconds = time (body, iterations); seconds < min_time; seconds = time (body, iterations))
+                {
+                    // Se estima el número de iteraciones a partir de la duración de la última prueba:
+
+                    double factor = seconds > 0. ? min_time * 1.2 / seconds : 10.;
+
+                    iterations = uint64_t(double(iterations) * (factor < 10. ? (factor > 1.5 ? factor : 1.5) : 10.)) + 1;
+                }
+
+                std::vector< double > samples(repetitions);
+
+                for (double & sample : samples) sample = time (body, iterations);
+
+                add_result (name, items, iterations, samples);
+            }
+
+            /**
+             * Guarda una medición tomada por la suite. Cada muestra es la duración en segundos de
+             * una repetición de iterations iteraciones.
+             */
+            void add_result (const std::string & name, double items, uint64_t iterations, std::vector< double > samples);
+
+            /**
+             * Añade un valor adicional a la última medición (si no se descartó por el filtro).
+             */
+            void add_counter (const std::string & name, double value)
+            {
+                if (measured) results.back ().counters.emplace_back (name, value);
+            }
+
+        private:
+
+            template< typename BODY >
+            static double time (BODY & body, uint64_t iterations)
+            {
+                Clock::time_point start = Clock::now ();
+
+                for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    body ();
+                }
+
+                return std::chrono::duration< double >(Clock::now () - start).count ();
+            }
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        typedef void (* Suite_Function) (Suite_Context & );
+
+        /**
+         * Las suites se registran al iniciarse el programa con BASICS_BENCHMARK_SUITE y se ejecutan
+         * en orden alfabético.
+         */
+        struct Suite_Registrar
+        {
+            Suite_Registrar(const char * name, Suite_Function function);
+        };
+
+    }}
+
+    #define BASICS_BENCHMARK_SUITE(NAME)                                                                        \
+        static void NAME##_suite (basics::benchmarks::Suite_Context & );                                        \
+        static basics::benchmarks::Suite_Registrar NAME##_registrar(#NAME, NAME##_suite);                        \
+        static void NAME##_suite (basics::benchmarks::Suite_Context & context)
+
+#endif
@@ -0,0 +1,225 @@
+/*
+ * EVENT QUEUE BENCHMARK
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191230
+ */
+
+// Compara la cola de eventos con mutex (Event_Queue) con las colas sin bloqueos (Spsc_Event_Queue
+// y Mpsc_Event_Queue) en el host. Para cada cola se mide:
+//
+//  - El número de eventos por segundo que pasan de los productores al consumidor con la cola saturada.
+//  - La latencia (p50, p99, p99.9 y máxima) desde que se añade un evento hasta que el consumidor lo
+//    recibe cuando los eventos llegan en ráfagas, como ocurre con los eventos de movimiento táctil.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <basics/Event_Queue>
+
+using namespace basics;
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+
+    typedef steady_clock Clock;
+
+    struct Result
+    {
+        double events_per_second;
+        double p50;
+        double p99;
+        double p999;
+        double max;
+    };
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< class QUEUE >
+    void produce (QUEUE & queue, unsigned first, unsigned count, unsigned stride, unsigned burst, vector< Clock::time_point > & sent)
+    {
+        for (unsigned index = 0; index < count; ++index)
+        {
+            unsigned sequence = first + index * stride;
+
+            // Los eventos se agrupan en ráfagas separadas por pausas breves:
+
+            if (burst && index % burst == 0) this_thread::sleep_for (microseconds(200));
+
+            sent[sequence] = Clock::now ();
+
+            Event event(ID(touch-moved), Event::Touch{ int32_t(sequence), float(index), float(index) });
+
+            // Con la política DISCARD la cola llena rechaza el evento y se reintenta para que todos
+            // los eventos lleguen al consumidor:
+
+            while (!queue.push (std::move (event))) this_thread::yield ();
+        }
+    }
+
+    // La cola con mutex no retorna nada en push(), por lo que se envuelve para tener la misma interfaz:
+
+    struct Locked_Queue : Event_Queue
+    {
+        bool push (Event && event)
+        {
+            Event_Queue::push (std::move (event));
+            return true;
+        }
+    };
+
+    // ---------------------------------------------------------------------------------------------
+
+    // new no respeta en C++11 la alineación de las colas (alignas), así que se construyen con
+    // placement new en un almacenamiento alineado:
+
+    template< class QUEUE >
+    class Aligned_Queue
+    {
+
+        typename std::aligned_storage< sizeof(QUEUE), alignof(QUEUE) >::type storage;
+
+        QUEUE * queue;
+
+    public:
+
+        Aligned_Queue() : queue(new (&storage) QUEUE)
+        {
+        }
+
+       ~Aligned_Queue()
+        {
+            queue->~QUEUE ();
+        }
+
+        QUEUE * operator -> ()
+        {
+            return queue;
+        }
+
+        QUEUE & operator * ()
+        {
+            return *queue;
+        }
+
+    };
+
+    template< class QUEUE >
+    Result run (unsigned producers, unsigned events_per_producer, unsigned burst)
+    {
+        Aligned_Queue< QUEUE > queue;
+
+        const unsigned total = producers * events_per_producer;
+
+        vector< Clock::time_point > sent    (total);
+        vector< double            > latency (total);
+
+        atomic< unsigned > received(0);
+
+        Clock::time_point start = Clock::now ();
+
+        thread consumer
+        (
+            [&] ()
+            {
+                while (received.load (memory_order_relaxed) < total)
+                {
+                    size_t count = queue->drain
+                    (
+                        [&] (Event & event)
+                        {
+                            unsigned sequence = unsigned(event.touch ().pointer_id);
+
+                            latency[sequence] = duration< double, micro >(Clock::now () - sent[sequence]).count ();
+                        }
+                    );
+
+                    if (count) received.fetch_add (unsigned(count), memory_order_relaxed); else this_thread::yield ();
+                }
+            }
+        );
+
+        vector< thread > threads;
+
+        for (unsigned index = 0; index < producers; ++index)
+        {
+            threads.emplace_back
+            (
+                [&, index] ()
+                {
+                    produce (*queue, index, events_per_producer, producers, burst, sent);
+                }
+            );
+        }
+
+        for (auto & producer : threads) producer.join ();
+
+        consumer.join ();
+
+        double seconds = duration< double >(Clock::now () - start).count ();
+
+        sort (latency.begin (), latency.end ());
+
+        Result result;
+
+        result.events_per_second = total / seconds;
+        result.p50               = latency[total *  50 /  100];
+        result.p99               = latency[total *  99 /  100];
+        result.p999              = latency[total * 999 / 1000];
+        result.max               = latency.back ();
+
+        return result;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< class QUEUE >
+    void report (const char * name, unsigned producers, unsigned events, unsigned burst)
+    {
+        Result saturated = run< QUEUE > (producers, events, 0);
+        Result bursts    = run< QUEUE > (producers, events / 16, burst);
+
+        printf
+        (
+            "%-18s %9u %12.0f %10.1f %10.1f %10.1f %10.1f\n",
+            name,
+            producers,
+            saturated.events_per_second,
+            bursts.p50,
+            bursts.p99,
+            bursts.p999,
+            bursts.max
+        );
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    const unsigned events = number_of_arguments > 1 ? unsigned(atoi (arguments[1])) : 1000000;
+    const unsigned burst  = 32;
+
+    printf ("%u events per run, latency measured with bursts of %u events (microseconds)\n\n", events, burst);
+    printf ("%-18s %9s %12s %10s %10s %10s %10s\n", "queue", "producers", "events/s", "p50", "p99", "p99.9", "max");
+
+    report< Locked_Queue     > ("mutex",  1, events, burst);
+    report< Spsc_Event_Queue > ("spsc",   1, events, burst);
+    report< Mpsc_Event_Queue > ("mpsc",   1, events, burst);
+    report< Locked_Queue     > ("mutex",  3, events, burst);
+    report< Mpsc_Event_Queue > ("mpsc",   3, events, burst);
+
+    return 0;
+}
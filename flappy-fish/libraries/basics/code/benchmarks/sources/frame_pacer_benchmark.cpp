@@ -0,0 +1,127 @@
+/*
+ * FRAME PACER BENCHMARK
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191445
+ */
+
+// Mide el jitter de la duración de los fotogramas (diferencia entre el intervalo real y el objetivo)
+// a 30, 60, 90 y 120 Hz con una carga de trabajo variable por fotograma, comparando:
+//
+//  - sleep_for: tras cada fotograma se duerme lo que falta del periodo medido con un Timer nuevo,
+//    que es lo más parecido a lo que hacía el bucle del Director antes de usar Frame_Pacer.
+//  - Frame_Pacer: agenda absoluta con espera híbrida (dormir y ceder el hilo) y corrección de deriva.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <basics/Frame_Pacer>
+#include <basics/Histogram>
+#include <basics/Timer>
+
+using namespace basics;
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+
+    typedef steady_clock Clock;
+
+    // Simula el trabajo de un fotograma ocupando la CPU durante el tiempo indicado:
+
+    void work (double seconds)
+    {
+        Timer timer;
+
+        while (timer.get_elapsed_seconds< double > () < seconds);
+    }
+
+    void print (const char * name, unsigned rate, const Histogram & jitter, double seconds, unsigned frames)
+    {
+        printf
+        (
+            "%-12s %4u Hz %10.1f fps %10.3f %10.3f %10.3f\n",
+            name,
+            rate,
+            frames / seconds,
+            jitter.percentile (50) / 1000.0,
+            jitter.percentile (99) / 1000.0,
+            jitter.max        (  ) / 1000.0
+        );
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    const unsigned frames = number_of_arguments > 1 ? unsigned(atoi (arguments[1])) : 240;
+
+    printf ("%u frames per run, work load between 10%% and 60%% of the period (jitter in ms)\n\n", frames);
+    printf ("%-12s %7s %14s %10s %10s %10s\n", "loop", "target", "rate", "p50", "p99", "max");
+
+    for (unsigned rate : { 30u, 60u, 90u, 120u })
+    {
+        const double period = 1.0 / rate;
+
+        minstd_rand                         random(rate);
+        uniform_real_distribution< double > load(0.1, 0.6);
+
+        // Bucle que duerme lo que falta del periodo:
+
+        {
+            Histogram         jitter;
+            Clock::time_point start = Clock::now ();
+            Clock::time_point last  = start;
+
+            for (unsigned frame = 0; frame < frames; ++frame)
+            {
+                Timer timer;
+
+                work (period * load (random));
+
+                double remaining = period - timer.get_elapsed_seconds< double > ();
+
+                if (remaining > 0.0) this_thread::sleep_for (duration< double >(remaining));
+
+                Clock::time_point now = Clock::now ();
+
+                double interval = duration< double >(now - last).count ();
+
+                jitter.add (uint64_t(fabs (interval - period) * 1000000.0));
+
+                last = now;
+            }
+
+            print ("sleep_for", rate, jitter, duration< double >(Clock::now () - start).count (), frames);
+        }
+
+        // Bucle con Frame_Pacer:
+
+        {
+            Frame_Pacer       pacer(static_cast< float >(rate));
+            Clock::time_point start = Clock::now ();
+
+            pacer.wait ();
+
+            for (unsigned frame = 0; frame < frames; ++frame)
+            {
+                work (period * load (random));
+
+                pacer.wait ();
+            }
+
+            print ("Frame_Pacer", rate, pacer.get_jitter (), duration< double >(Clock::now () - start).count (), frames);
+        }
+    }
+
+    return 0;
+}
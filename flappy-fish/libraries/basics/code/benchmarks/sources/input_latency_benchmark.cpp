@@ -0,0 +1,134 @@
+/*
+ * INPUT LATENCY BENCHMARK
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191400
+ */
+
+// Mide en el host la latencia de entrada con el Director real sin pantalla (Null_Graphics_Context):
+// un Input_Injector programa toques en fotogramas separados por intervalos aleatorios, el Director
+// los entrega a una escena que tarda el tiempo de dibujado indicado y que después espera a la
+// siguiente sincronización vertical (como flush_and_display() en un dispositivo), y al terminar se
+// lee el Histogram input_latency que ha ido llenando el Director:
+//
+//   input_latency_benchmark [Hz] [fotogramas] [milisegundos de dibujado]
+//
+// Input_Injector pone a los eventos la hora del comienzo del fotograma en el que se inyectan, así que
+// la latencia medida va del comienzo del fotograma a la presentación (cerca de un periodo). En un
+// dispositivo hay que sumarle lo que el evento espera en la cola hasta que empieza el fotograma, entre
+// cero y otro periodo.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+#include <basics/Director>
+#include <basics/Histogram>
+#include <basics/Input_Injector>
+#include <basics/Null_Graphics_Context>
+#include <basics/Scene>
+
+using namespace basics;
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+
+    // Escena que solo consume el tiempo de dibujado y espera a la sincronización vertical:
+
+    class Latency_Scene : public Scene
+    {
+
+        nanoseconds              frame_period;
+        milliseconds             render_time;
+        steady_clock::time_point vsync;
+        bool                     started;
+
+    public:
+
+        Latency_Scene(unsigned frame_rate, unsigned render_time)
+        :
+            frame_period(1000000000 / frame_rate),
+            render_time (render_time),
+            started     (false)
+        {
+        }
+
+        Size2u get_view_size () override
+        {
+            return { 720, 1280 };
+        }
+
+        void render (Graphics_Context::Accessor & ) override
+        {
+            if (!started)
+            {
+                vsync   = steady_clock::now () + frame_period;
+                started = true;
+            }
+
+            this_thread::sleep_for   (render_time);
+            this_thread::sleep_until (vsync);
+
+            vsync += frame_period;
+        }
+
+    };
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    const unsigned frame_rate  = number_of_arguments > 1 ? unsigned(atoi (arguments[1])) : 60;
+    const unsigned frame_count = number_of_arguments > 2 ? unsigned(atoi (arguments[2])) : 300;
+    const unsigned render_time = number_of_arguments > 3 ? unsigned(atoi (arguments[3])) : 4;        // milisegundos
+
+    // Toques separados por intervalos aleatorios de 1 a 3 fotogramas:
+
+    Input_Injector                  input_injector;
+    minstd_rand                     random(1234);
+    uniform_int_distribution< int > interval(1, 3);
+
+    for (uint64_t frame = 1; frame < frame_count; frame += interval (random))
+    {
+        input_injector.touch_started (frame, 360.f, 640.f);
+    }
+
+    // La escena espera a la sincronización vertical, así que el Director no tiene que esperar más:
+
+    director.set_graphics_context_factory (Null_Graphics_Context::create);
+    director.set_frame_pacing             (false);
+    director.set_input_injector           (&input_injector);
+    director.set_frame_limit              (frame_count);
+    director.reset_input_latency          ();
+
+    director.run_scene (make_shared< Latency_Scene > (frame_rate, render_time));
+
+    director.set_input_injector (nullptr);
+
+    const Histogram & latency = director.get_input_latency ();
+
+    printf
+    (
+        "%u Hz, %u ms of render time, %llu input events\n"
+        "input latency: p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms (mean %.2f ms)\n",
+        frame_rate,
+        render_time,
+        (unsigned long long)latency.count (),
+        latency.percentile (50) / 1000.0,
+        latency.percentile (95) / 1000.0,
+        latency.percentile (99) / 1000.0,
+        latency.max        (  ) / 1000.0,
+        latency.mean       (  ) / 1000.0
+    );
+
+    return latency.count () > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
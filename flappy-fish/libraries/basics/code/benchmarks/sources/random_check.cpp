@@ -0,0 +1,136 @@
+/*
+ * RANDOM CHECK
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192600
+ */
+
+// Comprueba en el host que Pcg32 da la secuencia de la implementación de referencia de PCG32
+// (pcg32-demo de pcg-c-basic con semilla 42 y stream 54) y que advance() y fill() dan los mismos
+// números que next(). Termina con un código de error si algo no coincide.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <basics/Random>
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    // Primeros números de la salida publicada de pcg32-demo (pcg32_srandom_r(&rng, 42u, 54u)):
+
+    const uint32_t reference[] =
+    {
+        0xA15C02B7u, 0x7B47F409u, 0xBA1D3330u, 0x83D2F293u, 0xBFA4784Bu, 0xCBED606Eu
+    };
+
+    const size_t reference_count = sizeof(reference) / sizeof(reference[0]);
+
+    unsigned failures = 0;
+
+    void check (bool condition, const char * what)
+    {
+        if (!condition)
+        {
+            printf ("FAILED: %s\n", what);
+            failures++;
+        }
+    }
+
+}
+
+int main ()
+{
+    // Secuencia de referencia:
+
+    Pcg32 generator(42u, 54u);
+
+    bool matches = true;
+
+    for (size_t index = 0; index < reference_count; ++index)
+    {
+        uint32_t value = generator.next ();
+
+        if (value != reference[index])
+        {
+            printf ("value %zu is 0x%08X instead of 0x%08X\n", index, value, reference[index]);
+            matches = false;
+        }
+    }
+
+    check (matches, "next() matches the PCG32 reference output");
+
+    // advance() debe llegar al mismo número que next() llamado delta veces, hacia delante y hacia
+    // atrás:
+
+    const size_t     count = 10000;
+    vector< uint32_t > sequence(count);
+
+    Pcg32 sequential(42u, 54u);
+
+    for (uint32_t & value : sequence) value = sequential.next ();
+
+    bool advanced = true;
+
+    for (size_t delta : { size_t(0), size_t(1), size_t(5), size_t(63), size_t(64), size_t(1000), count - 1 })
+    {
+        Pcg32 jumped(42u, 54u);
+
+        jumped.advance (delta);
+
+        advanced &= jumped.next () == sequence[delta];
+    }
+
+    check (advanced, "advance(n) matches n calls to next()");
+
+    Pcg32 rewound(42u, 54u);
+
+    rewound.advance (count);
+    rewound.advance (uint64_t(0) - count);
+
+    check (rewound.next () == sequence[0], "advance(-n) undoes advance(n)");
+
+    // fill() debe dar los mismos números en el mismo orden con cualquier tamaño (incluidos los que
+    // no son múltiplo del número de copias del generador que usa) y dejar el generador en el mismo
+    // punto que next():
+
+    bool filled = true;
+
+    for (size_t size : { size_t(0), size_t(1), size_t(3), size_t(8), size_t(17), size_t(1000), count - 1 })
+    {
+        Pcg32              batch(42u, 54u);
+        vector< uint32_t > values(size + 1);
+
+        batch.fill (values.data (), size);
+
+        values[size] = batch.next ();
+
+        for (size_t index = 0; index <= size; ++index) filled &= values[index] == sequence[index];
+    }
+
+    check (filled, "fill() matches next() and leaves the generator at the same position");
+
+    // Random_Streams: el mismo subsistema con la misma semilla da la misma secuencia y dos
+    // subsistemas distintos dan secuencias distintas:
+
+    Random_Streams streams(42u), same_streams(42u);
+
+    Pcg32 a = streams.get_stream (ID(audio)), b = same_streams.get_stream (ID(audio)), c = streams.get_stream (ID(pipes));
+
+    uint32_t a_value = a.next (), b_value = b.next (), c_value = c.next ();
+
+    check (a_value == b_value, "the same stream is repeated with the same seed");
+    check (a_value != c_value, "different subsystems get different streams");
+
+    printf ("%s\n", failures ? "random check failed" : "random check passed");
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
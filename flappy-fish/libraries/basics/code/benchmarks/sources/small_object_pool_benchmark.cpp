@@ -0,0 +1,256 @@
+/*
+ * SMALL OBJECT POOL BENCHMARK
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191730
+ */
+
+// Compara Small_Object_Pool con el reservador del sistema (malloc/free) reproduciendo una traza de
+// reservas parecida a la de una sesión de juego:
+//
+//  - Carga de escena: texturas, atlas, assets, programas de shaders y nodos de la caché de recursos
+//    (objetos de 32 a 256 bytes que viven hasta el siguiente cambio de escena).
+//  - Fotogramas: shared_ptr y objetos temporales de 16 a 128 bytes que se liberan en el mismo
+//    fotograma o en el siguiente.
+//  - Cambios de escena periódicos que liberan todo lo cargado y vuelven a cargar.
+//
+// La traza se reproduce en 1 y en 4 hilos (cada hilo con su traza) y al final se muestra la ocupación
+// de la reserva. También se compara std::make_shared con make_pooled.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include <basics/Small_Object_Pool>
+
+using namespace basics;
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+
+    typedef steady_clock Clock;
+
+    struct Operation
+    {
+        uint32_t slot;
+        uint16_t size;
+        bool     allocate;
+    };
+
+    typedef vector< Operation > Trace;
+
+    Trace generate_trace (unsigned seed, unsigned scenes, unsigned frames_per_scene, uint32_t & slot_count)
+    {
+        minstd_rand                       random(seed);
+        uniform_int_distribution< int >   resource_size(2, 16);        // x16 bytes
+        uniform_int_distribution< int >   transient_size(1, 8);        // x16 bytes
+        uniform_int_distribution< int >   transient_count(20, 60);
+
+        Trace              trace;
+        vector< uint32_t > resources;
+        vector< uint32_t > previous_frame;
+        vector< uint32_t > current_frame;
+        vector< uint16_t > sizes;
+
+        slot_count = 0;
+
+        auto allocate = [&] (uint16_t size) -> uint32_t
+        {
+            sizes.push_back (size);
+            trace.push_back ({ slot_count, size, true });
+            return slot_count++;
+        };
+
+        auto release = [&] (uint32_t slot)
+        {
+            trace.push_back ({ slot, sizes[slot], false });
+        };
+
+        for (unsigned scene = 0; scene < scenes; ++scene)
+        {
+            for (uint32_t slot : resources) release (slot);
+
+            resources.clear ();
+
+            for (int resource = 0; resource < 300; ++resource)
+            {
+                resources.push_back (allocate (uint16_t(resource_size (random) * 16)));
+            }
+
+            for (unsigned frame = 0; frame < frames_per_scene; ++frame)
+            {
+                for (uint32_t slot : previous_frame) release (slot);
+
+                previous_frame.clear ();
+
+                for (int count = transient_count (random); count > 0; --count)
+                {
+                    uint32_t slot = allocate (uint16_t(transient_size (random) * 16));
+
+                    // Una parte de los objetos temporales sobrevive hasta el fotograma siguiente:
+
+                    if (random () & 1) release (slot); else current_frame.push_back (slot);
+                }
+
+                previous_frame.swap (current_frame);
+            }
+        }
+
+        for (uint32_t slot : previous_frame) release (slot);
+        for (uint32_t slot : resources     ) release (slot);
+
+        return trace;
+    }
+
+    struct System_Allocator
+    {
+        static void * allocate   (size_t size)          { return malloc (size); }
+        static void   deallocate (void * pointer, size_t) { free (pointer); }
+    };
+
+    struct Pool_Allocator_Backend
+    {
+        static void * allocate   (size_t size)               { return Small_Object_Pool::allocate (size); }
+        static void   deallocate (void * pointer, size_t size) { Small_Object_Pool::deallocate (pointer, size); }
+    };
+
+    template< typename ALLOCATOR >
+    void replay (const Trace & trace, uint32_t slot_count)
+    {
+        vector< void * > slots(slot_count, nullptr);
+
+        for (const Operation & operation : trace)
+        {
+            if (operation.allocate)
+            {
+                char * memory = static_cast< char * >(ALLOCATOR::allocate (operation.size));
+
+                memory[0] = char(operation.slot);           // Se toca la memoria como lo haría un constructor
+
+                slots[operation.slot] = memory;
+            }
+            else
+            {
+                ALLOCATOR::deallocate (slots[operation.slot], operation.size);
+            }
+        }
+    }
+
+    template< typename ALLOCATOR >
+    double measure (const vector< Trace > & traces, const vector< uint32_t > & slot_counts, unsigned thread_count)
+    {
+        Clock::time_point start = Clock::now ();
+
+        vector< thread > threads;
+
+        for (unsigned index = 0; index < thread_count; ++index)
+        {
+            threads.emplace_back ([&, index] () { replay< ALLOCATOR > (traces[index], slot_counts[index]); });
+        }
+
+        for (thread & thread : threads) thread.join ();
+
+        double operations = 0;
+
+        for (unsigned index = 0; index < thread_count; ++index) operations += traces[index].size ();
+
+        return duration< double, nano >(Clock::now () - start).count () / operations;
+    }
+
+    struct Resource
+    {
+        float    data[12];
+        unsigned id;
+    };
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    const unsigned scenes = number_of_arguments > 1 ? unsigned(atoi (arguments[1])) : 20;
+
+    vector< Trace    > traces(4);
+    vector< uint32_t > slot_counts(4);
+
+    for (unsigned index = 0; index < 4; ++index)
+    {
+        traces[index] = generate_trace (index + 1, scenes, 600, slot_counts[index]);
+    }
+
+    printf ("trace: %u scenes x 600 frames, %zu operations per thread (ns per operation)\n\n", scenes, traces[0].size ());
+    printf ("%-24s %10s %10s\n", "", "1 thread", "4 threads");
+
+    double system_1 = measure< System_Allocator       > (traces, slot_counts, 1);
+    double system_4 = measure< System_Allocator       > (traces, slot_counts, 4);
+    double pool_1   = measure< Pool_Allocator_Backend > (traces, slot_counts, 1);
+    double pool_4   = measure< Pool_Allocator_Backend > (traces, slot_counts, 4);
+
+    printf ("%-24s %10.1f %10.1f\n", "malloc/free",       system_1, system_4);
+    printf ("%-24s %10.1f %10.1f\n", "Small_Object_Pool", pool_1,   pool_4  );
+
+    // make_shared frente a make_pooled:
+
+    {
+        const unsigned count = 1000000;
+
+        vector< shared_ptr< Resource > > resources(64);
+
+        Clock::time_point start = Clock::now ();
+
+        for (unsigned index = 0; index < count; ++index) resources[index & 63] = make_shared< Resource > ();
+
+        double shared = duration< double, nano >(Clock::now () - start).count () / count;
+
+        start = Clock::now ();
+
+        for (unsigned index = 0; index < count; ++index) resources[index & 63] = make_pooled< Resource > ();
+
+        double pooled = duration< double, nano >(Clock::now () - start).count () / count;
+
+        printf ("%-24s %10.1f\n%-24s %10.1f\n", "make_shared", shared, "make_pooled", pooled);
+    }
+
+    // Estado de la reserva (todos los objetos de la traza se han liberado, así que lo que se muestra
+    // es la memoria que se conserva para reutilizarla):
+
+    Small_Object_Pool::Stats stats = Small_Object_Pool::get_stats ();
+
+    printf ("\n%10s %10s %10s %10s %10s\n", "block", "reserved", "cached", "free", "used");
+
+    for (const Small_Object_Pool::Class_Stats & class_stats : stats.classes)
+    {
+        if (class_stats.reserved_blocks == 0) continue;
+
+        printf
+        (
+            "%10zu %10zu %10zu %10zu %10zu\n",
+            class_stats.block_size,
+            class_stats.reserved_blocks,
+            class_stats.cached_blocks,
+            class_stats.free_blocks,
+            class_stats.used_blocks
+        );
+    }
+
+    printf
+    (
+        "\nreserved %zu KiB, used %zu KiB, occupancy %.1f%%, fragmentation %.1f%%, large allocations %llu\n",
+        stats.reserved_bytes / 1024,
+        stats.used_bytes     / 1024,
+        stats.occupancy      * 100.f,
+        stats.fragmentation  * 100.f,
+        (unsigned long long)stats.large_allocations
+    );
+
+    return stats.used_bytes == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
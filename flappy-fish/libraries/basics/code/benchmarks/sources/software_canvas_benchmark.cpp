@@ -0,0 +1,231 @@
+/*
+ * SOFTWARE CANVAS BENCHMARK
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+// Mide cuántos sprites por segundo dibuja el rasterizador por software en una superficie de 720x1280
+// (el tamaño del juego) con distinto número de hilos. Cada fotograma borra la superficie y dibuja
+// sprites de 96x96 con textura, posición, giro, escala y volteo aleatorios, igual que lo haría
+// Raster_Canvas. Se mide con muestreo bilineal y con el del texel más cercano, con mezcla por
+// transparencia y con rectángulos de color sólido.
+//
+// También se comprueba que la imagen resultante es idéntica con cualquier número de hilos.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include <basics/software/Rasterizer>
+
+using namespace basics;
+using namespace basics::software;
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+
+    typedef steady_clock Clock;
+
+    struct Sprite
+    {
+        Rasterizer::Point origin;
+        Rasterizer::Point s_axis;
+        Rasterizer::Point t_axis;
+        float             uv[4];
+    };
+
+    Color_Buffer< Rgba8888 > create_texture (unsigned size)
+    {
+        // Un círculo opaco con el borde semitransparente sobre un fondo transparente (como la
+        // mayoría de los sprites del juego):
+
+        Color_Buffer< Rgba8888 > texture(size, size);
+
+        const float radius = size * 0.5f;
+
+        for (unsigned y = 0; y < size; ++y)
+        {
+            for (unsigned x = 0; x < size; ++x)
+            {
+                float dx       = x + 0.5f - radius;
+                float dy       = y + 0.5f - radius;
+                float distance = sqrt (dx * dx + dy * dy);
+                float alpha    = distance < radius - 4.f ? 1.f : distance < radius ? (radius - distance) / 4.f : 0.f;
+
+                texture[y * size + x] = Rgba8888(x * 255 / size) | Rgba8888(y * 255 / size) << 8 | 0x80u << 16 | Rgba8888(alpha * 255.f) << 24;
+            }
+        }
+
+        return texture;
+    }
+
+    vector< Sprite > create_sprites (unsigned count, const Color_Buffer< Rgba8888 > & texture, unsigned width, unsigned height)
+    {
+        minstd_rand                        random(1);
+        uniform_real_distribution< float > x_position(0.f, float(width ));
+        uniform_real_distribution< float > y_position(0.f, float(height));
+        uniform_real_distribution< float > angle     (0.f, 6.2831853f);
+        uniform_real_distribution< float > scale     (0.75f, 1.25f);
+
+        vector< Sprite > sprites(count);
+
+        for (Sprite & sprite : sprites)
+        {
+            float size = 96.f * scale (random);
+            float a    = angle (random);
+            float c    = cos (a) * size;
+            float s    = sin (a) * size;
+            float x    = x_position (random);
+            float y    = y_position (random);
+
+            sprite.s_axis = {  c, s };
+            sprite.t_axis = { -s, c };
+            sprite.origin = { x - (c - s) * 0.5f, y - (s + c) * 0.5f };
+
+            bool flip_horizontal = random () & 1;
+            bool flip_vertical   = random () & 1;
+
+            sprite.uv[0] = flip_horizontal ? float(texture.width ) : 0.f;
+            sprite.uv[1] = flip_vertical   ? 0.f : float(texture.height);
+            sprite.uv[2] = flip_horizontal ? 0.f : float(texture.width );
+            sprite.uv[3] = flip_vertical   ? float(texture.height) : 0.f;
+        }
+
+        return sprites;
+    }
+
+    uint32_t checksum (const Color_Buffer< Rgba8888 > & color_buffer)
+    {
+        uint32_t hash = 2166136261u;
+
+        for (Rgba8888 pixel : color_buffer.buffer) hash = (hash ^ pixel) * 16777619u;
+
+        return hash;
+    }
+
+    struct Result
+    {
+        double   sprites_per_second;
+        uint32_t checksum;
+    };
+
+    Result measure
+    (
+        Rasterizer                     & rasterizer,
+        const vector< Sprite >         & sprites,
+        const Color_Buffer< Rgba8888 > & texture,
+        const Rasterizer::Paint        & paint,
+        bool                             textured,
+        unsigned                         frames
+    )
+    {
+        Clock::time_point start = Clock::now ();
+
+        for (unsigned frame = 0; frame < frames; ++frame)
+        {
+            rasterizer.clear (0.2f, 0.4f, 0.8f);
+
+            for (const Sprite & sprite : sprites)
+            {
+                if (textured)
+                    rasterizer.fill_parallelogram (sprite.origin, sprite.s_axis, sprite.t_axis, texture, sprite.uv, paint);
+                else
+                    rasterizer.fill_parallelogram (sprite.origin, sprite.s_axis, sprite.t_axis, paint);
+            }
+
+            rasterizer.execute ();
+        }
+
+        double seconds = duration< double >(Clock::now () - start).count ();
+
+        return { double(sprites.size ()) * frames / seconds, checksum (rasterizer.get_color_buffer ()) };
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    const unsigned sprite_count = number_of_arguments > 1 ? unsigned(atoi (arguments[1])) : 2000;
+    const unsigned frames       = number_of_arguments > 2 ? unsigned(atoi (arguments[2])) : 20;
+    const unsigned cores        = max (thread::hardware_concurrency (), 1u);
+
+    Rasterizer               rasterizer(720, 1280);
+    Color_Buffer< Rgba8888 > texture = create_texture (128);
+    vector< Sprite >         sprites = create_sprites (sprite_count, texture, 720, 1280);
+
+    struct Test
+    {
+        const char       * name;
+        Rasterizer::Paint  paint;
+        bool               textured;
+    };
+
+    const Test tests[] =
+    {
+        { "bilinear",   { { 1.f, 1.f, 1.f }, 1.00f, Canvas::TRANSPARENCY, Rasterizer::BILINEAR }, true  },
+        { "nearest",    { { 1.f, 1.f, 1.f }, 1.00f, Canvas::TRANSPARENCY, Rasterizer::NEAREST  }, true  },
+        { "opacity",    { { 1.f, 1.f, 1.f }, 0.50f, Canvas::TRANSPARENCY, Rasterizer::BILINEAR }, true  },
+        { "solid",      { { 1.f, 0.f, 0.f }, 1.00f, Canvas::TRANSPARENCY, Rasterizer::NEAREST  }, false },
+        { "translucent",{ { 1.f, 0.f, 0.f }, 0.50f, Canvas::TRANSPARENCY, Rasterizer::NEAREST  }, false },
+    };
+
+    printf ("%u sprites of 96x96 (x0.75-1.25) on 720x1280, %u frames, %u cores (sprites per second)\n\n", sprite_count, frames, cores);
+    printf ("%-12s", "threads");
+
+    for (unsigned threads = 1; threads <= cores; ++threads) printf (" %12u", threads);
+
+    printf ("\n");
+
+    bool deterministic = true;
+
+    for (const Test & test : tests)
+    {
+        printf ("%-12s", test.name);
+
+        uint32_t reference = 0;
+
+        for (unsigned threads = 1; threads <= cores; ++threads)
+        {
+            rasterizer.set_thread_count (threads);
+
+            Result result = measure (rasterizer, sprites, texture, test.paint, test.textured, frames);
+
+            if (threads == 1) reference = result.checksum;
+
+            deterministic &= result.checksum == reference;
+
+            printf (" %12.0f", result.sprites_per_second);
+            fflush (stdout);
+        }
+
+        printf ("\n");
+    }
+
+    // Siempre se comprueba el resultado con varios hilos aunque el procesador solo tenga uno:
+
+    if (cores < 4)
+    {
+        rasterizer.set_thread_count (1);
+
+        uint32_t reference = measure (rasterizer, sprites, texture, tests[0].paint, true, 1).checksum;
+
+        rasterizer.set_thread_count (4);
+
+        deterministic &= measure (rasterizer, sprites, texture, tests[0].paint, true, 1).checksum == reference;
+    }
+
+    printf ("\nsame image with any number of threads: %s\n", deterministic ? "yes" : "NO");
+
+    return deterministic ? EXIT_SUCCESS : EXIT_FAILURE;
+}
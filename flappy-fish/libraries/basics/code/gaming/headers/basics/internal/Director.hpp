@@ -13,11 +13,23 @@
 #ifndef BASICS_DIRECTOR_HEADER
 #define BASICS_DIRECTOR_HEADER
 
+    #include <future>
     #include <memory>
+    #include <string>
+    #include <vector>
+    #include <basics/Allocation_Tracker>
     #include <basics/declarations>
     #include <basics/Event_Queue>
+    #include <basics/Frame_Arena>
+    #include <basics/Frame_Pacer>
+    #include <basics/Frame_Profiler>
     #include <basics/Graphics_Context>
     #include <basics/Graphics_Resource_Cache>
+    #include <basics/Histogram>
+    #include <basics/Input_Injector>
+    #include <basics/Input_Recording>
+    #include <basics/Random>
+    #include <basics/Touch_History>
     #include <basics/Window>
 
     namespace basics
@@ -27,8 +39,19 @@
         {
         public:
 
+            /**
+             * Function that creates the graphics context of a window. Without a factory (or if the
+             * window has no size) there's no graphics context, so the scenes are updated but never
+             * rendered.
+             */
             typedef bool (* Graphics_Context_Factory) (Window::Accessor & window, Graphics_Resource_Cache * cache);
 
+            enum Replay_Speed
+            {
+                REAL_TIME,                                  ///< Waits for the frame deadlines as in a normal run
+                AS_FAST_AS_POSSIBLE
+            };
+
         public:
 
             static Director & get_instance ()
@@ -59,49 +82,380 @@
             }
             state;
 
+            enum Scene_Change
+            {
+                REPLACE_SCENE,
+                PUSH_SCENE,
+                POP_SCENE
+            };
+
             std::shared_ptr< Scene > current_scene;
             std::shared_ptr< Scene >  target_scene;
+            Scene_Change              scene_change;         ///< What to do with the current scene when it's replaced
+            std::vector< std::shared_ptr< Scene > > scene_stack;   ///< Scenes covered by the current one (the last one is right below it)
+
+            struct
+            {
+                std::shared_ptr< Scene > scene;
+                std::future< void >      preloading;        ///< Scene::preload() running on a worker thread
+                bool                     uploaded = false;
+            }
+            preloaded;                                      ///< Scene being loaded to be run next (see preload_scene())
+
+            Spsc_Event_Queue     event_queue;               ///< Input events (pushed only from the input thread)
+            std::vector< Event > frame_events;              ///< Input events of the current frame once the moves are coalesced
+            std::vector< Event > replay_events;             ///< Events of the current frame read from the recording being replayed
+            Touch_History        touch_history;             ///< Every touch move sample of the current frame
+            bool                 touch_coalescing;
+            Histogram            input_latency;             ///< Microseconds from each input event to the display of the frame that handled it
+
+            Allocation_Tracker::Counters frame_allocations; ///< Allocations made by the Director thread during the last frame displayed
+            uint64_t                     reported_violations;
+            bool                         allocation_checking;
+            const Scene                * render_checked_scene;  ///< Loaded scene whose rendered frames are being counted
+            unsigned                     rendered_frames;       ///< Frames rendered by it (its render is checked after a few)
+
+            Frame_Pacer frame_pacer;
+            Frame_Profiler frame_profiler;                  ///< Only fed when the library is built with the profiler (see is_frame_profiler_enabled())
+            std::string    frame_profile_path;              ///< File into which the profile is dumped when the kernel stops (none if empty)
+            std::string    trace_path;                      ///< File into which the trace is exported while the kernel runs (none if empty)
+            bool        frame_pacing;
+            uint64_t    frame_index;                        ///< Frames run since the kernel was started
+            uint64_t    frame_limit;
 
-            Event_Queue event_queue;
+            Input_Injector  * input_injector;
+            Input_Recording * input_recording;              ///< Recording being filled (if any)
+            Input_Recording * input_replay;                 ///< Recording being played back (if any)
+            Replay_Speed      replay_speed;
+
+            Random_Streams random_streams;                  ///< Generators of the session, derived from its seed
+            Pcg32          random_seeds;                    ///< Stream from which make_random_seed() takes its seeds
 
             float surface_width;
             float surface_height;
+            bool  windowless;                               ///< There's no graphics context factory, so the scenes are only simulated
 
             Graphics_Context_Factory graphics_context_factory;
             Graphics_Resource_Cache  graphics_resource_cache;
 
+            float resource_restoration_budget;              ///< Seconds per frame that can be spent restoring graphics resources
+
         private:
 
             Director();
 
         public:
 
+            /**
+             * Sets the function that creates the graphics context of the window (OpenGL ES by default).
+             * Windows without size (e.g. the headless one with a 0x0 surface) get a
+             * Null_Graphics_Context instead. Without factory (nullptr) no graphics context is created
+             * and the scenes are simulated but never rendered.
+             */
             void set_graphics_context_factory (Graphics_Context_Factory factory)
             {
                 graphics_context_factory = factory;
             }
 
+            /**
+             * Sets the maximum time per frame that can be spent restoring the graphics resources
+             * after the graphics context has been recreated (the rest are restored in later frames).
+             * The resources that the visible scenes need are restored first (see
+             * Scene::prioritize_resources()).
+             */
+            void set_resource_restoration_budget (float seconds)
+            {
+                resource_restoration_budget = seconds;
+            }
+
+            /**
+             * Enables or disables merging the consecutive touch moves of a pointer received during a
+             * frame into a single event carrying the latest position (enabled by default). When enabled
+             * the scene gets at most one touch-moved event per pointer in a row and the intermediate
+             * samples remain available through get_touch_history().
+             */
+            void set_touch_coalescing (bool enabled)
+            {
+                touch_coalescing = enabled;
+            }
+
+            /**
+             * Returns all the touch move samples received during the current frame (in scene coordinates
+             * and in the order they were produced). It's only valid within Scene::handle() and Scene::update().
+             */
+            const Touch_History & get_touch_history () const
+            {
+                return touch_history;
+            }
+
+            /**
+             * Returns the histogram of the input latency: the microseconds elapsed from the moment each
+             * input event was produced (its timestamp) until the frame in which the scene handled it
+             * was handed over to the display by flush_and_display(). Events without a timestamp aren't
+             * measured.
+             */
+            const Histogram & get_input_latency () const
+            {
+                return input_latency;
+            }
+
+            void reset_input_latency ()
+            {
+                input_latency.clear ();
+            }
+
+            /**
+             * Writes the percentiles 50, 95 and 99 of the input latency to the log.
+             */
+            void log_input_latency ();
+
+            /**
+             * Enables or disables the check that the frames don't allocate memory: every allocation
+             * made within Scene::update() or Scene::simulate() once the scene is loaded (see
+             * Scene::is_loaded()) counts as a violation and is reported to the log, and so does every
+             * one made within Scene::render() once the loaded scene has rendered 30 frames with the
+             * current graphics context (before that the driver allocates memory to compile shaders and
+             * set up its state). When the kernel stops the totals are logged with log_allocations(). It only works when the
+             * allocation tracking is compiled in (see Allocation_Tracker), so the handler set with
+             * Allocation_Tracker::set_violation_handler() is called too.
+             * It's enabled by default when the tracking is compiled in (debug builds). The environment
+             * variable BASICS_ALLOCATION_CHECKING ("0" or "1") overrides the default.
+             */
+            void set_allocation_checking (bool enabled)
+            {
+                allocation_checking = enabled;
+            }
+
+            /**
+             * Returns the number of allocations and deallocations made by the Director thread during the
+             * last frame displayed, and the bytes allocated (all of them are 0 if the allocation tracking
+             * isn't compiled in).
+             */
+            const Allocation_Tracker::Counters & get_frame_allocations () const
+            {
+                return frame_allocations;
+            }
+
+            /**
+             * Writes to the log the allocations of the last frame, the totals of every tag and the
+             * statistics of the frame arena.
+             */
+            void log_allocations ();
+
+            /**
+             * Gives access to the frame pacer, which keeps the frame rate requested by the current scene
+             * with Scene::set_frame_rate() (60 fps by default) and measures the frame time jitter.
+             */
+            Frame_Pacer & get_frame_pacer ()
+            {
+                return frame_pacer;
+            }
+
+            /**
+             * Enables or disables waiting for the frame deadlines. When disabled the frames run one
+             * after the other as fast as possible and each one advances the scene by the frame duration
+             * of the scene, so the simulation is the same as at the real rate. It's enabled by default
+             * except in the headless Linux backend.
+             */
+            void set_frame_pacing (bool enabled)
+            {
+                frame_pacing = enabled;
+            }
+
+            bool is_frame_pacing_enabled () const
+            {
+                return frame_pacing;
+            }
+
+            /**
+             * Makes the kernel stop after running the given number of frames (0 means no limit).
+             */
+            void set_frame_limit (uint64_t frames)
+            {
+                frame_limit = frames;
+            }
+
+            /**
+             * Returns the index of the current frame (the frames are counted since the kernel was
+             * started and only the ones in which the scene was active count).
+             */
+            uint64_t get_frame_index () const
+            {
+                return frame_index;
+            }
+
+            /**
+             * Sets the script of synthetic input events that is injected frame by frame (or none if
+             * nullptr). The injector must outlive its use by the Director. As it pushes the events
+             * from the Director thread, there must be no other input thread (as in the headless
+             * backend).
+             */
+            void set_input_injector (Input_Injector * injector)
+            {
+                input_injector = injector;
+            }
+
+            /**
+             * Starts recording into the given recording (or stops if nullptr) the events passed to
+             * the scene in every frame along with the time each frame advances it. A new session seed
+             * is chosen and stored in the recording. Recording stops any replay. The recording must
+             * outlive its use by the Director.
+             */
+            void record_input (Input_Recording * recording);
+
+            /**
+             * Plays back the given recording (or stops if nullptr): from the next frame the scene gets
+             * the recorded events and frame times instead of the real input, and make_random_seed()
+             * returns the same seeds as in the recorded session. The kernel stops once every recorded
+             * frame has been replayed. With AS_FAST_AS_POSSIBLE the frame pacing is ignored.
+             */
+            void replay_input (Input_Recording * recording, Replay_Speed speed = AS_FAST_AS_POSSIBLE);
+
+            bool is_replaying_input () const
+            {
+                return input_replay != nullptr;
+            }
+
+            /**
+             * Returns a new seed for the random generators of the scenes. The seeds are derived from
+             * the seed of the session, so a replayed session gets the same sequence of seeds as the
+             * recorded one.
+             */
+            uint32_t make_random_seed ()
+            {
+                return random_seeds.next ();
+            }
+
+            /**
+             * Gives the independent random generators of the session, one per subsystem (e.g.
+             * get_random_streams ().get_stream (ID(particles))). Like make_random_seed(), they're
+             * derived from the seed of the session, so a replay gets the same numbers.
+             */
+            const Random_Streams & get_random_streams () const
+            {
+                return random_streams;
+            }
+
+            /**
+             * Gives access to the per phase timing of the frames (see Frame_Profiler). When the profiler
+             * is compiled out of the library (see is_frame_profiler_enabled()) it stays empty.
+             * Otherwise the statistics are written to the log every 10 seconds by default, or every
+             * BASICS_FRAME_PROFILER_LOG_INTERVAL seconds if that environment variable is set (0 disables
+             * it), and they're dumped when the kernel stops into the file set with
+             * set_frame_profile_path() or the environment variable BASICS_FRAME_PROFILER_PATH.
+             */
+            Frame_Profiler & get_frame_profiler ()
+            {
+                return frame_profiler;
+            }
+
+            /**
+             * Tells whether the library was built with the frame profiler (BASICS_FRAME_PROFILER_ENABLED,
+             * which is defined by default in debug builds). The layout of the Director is the same either
+             * way, only the measures are compiled out.
+             */
+            static bool is_frame_profiler_enabled ();
+
+            void set_frame_profile_path (const std::string & path)
+            {
+                frame_profile_path = path;
+            }
+
+            /**
+             * Tells whether the library was built with tracing (BASICS_TRACE_ENABLED, which is defined
+             * by default in debug builds, see Trace).
+             */
+            static bool is_tracing_enabled ();
+
+            /**
+             * Sets the file into which the trace (Chrome JSON) is exported while the kernel runs. The
+             * buffers of the threads are emptied into it every few frames, so nothing is lost on long
+             * runs, and it's completed when the kernel stops. By default it's the one given by the
+             * environment variable BASICS_TRACE_PATH. It has no effect when tracing is compiled out.
+             */
+            void set_trace_path (const std::string & path)
+            {
+                trace_path = path;
+            }
+
             Graphics_Context::Accessor lock_graphics_context ();
 
         public:
 
+            /**
+             * Replaces the current scene with a new one in the next frame. The current scene is
+             * finalized and released, while the scenes covered by it (if any) stay in the stack.
+             */
             void run_scene (const std::shared_ptr< Scene > & new_scene);
 
+            /**
+             * Runs a new scene on top of the current one in the next frame. Instead of being destroyed,
+             * the current scene is covered (see Scene::cover()) and kept with its resources, so that
+             * pop_scene() resumes it instantly. If the new scene is an overlay (see
+             * Scene::is_overlay()) the covered one is still rendered below it.
+             */
+            void push_scene (const std::shared_ptr< Scene > & new_scene);
+
+            /**
+             * Finalizes and releases the current scene in the next frame and uncovers the scene below it
+             * in the stack. If there's none, the kernel stops.
+             */
+            void pop_scene ();
+
+            /**
+             * Asks the covered scenes that aren't visible to release their resources (see
+             * Scene::evict()) and frees the graphics resources no longer used. It's called when the
+             * system reports that memory is running low.
+             */
+            void evict_hidden_scenes ();
+
+            /**
+             * Starts loading a scene that will be run later with run_scene() while the current scene
+             * keeps running: its preload() is called on a worker thread and then its upload() is
+             * called after each frame until it returns true. When run_scene() is called with that
+             * scene it replaces the current one in the next frame without a loading stall (if
+             * preload() hasn't finished yet the Director waits for it, and if upload() hasn't
+             * finished the scene must complete it while loading).
+             * Only one scene is preloaded at a time: preloading another one (or nullptr to cancel)
+             * waits for the preload() of the previous one and discards it.
+             */
+            void preload_scene (const std::shared_ptr< Scene > & scene);
+
             void stop ()
             {
                 kernel.exit = kernel.running;
             }
 
+            /**
+             * Queues an input event for the current scene. The queue is lock-free and has a single
+             * producer, so this must only be called from one thread (the input thread). If the scene
+             * doesn't consume the events (e.g. while the app is suspended) the newest ones are discarded.
+             */
             void handle (const Event & event)
             {
                 event_queue.push (event);
             }
 
+            void handle (Event && event)
+            {
+                event_queue.push (std::move (event));
+            }
+
         private:
 
-            void run_kernel ();
-            bool check_scene ();
-            void reset_viewport (Window::Accessor & window);
+            void run_kernel              ();
+            bool check_scene             ();
+            void reset_viewport          (Window::Accessor & window);
+            void simulate                (Scene & scene, float time);
+            void coalesce                (Event & event);
+            void record_input_latency    ();
+            void count_frame_allocations (const Allocation_Tracker::Counters & before);
+            void reset_random_streams    (uint64_t seed);
+            void upload_preloaded_scene  ();
+            void finish_preload          ();
+            void change_scene            (const std::shared_ptr< Scene > & new_scene, Scene_Change change);
+            void render_scenes           (Graphics_Context::Accessor & context);
+            size_t first_visible_scene   () const;
 
         };
 
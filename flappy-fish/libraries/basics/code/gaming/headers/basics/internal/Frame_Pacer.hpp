@@ -0,0 +1,99 @@
+/*
+ *  FRAME PACER
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C2610191430
+ */
+
+#ifndef BASICS_FRAME_PACER_HEADER
+#define BASICS_FRAME_PACER_HEADER
+
+    #include <chrono>
+    #include <basics/Histogram>
+
+    namespace basics
+    {
+
+        /**
+         * Keeps the frames at a steady rate. The frame deadlines are computed from a monotonic clock
+         * as an absolute schedule (each one is one period after the previous, not after the moment the
+         * previous frame ended), so the errors of the individual waits don't accumulate into drift.
+         * Each wait sleeps until shortly before the deadline and then yields until it's reached, because
+         * waking up from a sleep is not precise enough on its own.
+         * When a frame takes longer than a period the missed deadlines are skipped (there's no burst of
+         * frames to catch up) and the time step returned covers all the periods elapsed, so it's always
+         * a whole multiple of the period.
+         */
+        class Frame_Pacer
+        {
+        public:
+
+            typedef std::chrono::steady_clock Clock;
+
+        private:
+
+            Clock::duration   period;
+            Clock::duration   spin_threshold;               ///< Final part of each wait done by yielding instead of sleeping
+            Clock::time_point deadline;
+            Clock::time_point last_frame;
+            bool              started;
+
+            Histogram         jitter;                       ///< Microseconds of difference between each frame interval and its target
+
+        public:
+
+            Frame_Pacer(float frame_rate = 60.f);
+
+        public:
+
+            /**
+             * Sets the target frame rate (e.g. 30, 60, 90 or 120 Hz). The current schedule is kept.
+             */
+            void set_frame_rate (float frame_rate)
+            {
+                if (frame_rate > 0.f) set_frame_duration (1.f / frame_rate);
+            }
+
+            void set_frame_duration (float seconds);
+
+            float get_frame_duration () const
+            {
+                return std::chrono::duration< float >(period).count ();
+            }
+
+            void set_spin_threshold (float seconds)
+            {
+                spin_threshold = std::chrono::duration_cast< Clock::duration > (std::chrono::duration< float >(seconds));
+            }
+
+            const Histogram & get_jitter () const
+            {
+                return jitter;
+            }
+
+        public:
+
+            /**
+             * Starts a new schedule from the next call to wait() (e.g. after the loop has been idle).
+             */
+            void reset ()
+            {
+                started = false;
+            }
+
+            /**
+             * Waits until the deadline of the next frame.
+             * @return The time step of the frame that starts in seconds (a whole number of periods).
+             */
+            float wait ();
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ *  FRAME PROFILER
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C2610191500
+ */
+
+#ifndef BASICS_FRAME_PROFILER_HEADER
+#define BASICS_FRAME_PROFILER_HEADER
+
+    #include <chrono>
+    #include <string>
+    #include <utility>
+    #include <basics/Histogram>
+    #include <basics/Ring_Queue>
+
+    // The profiler is enabled by default in debug builds. It can be forced either way by defining
+    // BASICS_FRAME_PROFILER_ENABLED or BASICS_FRAME_PROFILER_DISABLED:
+
+    #if !defined(BASICS_FRAME_PROFILER_ENABLED) && !defined(BASICS_FRAME_PROFILER_DISABLED) && !defined(NDEBUG)
+        #define BASICS_FRAME_PROFILER_ENABLED
+    #endif
+
+    namespace basics
+    {
+
+        /**
+         * Phases of a frame of the Director (in the order they run).
+         */
+        enum class Frame_Phase : unsigned
+        {
+            EVENTS,                                         ///< Polling of the application and window events
+            INPUT,                                          ///< Dispatch of the input events to the scene
+            UPDATE,                                         ///< Scene::update() and the fixed simulation steps
+            RENDER,                                         ///< Restoration of graphics resources and Scene::render()
+            DISPLAY,                                        ///< Graphics_Context::flush_and_display()
+            FRAME,                                          ///< Whole frame (the sum of the previous ones)
+            COUNT
+        };
+
+        /**
+         * Measures how long each phase of every frame takes. Each frame is stored in a lock-free ring
+         * (so that another thread can read the latest frames with drain_frames()) and each phase is
+         * accumulated in a Histogram. The statistics can be written to the log periodically and dumped
+         * into a file.
+         * The Director always has one (so its layout doesn't depend on the build settings), but it
+         * only feeds it when the library is built with BASICS_FRAME_PROFILER_ENABLED, so the measures
+         * don't generate any code otherwise.
+         */
+        class Frame_Profiler
+        {
+        public:
+
+            typedef std::chrono::steady_clock Clock;
+
+            static constexpr unsigned phase_count = unsigned(Frame_Phase::COUNT);
+
+            struct Frame
+            {
+                uint32_t index;
+                uint32_t microseconds[phase_count];
+            };
+
+        private:
+
+            Spsc_Ring_Queue< Frame, 512 > frames;
+            Histogram                     histograms[phase_count];
+
+            Frame                         current;
+            Clock::time_point             frame_start;
+            Clock::time_point             lap_start;
+            Clock::time_point             last_log;
+            Clock::duration               log_interval;
+
+        public:
+
+            Frame_Profiler();
+
+        public:
+
+            /**
+             * Sets every how many seconds the statistics are written to the log (0 disables it).
+             */
+            void set_log_interval (float seconds)
+            {
+                log_interval = std::chrono::duration_cast< Clock::duration > (std::chrono::duration< float >(seconds));
+            }
+
+            const Histogram & get_histogram (Frame_Phase phase) const
+            {
+                return histograms[unsigned(phase)];
+            }
+
+            /**
+             * Delivers to the callback the frames recorded since the previous call (the ring keeps up
+             * to 512 frames; the following ones are discarded until it's read). It can be called from
+             * a thread other than the one running the Director, but only from one thread.
+             * @param callback Callable object with the signature void(const Frame &).
+             */
+            template< typename CALLBACK >
+            size_t drain_frames (CALLBACK && callback)
+            {
+                return frames.drain (std::forward< CALLBACK > (callback));
+            }
+
+            void reset ();
+
+        public:
+
+            void begin_frame ()
+            {
+                lap_start = frame_start = Clock::now ();
+            }
+
+            /**
+             * Closes the measure of a phase (it started when the previous one ended).
+             */
+            void end_phase (Frame_Phase phase)
+            {
+                Clock::time_point now = Clock::now ();
+
+                current.microseconds[unsigned(phase)] = microseconds_between (lap_start, now);
+
+                lap_start = now;
+            }
+
+            void end_frame ();
+
+        public:
+
+            /**
+             * Writes the percentiles 50, 95 and 99 of each phase to the log.
+             */
+            void log () const;
+
+            /**
+             * Writes the statistics of each phase and the frames pending in the ring (one per line,
+             * comma separated) into a text file.
+             */
+            bool dump (const std::string & path);
+
+        private:
+
+            static uint32_t microseconds_between (Clock::time_point start, Clock::time_point end)
+            {
+                return uint32_t(std::chrono::duration_cast< std::chrono::microseconds > (end - start).count ());
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * INPUT INJECTOR
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#ifndef BASICS_INPUT_INJECTOR_HEADER
+#define BASICS_INPUT_INJECTOR_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Event>
+
+    namespace basics
+    {
+
+        /**
+         * Script of synthetic input events, each one scheduled for a frame index. Once it's set with
+         * Director::set_input_injector() the Director injects at the start of every active frame the
+         * events due in that frame, as if they had come from the input thread, so that the scenes
+         * can be driven without a device (e.g. by the headless Linux backend).
+         * The touch coordinates are in surface pixels with the origin at the top left corner, like
+         * the ones produced by a touch screen.
+         */
+        class Input_Injector
+        {
+
+            struct Scheduled_Event
+            {
+                uint64_t frame;
+                Event    event;
+            };
+
+            std::vector< Scheduled_Event > events;          ///< Sorted by frame (in insertion order within a frame)
+            size_t                         next;            ///< First event not injected yet
+
+        public:
+
+            Input_Injector() : next(0)
+            {
+            }
+
+        public:
+
+            void add (uint64_t frame, const Event & event);
+
+            void touch_started (uint64_t frame, float x, float y, int32_t pointer_id = 0)
+            {
+                add (frame, Event(ID(touch-started), Event::Touch{ pointer_id, x, y }));
+            }
+
+            void touch_moved (uint64_t frame, float x, float y, int32_t pointer_id = 0)
+            {
+                add (frame, Event(ID(touch-moved), Event::Touch{ pointer_id, x, y }));
+            }
+
+            void touch_ended (uint64_t frame, float x, float y, int32_t pointer_id = 0)
+            {
+                add (frame, Event(ID(touch-ended), Event::Touch{ pointer_id, x, y }));
+            }
+
+            /**
+             * Schedules a touch start and its end a number of frames later at the same position.
+             */
+            void tap (uint64_t frame, float x, float y, unsigned frames = 1, int32_t pointer_id = 0)
+            {
+                touch_started (frame,          x, y, pointer_id);
+                touch_ended   (frame + frames, x, y, pointer_id);
+            }
+
+            void key_pressed (uint64_t frame, int32_t key_code)
+            {
+                add (frame, Event(ID(key-pressed), Event::Key{ key_code, 0 }));
+            }
+
+            void key_released (uint64_t frame, int32_t key_code)
+            {
+                add (frame, Event(ID(key-released), Event::Key{ key_code, 0 }));
+            }
+
+            /**
+             * Removes every scheduled event.
+             */
+            void clear ()
+            {
+                events.clear ();
+
+                next = 0;
+            }
+
+            /**
+             * Starts injecting the events again from the first one (which makes it possible to play
+             * the same script on several runs).
+             */
+            void rewind ()
+            {
+                next = 0;
+            }
+
+            bool is_finished () const
+            {
+                return next == events.size ();
+            }
+
+        public:
+
+            /**
+             * Passes to the Director the events scheduled for the given frame or for the previous
+             * ones that haven't been injected yet. Their timestamp is set to the current time.
+             */
+            void inject (uint64_t frame);
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * INPUT RECORDING
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192300
+ */
+
+#ifndef BASICS_INPUT_RECORDING_HEADER
+#define BASICS_INPUT_RECORDING_HEADER
+
+    #include <cstdint>
+    #include <string>
+    #include <vector>
+    #include <basics/Event>
+
+    namespace basics
+    {
+
+        /**
+         * Compact binary log of a session: the events passed to Scene::handle() in every frame, the
+         * time each frame advanced the scene and the seed from which the Director derives the seeds
+         * of the random generators (see Director::make_random_seed()). It's filled by the Director
+         * with Director::record_input() and played back with Director::replay_input(), so that the
+         * same session can be run before and after a change to compare the frame times.
+         *
+         * Only the frames whose events or time differ from the previous frame take space (a few
+         * bytes each). The properties of the custom events aren't recorded.
+         */
+        class Input_Recording
+        {
+        public:
+
+            static constexpr uint32_t magic       = 0x31524942;     ///< "BIR1" in little endian
+            static constexpr size_t   header_size = 4 + 8 + 8;      ///< Magic, seed and frame count
+
+        private:
+
+            std::vector< uint8_t > data;                    ///< Frame records (without the header)
+            uint64_t               seed;
+            uint64_t               frame_count;             ///< Frames recorded (including the ones without record)
+
+            uint64_t               first_frame;             ///< Director frame index of the first frame recorded or replayed
+            bool                   started;
+            uint64_t               last_frame;              ///< Frame of the last record written or read
+            float                  last_time;
+            size_t                 read_position;
+
+        public:
+
+            Input_Recording()
+            {
+                clear ();
+            }
+
+        public:
+
+            /**
+             * Discards the recorded frames.
+             */
+            void clear ();
+
+            /**
+             * Restarts the playback from the first frame.
+             */
+            void rewind ();
+
+            uint64_t get_seed () const
+            {
+                return seed;
+            }
+
+            uint64_t get_frame_count () const
+            {
+                return frame_count;
+            }
+
+            /**
+             * Returns the size in bytes of the recording once saved.
+             */
+            size_t get_size () const
+            {
+                return header_size + data.size ();
+            }
+
+        public:
+
+            bool save (const std::string & path) const;
+
+            /**
+             * Loads a recording saved with save() from a file.
+             */
+            bool load (const std::string & path);
+
+            /**
+             * Loads a recording saved with save() from the assets of the application.
+             */
+            bool load_asset (const std::string & path);
+
+            void serialize   (std::vector< uint8_t > & buffer) const;
+            bool deserialize (const std::vector< uint8_t > & buffer);
+
+        public:
+
+            /**
+             * Discards the recorded frames and starts a new recording with the given seed.
+             */
+            void begin_recording (uint64_t new_seed);
+
+            /**
+             * Adds the events handled in a frame and the time it advanced the scene. The frames must
+             * be added in order (frame is the index given by the Director and is stored relative to
+             * the first frame added).
+             */
+            void record_frame (uint64_t frame, float time, const std::vector< Event > & events);
+
+            /**
+             * Appends to events the events recorded for the given frame and sets time to the time
+             * that frame advanced the scene. The frames are matched relative to the first frame
+             * replayed since the last rewind().
+             */
+            void replay_frame (uint64_t frame, float & time, std::vector< Event > & events);
+
+            /**
+             * Returns true once every recorded frame before the given one has been replayed.
+             */
+            bool is_replay_finished (uint64_t frame) const
+            {
+                return started && frame - first_frame >= frame_count;
+            }
+
+        private:
+
+            void write_varint (uint64_t value);
+            void write_signed (int64_t  value);
+            void write_float  (float    value);
+
+            bool read_varint  (uint64_t & value);
+            bool read_signed  (int64_t  & value);
+            bool read_float   (float    & value);
+
+        };
+
+    }
+
+#endif
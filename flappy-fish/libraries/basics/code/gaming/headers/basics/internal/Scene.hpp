@@ -22,15 +22,25 @@
 
         class Scene
         {
+            friend class Director;
+
         private:
 
-            float frame_duration;
+            float    frame_duration;
+            float    simulation_step;                       ///< Seconds per fixed simulation step (0 if disabled)
+            unsigned max_simulation_steps;                  ///< Maximum number of steps that can be run in a frame to catch up
+            float    simulation_time;                       ///< Time accumulated that hasn't been simulated yet
+            float    interpolation_alpha;
 
         public:
 
             Scene()
             {
-                frame_duration = -1.f;
+                frame_duration       = -1.f;
+                simulation_step      =  0.f;
+                max_simulation_steps =  4;
+                simulation_time      =  0.f;
+                interpolation_alpha  =  1.f;
             }
 
             virtual ~Scene() = default;
@@ -44,10 +54,68 @@
 
             virtual void handle     (Event & event) { }
             virtual void update     (float time) { }
+            virtual void simulate   (float step) { }
             virtual void render     (Graphics_Context::Accessor & context) { }
 
             virtual Size2u get_view_size () = 0;
 
+            /**
+             * Tells whether the scene has finished loading its resources. Scenes that load along several
+             * frames must return false meanwhile so that the Director doesn't check that their frames
+             * are free of memory allocations (see Director::set_allocation_checking()).
+             */
+            virtual bool is_loaded () const { return true; }
+
+            /**
+             * Loads the resources of the scene that don't need the graphics context: reads the assets,
+             * decodes the images, parses the data... When the scene is preloaded (see
+             * Director::preload_scene()) the Director calls it from a worker thread while the current
+             * scene keeps running, so it mustn't use the Director nor the graphics context. It's
+             * called before initialize(). Scenes that aren't preloaded may call it while loading.
+             */
+            virtual void preload () { }
+
+            /**
+             * Creates the graphics resources of the scene from what preload() left ready (e.g. uploads
+             * the decoded images as textures). When the scene is preloaded the Director calls it on its
+             * thread, after each frame of the current scene, until it returns true, so the work can be
+             * spread over several frames.
+             */
+            virtual bool upload (Graphics_Context::Accessor & context) { return true; }
+
+            /**
+             * Called when another scene is pushed on top of this one (see Director::push_scene()). The
+             * scene stays in memory with its resources, but it gets no events nor updates until
+             * uncover() is called when the scene on top is popped. It's only rendered while the scenes
+             * on top of it are overlays.
+             */
+            virtual void cover   () { }
+            virtual void uncover () { }
+
+            /**
+             * Tells whether the scene is drawn on top of the scene below it in the stack (e.g. a pause
+             * menu over the game). The Director renders the visible covered scenes first, so an overlay
+             * mustn't clear the canvas.
+             */
+            virtual bool is_overlay () const { return false; }
+
+            /**
+             * Called on the covered scenes that aren't visible when the system runs low on memory (see
+             * Director::evict_hidden_scenes()). The scene should release the resources it can load
+             * again (textures, atlases, fonts...) and reload them after uncover().
+             */
+            virtual void evict () { }
+
+            /**
+             * Called when the graphics context has been created again (e.g. after the app returned
+             * from the background), before its resources start being restored along the following
+             * frames (see Director::set_resource_restoration_budget()). The Director first lowers every
+             * cached resource to Graphics_Resource::NORMAL and then calls this method on the visible
+             * scenes, which should raise to Graphics_Resource::HIGH the priority of the textures and
+             * shaders they need to draw their next frame, so that those are restored first.
+             */
+            virtual void prioritize_resources () { }
+
         public:
 
             bool set_frame_rate (int fps)
@@ -60,6 +128,46 @@
                 return frame_duration;
             }
 
+            /**
+             * Enables the fixed step simulation: after update() the Director calls simulate() with a
+             * constant step as many times as needed to keep up with the time elapsed, regardless of the
+             * frame rate (e.g. 120 Hz simulation with 60 Hz rendering). A rate of 0 disables it.
+             */
+            bool set_simulation_rate (int steps_per_second)
+            {
+                if (steps_per_second < 0) return false;
+
+                simulation_step = steps_per_second > 0 ? 1.f / float(steps_per_second) : 0.f;
+                simulation_time = 0.f;
+
+                return true;
+            }
+
+            float get_simulation_step () const
+            {
+                return simulation_step;
+            }
+
+            /**
+             * Sets how many simulation steps can be run in a single frame at most. When a frame takes
+             * longer than that, the simulation falls behind (it slows down) instead of spending even
+             * more time catching up in the next frames.
+             */
+            void set_max_simulation_steps (unsigned steps)
+            {
+                max_simulation_steps = steps > 0 ? steps : 1;
+            }
+
+            /**
+             * Returns the fraction of a simulation step elapsed since the last one (between 0 and 1).
+             * It's meant for render() to interpolate between the previous and the current simulated
+             * states so that the motion is smooth when both rates differ.
+             */
+            float get_interpolation_alpha () const
+            {
+                return interpolation_alpha;
+            }
+
         };
 
     }
@@ -0,0 +1,202 @@
+/*
+ * SPRITE STRESS SCENE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192200
+ */
+
+#ifndef BASICS_SPRITE_STRESS_SCENE_HEADER
+#define BASICS_SPRITE_STRESS_SCENE_HEADER
+
+    #include <chrono>
+    #include <memory>
+    #include <string>
+    #include <vector>
+    #include <basics/Atlas>
+    #include <basics/Id>
+    #include <basics/Random>
+    #include <basics/Raster_Font>
+    #include <basics/Scene>
+
+    namespace basics
+    {
+
+        /**
+         * Scene that measures how many sprites the current Canvas backend can draw within a frame
+         * budget (1/60 s by default). It draws N moving, rotating, scaled and flipped sprites taken
+         * from the slices of an atlas, plus a text with N and the frame time, and it ramps N up step
+         * by step until the average frame time of a step exceeds the budget. A first step without
+         * sprites measures the frame time of the rest of the frame.
+         * The frame time is the time between consecutive frames, so it includes the display of the
+         * frame. The frame pacing of the Director and the swap synchronization of the graphics
+         * context are disabled while the scene is running.
+         * When the ramp finishes the result is written to the log and can be read with get_report().
+         * Then the Director is stopped (see set_stop_when_done()) or the scene keeps drawing the
+         * maximum number of sprites found.
+         */
+        class Sprite_Stress_Scene : public Scene
+        {
+        public:
+
+            struct Step
+            {
+                unsigned sprites;
+                float    frame_time;                        ///< Average seconds per frame
+            };
+
+            struct Report
+            {
+                Id                  backend;                ///< Id of the graphics context (e.g. ID(opengles))
+                bool                complete;               ///< Whether the ramp finished
+                unsigned            max_sprites;            ///< Most sprites drawn within the budget
+                float               seconds_per_sprite;     ///< Slope of the frame time along the ramp
+                float               base_frame_time;        ///< Frame time without sprites (measured before the ramp)
+                std::vector< Step > steps;
+            };
+
+        private:
+
+            typedef std::chrono::steady_clock Clock;
+
+            struct Sprite
+            {
+                const Atlas::Slice * slice;
+                float                x, y;
+                float                speed_x, speed_y;
+                float                angle;
+                float                spin;
+                float                scale;
+                int                  flip;
+            };
+
+            enum State
+            {
+                LOADING,
+                RAMPING,
+                FINISHED,
+                ERROR
+            };
+
+        private:
+
+            std::string                          atlas_path;
+            std::vector< Id >                    slice_ids;
+            std::string                          font_path;
+
+            std::unique_ptr< Atlas >             atlas;
+            std::unique_ptr< Raster_Font >       font;
+            std::vector< const Atlas::Slice * >  slices;
+
+            State                                state;
+            bool                                 suspended;
+            bool                                 previous_frame_pacing;
+            bool                                 stop_when_done;
+            unsigned                             canvas_width;
+            unsigned                             canvas_height;
+
+            float                                frame_budget;
+            unsigned                             initial_sprites;
+            float                                growth;
+            unsigned                             max_sprites;
+            unsigned                             warmup_frames;
+            unsigned                             frames_per_step;
+
+            std::vector< Sprite >                sprites;
+            Pcg32                                random;
+
+            unsigned                             step_sprites;      ///< Sprites drawn in the current step
+            unsigned                             step_frame;        ///< Frames run in the current step
+            double                               step_time;         ///< Seconds accumulated in the current step
+            float                                last_frame_time;
+            Clock::time_point                    last_frame_start;
+            bool                                 timing;
+
+            Report                               report;
+
+        public:
+
+            /**
+             * @param atlas_path Path of the atlas whose slices are drawn.
+             * @param slice_ids Ids of the slices of the atlas that are drawn (cycling through them).
+             * @param font_path Path of the Raster_Font used to draw the text (none if empty).
+             */
+            Sprite_Stress_Scene(const std::string & atlas_path, const std::vector< Id > & slice_ids, const std::string & font_path = std::string());
+
+        public:
+
+            void set_frame_budget (float seconds)
+            {
+                frame_budget = seconds;
+            }
+
+            /**
+             * Sets the number of sprites of the first step, the factor by which it grows in each
+             * step and the number beyond which the ramp stops even if the budget is never exceeded.
+             */
+            void set_ramp (unsigned initial, float growth_factor, unsigned maximum)
+            {
+                initial_sprites = initial > 0 ? initial : 1;
+                growth          = growth_factor > 1.f ? growth_factor : 1.25f;
+                max_sprites     = maximum;
+            }
+
+            /**
+             * Sets how many frames each step lasts. The first warmup frames of each step aren't
+             * measured.
+             */
+            void set_step_frames (unsigned warmup, unsigned measured)
+            {
+                warmup_frames   = warmup;
+                frames_per_step = measured > 0 ? measured : 1;
+            }
+
+            /**
+             * Makes the scene stop the Director when the ramp finishes (this is the default).
+             */
+            void set_stop_when_done (bool stop)
+            {
+                stop_when_done = stop;
+            }
+
+            const Report & get_report () const
+            {
+                return report;
+            }
+
+        public:
+
+            Size2u get_view_size () override
+            {
+                return { canvas_width, canvas_height };
+            }
+
+            bool is_loaded () const override
+            {
+                return state != LOADING;
+            }
+
+            bool initialize () override;
+            void finalize   () override;
+            void suspend    () override;
+            void resume     () override;
+
+            void update     (float time) override;
+            void render     (Graphics_Context::Accessor & context) override;
+
+        private:
+
+            void load         ();
+            void measure      ();
+            void spawn        (unsigned count);
+            void finish_ramp  (bool complete);
+
+        };
+
+    }
+
+#endif
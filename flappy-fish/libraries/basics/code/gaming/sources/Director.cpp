@@ -10,26 +10,126 @@
  * C1801072305
  */
 
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <future>
+#include <thread>
 #include <basics/Application>
 #include <basics/Director>
 #include <basics/Log>
+#include <basics/Null_Graphics_Context>
+#include <basics/Null_Rendering>
 #include <basics/Scene>
 #include <basics/Timer>
+#include <basics/Trace>
 #include <basics/Window>
+#include <basics/enable>
 #include <basics/opengles/Canvas_ES2>
 #include <basics/opengles/Context>
 
 namespace basics
 {
 
+    namespace
+    {
+
+        uint64_t make_session_seed ()
+        {
+            return uint64_t(std::time (nullptr)) ^ uint64_t(Timer::get_monotonic_time ());
+        }
+
+        // The layout of Director doesn't depend on whether the profiler is built, only this file does:
+
+        #if defined(BASICS_FRAME_PROFILER_ENABLED)
+            constexpr bool frame_profiling = true;
+        #else
+            constexpr bool frame_profiling = false;
+        #endif
+
+        #if defined(BASICS_TRACE_ENABLED)
+            constexpr bool tracing = true;
+        #else
+            constexpr bool tracing = false;
+        #endif
+
+        // Frames between the exports of the trace buffers (each frame adds a few records per thread,
+        // far less than Trace::records_per_thread):
+
+        constexpr uint64_t trace_export_interval = 30;
+
+        // Frames that a scene renders before its render is checked for allocations. The first ones
+        // make the graphics driver compile shaders and build its internal state (e.g. the shader JIT
+        // of Mesa), which allocates memory that isn't the scene's:
+
+        constexpr unsigned render_checking_delay = 30;
+
+        bool allocation_checking_by_default ()
+        {
+            // The frames are checked whenever the allocation tracking is compiled in (debug builds),
+            // unless the environment variable BASICS_ALLOCATION_CHECKING says otherwise ("0" or "1"):
+
+            const char * checking = std::getenv ("BASICS_ALLOCATION_CHECKING");
+
+            return checking && *checking ? *checking != '0' : Allocation_Tracker::enabled;
+        }
+    }
+
     Director & director = Director::get_instance ();
 
     // ---------------------------------------------------------------------------------------------
 
     Director::Director()
     {
-        kernel.running           = false;
-        graphics_context_factory = opengles::Context::create;
+        kernel.running              = false;
+        scene_change                = REPLACE_SCENE;
+        graphics_context_factory    = opengles::Context::create;
+        resource_restoration_budget = 0.004f;
+        touch_coalescing            = true;
+        frame_allocations           = Allocation_Tracker::Counters();
+        reported_violations         = 0;
+        allocation_checking         = allocation_checking_by_default ();
+        render_checked_scene        = nullptr;
+        rendered_frames             = 0;
+        frame_index                 = 0;
+        frame_limit                 = 0;
+        input_injector              = nullptr;
+        input_recording             = nullptr;
+        input_replay                = nullptr;
+        replay_speed                = AS_FAST_AS_POSSIBLE;
+        windowless                  = false;
+        surface_width               = 0.f;
+        surface_height              = 0.f;
+
+        if (frame_profiling)
+        {
+            // The profile is logged and dumped as the environment says (see get_frame_profiler()):
+
+            const char * interval = std::getenv ("BASICS_FRAME_PROFILER_LOG_INTERVAL");
+            const char * path     = std::getenv ("BASICS_FRAME_PROFILER_PATH");
+
+            frame_profiler.set_log_interval (interval && *interval ? float(std::atof (interval)) : 10.f);
+
+            if (path) frame_profile_path = path;
+        }
+
+        if (tracing)
+        {
+            const char * path = std::getenv ("BASICS_TRACE_PATH");
+
+            if (path) trace_path = path;
+        }
+
+        #if defined(BASICS_LINUX_OS)
+            frame_pacing            = false;            // The headless backend runs at full speed
+        #else
+            frame_pacing            = true;
+        #endif
+
+        reset_random_streams (make_session_seed ());
+
+        frame_events .reserve (event_queue.capacity ());
+        replay_events.reserve (event_queue.capacity ());
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -48,11 +148,76 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
+    bool Director::is_frame_profiler_enabled ()
+    {
+        return frame_profiling;
+    }
+
+    bool Director::is_tracing_enabled ()
+    {
+        return tracing;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::record_input (Input_Recording * recording)
+    {
+        input_recording = recording;
+
+        if (recording)
+        {
+            input_replay = nullptr;
+            reset_random_streams (make_session_seed ());
+
+            recording->begin_recording (random_streams.get_seed ());
+        }
+    }
+
+    void Director::replay_input (Input_Recording * recording, Replay_Speed speed)
+    {
+        input_replay = recording;
+        replay_speed = speed;
+
+        if (recording)
+        {
+            input_recording = nullptr;
+            reset_random_streams (recording->get_seed ());
+
+            recording->rewind ();
+        }
+    }
+
+    void Director::reset_random_streams (uint64_t seed)
+    {
+        random_streams = Random_Streams(seed);
+        random_seeds   = random_streams.get_stream (ID(seeds));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     void Director::run_scene (const std::shared_ptr< Scene > & new_scene)
+    {
+        change_scene (new_scene, REPLACE_SCENE);
+    }
+
+    void Director::push_scene (const std::shared_ptr< Scene > & new_scene)
+    {
+        change_scene (new_scene, PUSH_SCENE);
+    }
+
+    void Director::pop_scene ()
+    {
+        target_scene.reset ();
+
+        scene_change = POP_SCENE;
+    }
+
+    void Director::change_scene (const std::shared_ptr< Scene > & new_scene, Scene_Change change)
     {
         if (new_scene)
         {
             target_scene = new_scene;
+            scene_change = change;
 
             if (!kernel.running)
             {
@@ -65,12 +230,112 @@ namespace basics
         }
     }
 
+    void Director::evict_hidden_scenes ()
+    {
+        BASICS_TRACE_SCOPE("Director::evict_hidden_scenes");
+
+        size_t first_visible = first_visible_scene ();
+
+        for (size_t index = 0; index < first_visible; ++index)
+        {
+            scene_stack[index]->evict ();
+        }
+
+        // The textures released by the scenes are still kept by the graphics context:
+
+        Graphics_Context::Accessor context = lock_graphics_context ();
+
+        if (context) context->release_unused_resources ();
+    }
+
+    size_t Director::first_visible_scene () const
+    {
+        // The scenes below an overlay are visible down to the first one that isn't an overlay:
+
+        size_t index   = scene_stack.size ();
+        bool   overlay = current_scene && current_scene->is_overlay ();
+
+        while (overlay && index > 0)
+        {
+            overlay = scene_stack[--index]->is_overlay ();
+        }
+
+        return index;
+    }
+
+    void Director::render_scenes (Graphics_Context::Accessor & context)
+    {
+        // The visible covered scenes are rendered first (from the bottom up) without being updated:
+
+        for (size_t index = first_visible_scene (); index < scene_stack.size (); ++index)
+        {
+            scene_stack[index]->render (context);
+        }
+
+        current_scene->render (context);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::preload_scene (const std::shared_ptr< Scene > & scene)
+    {
+        if (scene == preloaded.scene) return;
+
+        finish_preload ();
+
+        if (scene)
+        {
+            // The worker gets a plain pointer so that the scene is always released by this thread:
+
+            Scene * preloading_scene = scene.get ();
+
+            preloaded.scene      = scene;
+            preloaded.uploaded   = false;
+            preloaded.preloading = std::async
+            (
+                std::launch::async,
+                [preloading_scene]
+                {
+                    BASICS_TRACE_THREAD_NAME("preload");
+
+                    preloading_scene->preload ();
+                }
+            );
+        }
+    }
+
+    void Director::upload_preloaded_scene ()
+    {
+        // The upload starts once preload() has finished and it's done on this thread because the
+        // graphics context can only be used from it:
+
+        if (preloaded.preloading.wait_for (std::chrono::seconds(0)) != std::future_status::ready) return;
+
+        Graphics_Context::Accessor context = lock_graphics_context ();
+
+        if (context)
+        {
+            BASICS_TRACE_SCOPE("Scene::upload");
+
+            preloaded.uploaded = preloaded.scene->upload (context);
+        }
+    }
+
+    void Director::finish_preload ()
+    {
+        if (preloaded.preloading.valid ()) preloaded.preloading.get ();
+
+        preloaded.scene.reset ();
+        preloaded.uploaded = false;
+    }
+
     // ---------------------------------------------------------------------------------------------
 
     void Director::run_kernel ()
     {
         kernel.running = true;
         kernel.exit    = false;
+        frame_index    = 0;
 
         Window::Handle window_handle;
 
@@ -82,26 +347,93 @@ namespace basics
         float time = 1.f / 60.f;
         Event event;
 
+        BASICS_TRACE_THREAD_NAME("director");
+
+        if (tracing && trace_path.size () && !Trace::begin_export (trace_path))
+        {
+            log.w ("The trace couldn't be written to ", trace_path);
+        }
+
         do
         {
-            Timer timer;
-            bool  reset_canvas = false;
+            BASICS_TRACE_SCOPE("Director::frame");
+
+            // The memory reserved in the frame arena two frames ago is released:
+
+            frame_arena.begin_frame ();
+
+            bool reset_canvas = false;
+            bool displayed    = false;
 
             // Check if the current scene must be replaced:
 
-            if (target_scene)
+            if (target_scene || scene_change == POP_SCENE)
             {
-                // If the current scene must be replaced, then it is first finalized:
+                BASICS_TRACE_SCOPE("Director::change_scene");
 
-                if (current_scene) current_scene->finalize ();
+                // If the new scene was preloaded, its preload() must have finished before it's used:
+
+                if (target_scene && target_scene == preloaded.scene) finish_preload ();
+
+                bool released = false;
+
+                if (current_scene)
+                {
+                    if (scene_change == PUSH_SCENE)
+                    {
+                        // If a scene is pushed on top of the current one, the current one is kept:
+
+                        current_scene->cover ();
+
+                        scene_stack.push_back (current_scene);
+                    }
+                    else
+                    {
+                        // If the current scene must be replaced, then it is first finalized:
+
+                        current_scene->finalize ();
+
+                        released = true;
+                    }
+                }
 
                 // And then possibly destroyed:
 
                 current_scene.reset ();
 
-                // The new scene is then initialized:
+                // The graphics resources that only the released scene used are freed:
 
-                if (target_scene->initialize ())
+                if (released)
+                {
+                    Graphics_Context::Accessor context = lock_graphics_context ();
+
+                    if (context) context->release_unused_resources ();
+                }
+
+                // The new scene is then initialized or, when popping, the scene below is uncovered:
+
+                bool         ready  = false;
+                Scene_Change change = scene_change;
+
+                if (scene_change == POP_SCENE)
+                {
+                    if (!scene_stack.empty ())
+                    {
+                        target_scene = scene_stack.back ();
+
+                        scene_stack.pop_back ();
+
+                        target_scene->uncover ();
+
+                        ready = true;
+                    }
+                }
+                else
+                    ready = target_scene->initialize ();
+
+                scene_change = REPLACE_SCENE;
+
+                if (ready)
                 {
                     // If the initialization succeeded, then it is made current:
 
@@ -115,16 +447,33 @@ namespace basics
 
                     if (state) current_scene->resume (); else current_scene->suspend ();
 
-                    // Initialize the frame time limit:
+                    // A new frame schedule is started with the frame rate of the scene:
+
+                    float frame_duration = current_scene->get_frame_duration ();
 
-                    time = current_scene->get_frame_duration ();
+                    frame_pacer.set_frame_duration (frame_duration > 0.f ? frame_duration : 1.f / 60.f);
+                    frame_pacer.reset ();
 
-                    if (time <= 0.f) time = 1.f / 60.f;
+                    time = frame_pacer.get_frame_duration ();
 
-                    reset_canvas = true;
+                    // Only a replaced scene starts with a clean canvas: the scenes of the stack share
+                    // it and the uncovered scene continues where it left it:
+
+                    reset_canvas = change == REPLACE_SCENE;
                 }
             }
 
+            // The scene being preloaded uploads its resources between the frames of the current one:
+
+            if (preloaded.scene && !preloaded.uploaded && current_scene && state)
+            {
+                upload_preloaded_scene ();
+            }
+
+            if (frame_profiling) frame_profiler.begin_frame ();
+
+            Allocation_Tracker::Counters allocations_before = Allocation_Tracker::get_thread_counters ();
+
             bool previously_active = state;
 
             while (application.poll (event))
@@ -149,22 +498,62 @@ namespace basics
 
                         Window::Accessor window = window_handle.lock ();
 
-                        if (graphics_context_factory)
+                        // A window without size (e.g. the headless one without offscreen surface)
+                        // can't have a real graphics context. It gets a Null_Graphics_Context instead,
+                        // so that the scenes load their resources and run as usual without drawing:
+
+                        Graphics_Context_Factory factory = graphics_context_factory;
+
+                        if (factory && (window->get_width () == 0 || window->get_height () == 0))
+                        {
+                            enable< Null_Rendering > ();
+
+                            factory = Null_Graphics_Context::create;
+                        }
+
+                        windowless = !factory;
+
+                        if (!windowless)
                         {
                             if (!window->has_graphics_context ())
                             {
-                                if (!graphics_context_factory (window, &graphics_resource_cache))
+                                if (!factory (window, &graphics_resource_cache))
                                 {
                                     log.e ("ERROR: failed to initialize the OpenGL ES context!");
 
                                     return;
                                 }
+
+                                // The cached resources are restored along the following frames, first
+                                // the ones that the visible scenes need to draw:
+
+                                graphics_resource_cache.set_priority (Graphics_Resource::NORMAL);
+
+                                for (size_t index = first_visible_scene (); index < scene_stack.size (); ++index)
+                                {
+                                    scene_stack[index]->prioritize_resources ();
+                                }
+
+                                if (current_scene) current_scene->prioritize_resources ();
+
+                                Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+
+                                if (graphics_context) graphics_context->initialize ();
+
+                                // The driver of the new context warms up again before the render is checked:
+
+                                rendered_frames = 0;
                             }
 
                             reset_viewport (window);
-
-                            state.graphics = true;
                         }
+                        else
+                        {
+                            surface_width  = float(window->get_width  ());
+                            surface_height = float(window->get_height ());
+                        }
+
+                        state.graphics = true;
 
                         break;
                     }
@@ -184,6 +573,14 @@ namespace basics
                         break;
                     }
 
+                    case Application::Event_Id::SQUEEZE:
+                    {
+                        // The system is running low on memory:
+
+                        evict_hidden_scenes ();
+                        break;
+                    }
+
                     case Application::Event_Id::QUIT:
                     {
                         kernel.exit = true;
@@ -210,6 +607,8 @@ namespace basics
                         }
                     }
 
+                    if (frame_profiling) frame_profiler.end_phase (Frame_Phase::EVENTS);
+
                     if (current_scene)
                     {
                         bool  currently_active = state;
@@ -217,40 +616,118 @@ namespace basics
                         if (!previously_active &&  currently_active) current_scene->resume  (); else
                         if ( previously_active && !currently_active) current_scene->suspend ();
 
+                        // The covered scenes follow the state of the app too:
+
+                        for (auto & scene : scene_stack)
+                        {
+                            if (!previously_active &&  currently_active) scene->resume  (); else
+                            if ( previously_active && !currently_active) scene->suspend ();
+                        }
+
                         if (currently_active)
                         {
                             Size2u scene_view_size = current_scene->get_view_size ();
 
-                            float  h_ratio = float(scene_view_size.width ) / surface_width;
-                            float  v_ratio = float(scene_view_size.height) / surface_height;
+                            // Without a surface the touch coordinates are relative to the scene view size:
+
+                            float  width   = surface_width  > 0.f ? surface_width  : float(scene_view_size.width );
+                            float  height  = surface_height > 0.f ? surface_height : float(scene_view_size.height);
+                            float  h_ratio = float(scene_view_size.width ) / width;
+                            float  v_ratio = float(scene_view_size.height) / height;
+
+                            if (input_injector) input_injector->inject (frame_index);
 
-                            while (event_queue.poll (event))
                             {
-                                switch (event.id)
+                                BASICS_TRACE_SCOPE("Director::dispatch_input");
+
+                                // The pending input events are collected in a single batch:
+
+                                frame_events .clear ();
+                                touch_history.clear ();
+
+                                if (input_replay)
                                 {
-                                    case ID(touch-started):
-                                    case ID(touch-moved):
-                                    case ID(touch-ended):
-                                    {
-                                        float x = *event.properties[ID(x)].as< var::Float > ();
-                                        float y = *event.properties[ID(y)].as< var::Float > ();
-
-                                        event.properties[ID(x)] = x * h_ratio;
-                                        event.properties[ID(y)] = (surface_height - y) * v_ratio;
-
-                                        break;
-                                    }
+                                    // The real input is discarded and the recorded events (already in
+                                    // scene coordinates) are passed instead:
+
+                                    event_queue.drain ([] (Event & ) { });
+
+                                    replay_events.clear ();
+
+                                    input_replay->replay_frame (frame_index, time, replay_events);
+
+                                    for (Event & event : replay_events) coalesce (event);
+                                }
+                                else
+                                {
+                                    event_queue.drain
+                                    (
+                                        [&] (Event & event)
+                                        {
+                                            // The touch coordinates are converted from surface coordinates
+                                            // to the virtual coordinates used by the scene:
+
+                                            if (event.type == Event::TOUCH)
+                                            {
+                                                Event::Touch & touch = event.touch ();
+
+                                                touch.x = touch.x * h_ratio;
+                                                touch.y = (height - touch.y) * v_ratio;
+                                            }
+
+                                            coalesce (event);
+                                        }
+                                    );
+
+                                    if (input_recording) input_recording->record_frame (frame_index, time, frame_events);
                                 }
 
-                                current_scene->handle (event);
+                                BASICS_TRACE_COUNTER("input events", frame_events.size ());
+
+                                for (Event & event : frame_events)
+                                {
+                                    current_scene->handle (event);
+                                }
                             }
 
-                            current_scene->update (time);
+                            if (frame_profiling) frame_profiler.end_phase (Frame_Phase::INPUT);
+
+                            bool check_allocations = allocation_checking && current_scene->is_loaded ();
+
+                            // The count of frames rendered starts again with each scene (and with each
+                            // graphics context, see WINDOW_CREATED):
+
+                            if (!check_allocations || current_scene.get () != render_checked_scene)
+                            {
+                                render_checked_scene = check_allocations ? current_scene.get () : nullptr;
+                                rendered_frames      = 0;
+                            }
+
+                            bool check_render = check_allocations && rendered_frames >= render_checking_delay;
+
+                            {
+                                BASICS_TRACE_SCOPE("Scene::update");
+
+                                Allocation_Tracker::Forbid forbid_allocations(check_allocations);
+
+                                current_scene->update (time);
+
+                                simulate (*current_scene, time);
+                            }
+
+                            if (frame_profiling) frame_profiler.end_phase (Frame_Phase::UPDATE);
 
                             Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
 
                             if (graphics_context)
                             {
+                                if (graphics_context->has_pending_resources ())
+                                {
+                                    BASICS_TRACE_SCOPE("Graphics_Context::restore_resources");
+
+                                    graphics_context->restore_resources (resource_restoration_budget);
+                                }
+
                                 if (reset_canvas)
                                 {
                                     Canvas * canvas = graphics_context->get_renderer< Canvas > (ID(canvas));
@@ -258,19 +735,118 @@ namespace basics
                                     if (canvas) canvas->reset_state ();
                                 }
 
-                                current_scene->render (graphics_context);
+                                {
+                                    BASICS_TRACE_SCOPE("Scene::render");
+
+                                    Allocation_Tracker::Forbid forbid_allocations(check_render);
+
+                                    render_scenes (graphics_context);
+                                }
 
-                                graphics_context->flush_and_display ();
+                                if (check_allocations && rendered_frames < render_checking_delay) rendered_frames++;
+
+                                if (frame_profiling) frame_profiler.end_phase (Frame_Phase::RENDER);
+
+                                {
+                                    BASICS_TRACE_SCOPE("Graphics_Context::flush_and_display");
+
+                                    graphics_context->flush_and_display ();
+                                }
+
+                                record_input_latency ();
+
+                                if (frame_profiling) frame_profiler.end_phase (Frame_Phase::DISPLAY);
+
+                                displayed = true;
+                            }
+                            else
+                            if (windowless)
+                            {
+                                // Without graphics context the frame ends after the update:
+
+                                record_input_latency ();
+
+                                displayed = true;
                             }
                         }
                     }
                 }
             }
 
-            time = timer.get_elapsed_seconds ();
+            if (displayed)
+            {
+                if (frame_profiling) frame_profiler.end_frame ();
+
+                count_frame_allocations (allocations_before);
+
+                // The trace buffers are emptied into the file before they fill up:
+
+                if (tracing && Trace::is_exporting () && frame_index % trace_export_interval == 0)
+                {
+                    Trace::export_pending ();
+                }
+
+                // The scene may change its frame rate at any moment:
+
+                float frame_duration = current_scene->get_frame_duration ();
+
+                if (frame_duration > 0.f) frame_pacer.set_frame_duration (frame_duration);
+
+                if (++frame_index == frame_limit) kernel.exit = true;
+
+                if (input_replay && input_replay->is_replay_finished (frame_index)) kernel.exit = true;
+
+                if (input_replay ? replay_speed == REAL_TIME : frame_pacing)
+                {
+                    BASICS_TRACE_SCOPE("Frame_Pacer::wait");
+
+                    time = frame_pacer.wait ();
+                }
+                else
+                    time = frame_pacer.get_frame_duration ();
+            }
+            else
+            if (!kernel.exit)
+            {
+                // While the scene isn't active or there's no graphics context to render to, the loop
+                // just waits for the events that change that instead of spinning:
+
+                std::this_thread::sleep_for (std::chrono::milliseconds(10));
+
+                frame_pacer.reset ();
+            }
         }
         while (!kernel.exit && current_scene);
 
+        finish_preload ();
+
+        // The totals of the run are reported when the frames have been checked:
+
+        if (allocation_checking && Allocation_Tracker::enabled) log_allocations ();
+
+        if (frame_profiling && frame_profile_path.size ())
+        {
+            if (!frame_profiler.dump (frame_profile_path))
+            {
+                log.w ("The frame profile couldn't be written to ", frame_profile_path);
+            }
+        }
+
+        if (tracing && Trace::is_exporting ())
+        {
+            size_t discards = Trace::get_discarded_count ();
+
+            if (!Trace::end_export ())
+            {
+                log.w ("The trace couldn't be written to ", trace_path);
+            }
+            else
+            if (discards > 0)
+            {
+                log.w ("The trace lost ", discards, " records because the buffer of their thread was full");
+            }
+        }
+
         if (current_scene)
         {
             current_scene->finalize ();
@@ -278,11 +854,190 @@ namespace basics
             current_scene.reset ();
         }
 
+        // The covered scenes are finalized from the top down:
+
+        while (!scene_stack.empty ())
+        {
+            scene_stack.back ()->finalize ();
+            scene_stack.pop_back ();
+        }
+
+        scene_change = REPLACE_SCENE;
+
+        // The window created by the kernel (along with its graphics context) is destroyed by it too:
+
+        if (Window::can_be_instantiated)
+        {
+            Window::destroy_window (default_window_id);
+        }
+
         kernel.running = false;
     }
 
     // ---------------------------------------------------------------------------------------------
 
+    void Director::simulate (Scene & scene, float time)
+    {
+        if (scene.simulation_step > 0.f)
+        {
+            scene.simulation_time += time;
+
+            unsigned steps = 0;
+
+            while (scene.simulation_time >= scene.simulation_step && steps < scene.max_simulation_steps)
+            {
+                scene.simulate (scene.simulation_step);
+
+                scene.simulation_time -= scene.simulation_step;
+
+                ++steps;
+            }
+
+            // If the steps couldn't keep up the time left behind is dropped:
+
+            if (scene.simulation_time >= scene.simulation_step)
+            {
+                scene.simulation_time = std::fmod (scene.simulation_time, scene.simulation_step);
+            }
+
+            scene.interpolation_alpha = scene.simulation_time / scene.simulation_step;
+        }
+        else
+        {
+            scene.interpolation_alpha = 1.f;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::coalesce (Event & event)
+    {
+        if (event.type == Event::TOUCH && event.id == ID(touch-moved))
+        {
+            const Event::Touch & touch = event.touch ();
+
+            touch_history.add ({ touch.pointer_id, touch.x, touch.y, event.timestamp });
+
+            if (touch_coalescing)
+            {
+                // If the latest event of the same pointer queued in this frame is also a move, it
+                // just takes the new position (the number of events queued is small because the
+                // moves are merged as they arrive):
+
+                for (size_t index = frame_events.size (); index-- > 0; )
+                {
+                    Event & pending = frame_events[index];
+
+                    if (pending.type == Event::TOUCH && pending.touch ().pointer_id == touch.pointer_id)
+                    {
+                        if (pending.id == ID(touch-moved))
+                        {
+                            pending.payload   = event.payload;
+                            pending.timestamp = event.timestamp;
+
+                            return;
+                        }
+
+                        break;
+                    }
+                }
+            }
+        }
+
+        frame_events.push_back (std::move (event));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::record_input_latency ()
+    {
+        int64_t now = Timer::get_monotonic_time ();
+
+        for (const Event & event : frame_events)
+        {
+            if (event.timestamp > 0 && event.timestamp <= now)
+            {
+                input_latency.add (uint64_t(now - event.timestamp) / 1000);
+            }
+        }
+
+        // The events are discarded so that they aren't measured again if the next frame isn't displayed:
+
+        frame_events.clear ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::log_input_latency ()
+    {
+        log.i
+        (
+            "Input latency (", input_latency.count (), " events): p50 ",
+            input_latency.percentile (50) / 1000.0, " ms, p95 ",
+            input_latency.percentile (95) / 1000.0, " ms, p99 ",
+            input_latency.percentile (99) / 1000.0, " ms, max ",
+            input_latency.max        (  ) / 1000.0, " ms"
+        );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::count_frame_allocations (const Allocation_Tracker::Counters & before)
+    {
+        Allocation_Tracker::Counters after = Allocation_Tracker::get_thread_counters ();
+
+        frame_allocations.allocations   = after.allocations   - before.allocations;
+        frame_allocations.deallocations = after.deallocations - before.deallocations;
+        frame_allocations.bytes         = after.bytes         - before.bytes;
+
+        BASICS_TRACE_COUNTER("allocations", frame_allocations.allocations);
+
+        uint64_t violations = Allocation_Tracker::get_violation_count ();
+
+        if (violations != reported_violations)
+        {
+            log.w
+            (
+                "The scene allocated memory ", violations - reported_violations,
+                " times during update or render (", frame_allocations.bytes, " bytes in the frame)"
+            );
+
+            reported_violations = violations;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::log_allocations ()
+    {
+        log.i
+        (
+            "Allocations in the last frame: ", frame_allocations.allocations,
+            " (", frame_allocations.bytes, " bytes), deallocations: ", frame_allocations.deallocations
+        );
+
+        for (unsigned index = 0, count = Allocation_Tracker::get_tag_count (); index < count; ++index)
+        {
+            Allocation_Tracker::Counters counters = Allocation_Tracker::get_tag_counters (index);
+
+            log.i
+            (
+                "  ", Allocation_Tracker::get_tag_name (index), ": ", counters.allocations, " allocations, ",
+                counters.live_bytes, " bytes live, ", counters.peak_bytes, " bytes peak"
+            );
+        }
+
+        Frame_Arena::Stats arena = frame_arena.get_stats ();
+
+        log.i
+        (
+            "Frame arena: ", arena.capacity, " bytes per buffer, ", arena.high_water_mark,
+            " bytes high-water mark, ", arena.overflows, " overflows"
+        );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     void Director::reset_viewport (Window::Accessor & window)
     {
         Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
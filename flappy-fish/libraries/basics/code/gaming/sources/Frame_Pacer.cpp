@@ -0,0 +1,101 @@
+/*
+ * FRAME PACER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191430
+ */
+
+#include <thread>
+#include <basics/Frame_Pacer>
+
+namespace basics
+{
+
+    using std::chrono::duration;
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::milliseconds;
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Pacer::Frame_Pacer(float frame_rate)
+    :
+        spin_threshold(duration_cast< Clock::duration >(milliseconds(2))),
+        started(false)
+    {
+        set_frame_duration (frame_rate > 0.f ? 1.f / frame_rate : 1.f / 60.f);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Pacer::set_frame_duration (float seconds)
+    {
+        if (seconds > 0.f)
+        {
+            period = duration_cast< Clock::duration > (duration< float >(seconds));
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    float Frame_Pacer::wait ()
+    {
+        Clock::time_point now = Clock::now ();
+
+        if (!started)
+        {
+            started    = true;
+            deadline   = now;
+            last_frame = now;
+
+            return get_frame_duration ();
+        }
+
+        deadline += period;
+
+        long periods = 1;
+
+        if (now >= deadline)
+        {
+            // The frame took too long: the deadlines already missed are skipped keeping the phase of
+            // the schedule and the next frame starts right away:
+
+            long missed = long((now - deadline) / period);
+
+            periods  += missed;
+            deadline += period * missed;
+        }
+        else
+        {
+            if (deadline - now > spin_threshold)
+            {
+                std::this_thread::sleep_until (deadline - spin_threshold);
+            }
+
+            while (Clock::now () < deadline)
+            {
+                std::this_thread::yield ();
+            }
+        }
+
+        // The deviation of the actual frame interval from the target one is recorded:
+
+        now = Clock::now ();
+
+        Clock::duration interval = now - last_frame;
+        Clock::duration target   = period * periods;
+        Clock::duration error    = interval > target ? interval - target : target - interval;
+
+        jitter.add (uint64_t(duration_cast< microseconds >(error).count ()));
+
+        last_frame = now;
+
+        return get_frame_duration () * float(periods);
+    }
+
+}
@@ -0,0 +1,149 @@
+/*
+ * FRAME PROFILER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191500
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <basics/Frame_Profiler>
+#include <basics/Log>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        const char * phase_names[] = { "events", "input", "update", "render", "display", "frame" };
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Profiler::Frame_Profiler()
+    {
+        current.index = 0;
+
+        for (auto & time : current.microseconds) time = 0;
+
+        last_log     = Clock::now ();
+        log_interval = Clock::duration::zero ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Profiler::reset ()
+    {
+        for (auto & histogram : histograms) histogram.clear ();
+
+        current.index = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Profiler::end_frame ()
+    {
+        Clock::time_point now = Clock::now ();
+
+        current.microseconds[unsigned(Frame_Phase::FRAME)] = microseconds_between (frame_start, now);
+
+        for (unsigned phase = 0; phase < phase_count; ++phase)
+        {
+            histograms[phase].add (current.microseconds[phase]);
+        }
+
+        frames.push (current);
+
+        // The phases that don't run in the next frame must be measured as zero:
+
+        for (auto & time : current.microseconds) time = 0;
+
+        current.index++;
+
+        if (log_interval > Clock::duration::zero () && now - last_log >= log_interval)
+        {
+            log ();
+
+            last_log = now;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Profiler::log () const
+    {
+        for (unsigned phase = 0; phase < phase_count; ++phase)
+        {
+            const Histogram & histogram = histograms[phase];
+
+            char message[160];
+
+            snprintf
+            (
+                message,
+                sizeof(message),
+                "Frame %-7s (%llu frames): p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms",
+                phase_names[phase],
+                (unsigned long long)histogram.count (),
+                histogram.percentile (50) / 1000.0,
+                histogram.percentile (95) / 1000.0,
+                histogram.percentile (99) / 1000.0,
+                histogram.max        (  ) / 1000.0
+            );
+
+            basics::log.d (message);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Frame_Profiler::dump (const std::string & path)
+    {
+        std::ofstream file(path);
+
+        if (!file) return false;
+
+        file << "phase,frames,mean_us,p50_us,p95_us,p99_us,max_us\n";
+
+        for (unsigned phase = 0; phase < phase_count; ++phase)
+        {
+            const Histogram & histogram = histograms[phase];
+
+            file << phase_names[phase]            << ','
+                 << histogram.count ()            << ','
+                 << histogram.mean  ()            << ','
+                 << histogram.percentile (50)     << ','
+                 << histogram.percentile (95)     << ','
+                 << histogram.percentile (99)     << ','
+                 << histogram.max   ()            << '\n';
+        }
+
+        file << "\nframe";
+
+        for (const char * name : phase_names) file << ',' << name << "_us";
+
+        file << '\n';
+
+        drain_frames
+        (
+            [&file] (const Frame & frame)
+            {
+                file << frame.index;
+
+                for (uint32_t time : frame.microseconds) file << ',' << time;
+
+                file << '\n';
+            }
+        );
+
+        return bool(file);
+    }
+
+}
@@ -0,0 +1,57 @@
+/*
+ * INPUT INJECTOR
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#include <algorithm>
+#include <basics/Director>
+#include <basics/Input_Injector>
+#include <basics/Timer>
+
+namespace basics
+{
+
+    void Input_Injector::add (uint64_t frame, const Event & event)
+    {
+        // The event goes after the ones already scheduled for the same frame:
+
+        auto position = std::upper_bound
+        (
+            events.begin (),
+            events.end   (),
+            frame,
+            [] (uint64_t frame, const Scheduled_Event & scheduled) { return frame < scheduled.frame; }
+        );
+
+        // If it's scheduled before an event already injected it will be injected right away:
+
+        if (size_t(position - events.begin ()) < next) position = events.begin () + next;
+
+        events.insert (position, Scheduled_Event{ frame, event });
+    }
+
+    void Input_Injector::inject (uint64_t frame)
+    {
+        if (next < events.size () && events[next].frame <= frame)
+        {
+            int64_t now = Timer::get_monotonic_time ();
+
+            for ( ; next < events.size () && events[next].frame <= frame; ++next)
+            {
+                Event event = events[next].event;
+
+                event.timestamp = now;
+
+                director.handle (std::move (event));
+            }
+        }
+    }
+
+}
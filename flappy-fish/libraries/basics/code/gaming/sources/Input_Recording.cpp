@@ -0,0 +1,347 @@
+/*
+ * INPUT RECORDING
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192300
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <basics/Asset>
+#include <basics/Input_Recording>
+#include <basics/Timer>
+
+// Format (all the numbers in little endian):
+//
+//   header:  magic (4 bytes), seed (8 bytes), frame count (8 bytes)
+//   frame:   frame delta (varint), events << 1 | time changed (varint), [time (float)], events
+//   event:   id (varint), type (1 byte), payload
+//
+// Touch and key payloads are stored field by field (integers as zigzag varints,
+// floats as their 4 bytes). The frames without events whose time is the same as the one of the
+// previous frame aren't stored.
+
+namespace basics
+{
+
+    void Input_Recording::clear ()
+    {
+        data.clear ();
+
+        seed        = 0;
+        frame_count = 0;
+
+        rewind ();
+    }
+
+    void Input_Recording::rewind ()
+    {
+        first_frame   = 0;
+        started       = false;
+        last_frame    = 0;
+        last_time     = 0.f;
+        read_position = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Input_Recording::save (const std::string & path) const
+    {
+        std::vector< uint8_t > buffer;
+
+        serialize (buffer);
+
+        std::ofstream file(path, std::ios::binary);
+
+        file.write (reinterpret_cast< const char * >(buffer.data ()), std::streamsize(buffer.size ()));
+
+        return bool(file);
+    }
+
+    bool Input_Recording::load (const std::string & path)
+    {
+        std::ifstream file(path, std::ios::binary);
+
+        if (!file) return false;
+
+        std::vector< uint8_t > buffer((std::istreambuf_iterator< char >(file)), std::istreambuf_iterator< char >());
+
+        return deserialize (buffer);
+    }
+
+    bool Input_Recording::load_asset (const std::string & path)
+    {
+        std::shared_ptr< Asset > asset = Asset::open (path);
+
+        std::vector< byte > buffer;
+
+        if (!asset || !asset->good () || !asset->read_all (buffer)) return false;
+
+        return deserialize (std::vector< uint8_t >(buffer.begin (), buffer.end ()));
+    }
+
+    void Input_Recording::serialize (std::vector< uint8_t > & buffer) const
+    {
+        buffer.clear   ();
+        buffer.reserve (get_size ());
+
+        for (unsigned index = 0; index < 4; ++index) buffer.push_back (uint8_t(magic       >> index * 8));
+        for (unsigned index = 0; index < 8; ++index) buffer.push_back (uint8_t(seed        >> index * 8));
+        for (unsigned index = 0; index < 8; ++index) buffer.push_back (uint8_t(frame_count >> index * 8));
+
+        buffer.insert (buffer.end (), data.begin (), data.end ());
+    }
+
+    bool Input_Recording::deserialize (const std::vector< uint8_t > & buffer)
+    {
+        clear ();
+
+        if (buffer.size () < header_size) return false;
+
+        uint64_t header[3] = { 0, 0, 0 };
+
+        for (unsigned index = 0; index < 4; ++index) header[0] |= uint64_t(buffer[     index]) << index * 8;
+        for (unsigned index = 0; index < 8; ++index) header[1] |= uint64_t(buffer[ 4 + index]) << index * 8;
+        for (unsigned index = 0; index < 8; ++index) header[2] |= uint64_t(buffer[12 + index]) << index * 8;
+
+        if (header[0] != magic) return false;
+
+        seed        = header[1];
+        frame_count = header[2];
+
+        data.assign (buffer.begin () + header_size, buffer.end ());
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Input_Recording::begin_recording (uint64_t new_seed)
+    {
+        clear ();
+
+        seed = new_seed;
+
+        // A few minutes of play fit without growing the buffer:
+
+        data.reserve (64 * 1024);
+    }
+
+    void Input_Recording::record_frame (uint64_t frame, float time, const std::vector< Event > & events)
+    {
+        if (!started)
+        {
+            first_frame = frame;
+            started     = true;
+        }
+        else
+        if (events.empty () && std::memcmp (&time, &last_time, sizeof(float)) == 0)
+        {
+            frame_count = frame - first_frame + 1;
+            return;
+        }
+
+        const uint64_t relative_frame = frame - first_frame;
+        const bool     time_changed   = relative_frame == 0 || std::memcmp (&time, &last_time, sizeof(float)) != 0;
+
+        write_varint (relative_frame - last_frame);
+        write_varint (uint64_t(events.size ()) << 1 | (time_changed ? 1 : 0));
+
+        if (time_changed) write_float (time);
+
+        for (const Event & event : events)
+        {
+            write_varint (event.id);
+
+            data.push_back (uint8_t(event.type));
+
+            switch (event.type)
+            {
+                case Event::TOUCH:
+                {
+                    write_signed (event.payload.touch.pointer_id);
+                    write_float  (event.payload.touch.x);
+                    write_float  (event.payload.touch.y);
+                    break;
+                }
+
+                case Event::KEY:
+                {
+                    write_signed (event.payload.key.key_code);
+                    write_signed (event.payload.key.meta_state);
+                    break;
+                }
+
+                case Event::CUSTOM:
+                    break;
+            }
+        }
+
+        last_frame  = relative_frame;
+        last_time   = time;
+        frame_count = relative_frame + 1;
+    }
+
+    void Input_Recording::replay_frame (uint64_t frame, float & time, std::vector< Event > & events)
+    {
+        if (!started)
+        {
+            first_frame = frame;
+            started     = true;
+        }
+
+        const uint64_t relative_frame = frame - first_frame;
+
+        // The frames without record keep the time of the previous one:
+
+        time = last_time;
+
+        if (read_position >= data.size ()) return;
+
+        size_t   record_start = read_position;
+        uint64_t delta;
+
+        if (!read_varint (delta) || last_frame + delta != relative_frame)
+        {
+            read_position = record_start;                   // The record belongs to a later frame
+            return;
+        }
+
+        uint64_t counts;
+
+        if (!read_varint (counts)) return;
+
+        if (counts & 1)
+        {
+            if (!read_float (last_time)) return;
+
+            time = last_time;
+        }
+
+        const int64_t now = Timer::get_monotonic_time ();
+
+        for (uint64_t count = counts >> 1; count > 0; --count)
+        {
+            uint64_t id;
+
+            if (!read_varint (id) || read_position >= data.size ()) return;
+
+            Event event(static_cast< Id >(id));
+
+            event.type      = Event::Type(data[read_position++]);
+            event.timestamp = now;
+
+            int64_t first, second;
+            bool    good = true;
+
+            switch (event.type)
+            {
+                case Event::TOUCH:
+                {
+                    good = read_signed (first) && read_float (event.payload.touch.x) && read_float (event.payload.touch.y);
+
+                    event.payload.touch.pointer_id = int32_t(first);
+                    break;
+                }
+
+                case Event::KEY:
+                {
+                    good = read_signed (first) && read_signed (second);
+
+                    event.payload.key.key_code   = int32_t(first );
+                    event.payload.key.meta_state = int32_t(second);
+                    break;
+                }
+
+                case Event::CUSTOM:
+                    break;
+
+                default:
+                    good = false;
+            }
+
+            if (!good)
+            {
+                read_position = data.size ();               // The rest of the recording is damaged
+                return;
+            }
+
+            events.push_back (std::move (event));
+        }
+
+        last_frame = relative_frame;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Input_Recording::write_varint (uint64_t value)
+    {
+        for ( ; value >= 0x80; value >>= 7)
+        {
+            data.push_back (uint8_t(value | 0x80));
+        }
+
+        data.push_back (uint8_t(value));
+    }
+
+    void Input_Recording::write_signed (int64_t value)
+    {
+        write_varint ((uint64_t(value) << 1) ^ uint64_t(value >> 63));
+    }
+
+    void Input_Recording::write_float (float value)
+    {
+        uint32_t bits;
+
+        std::memcpy (&bits, &value, sizeof(bits));
+
+        for (unsigned index = 0; index < 4; ++index) data.push_back (uint8_t(bits >> index * 8));
+    }
+
+    bool Input_Recording::read_varint (uint64_t & value)
+    {
+        value = 0;
+
+        for (unsigned shift = 0; read_position < data.size () && shift < 64; shift += 7)
+        {
+            uint8_t next = data[read_position++];
+
+            value |= uint64_t(next & 0x7F) << shift;
+
+            if (!(next & 0x80)) return true;
+        }
+
+        return false;
+    }
+
+    bool Input_Recording::read_signed (int64_t & value)
+    {
+        uint64_t encoded;
+
+        if (!read_varint (encoded)) return false;
+
+        value = int64_t(encoded >> 1) ^ -int64_t(encoded & 1);
+
+        return true;
+    }
+
+    bool Input_Recording::read_float (float & value)
+    {
+        if (data.size () - read_position < 4) return false;
+
+        uint32_t bits = 0;
+
+        for (unsigned index = 0; index < 4; ++index) bits |= uint32_t(data[read_position++]) << index * 8;
+
+        std::memcpy (&value, &bits, sizeof(value));
+
+        return true;
+    }
+
+}
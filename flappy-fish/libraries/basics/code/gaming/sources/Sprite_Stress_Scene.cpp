@@ -0,0 +1,329 @@
+/*
+ * SPRITE STRESS SCENE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610192200
+ */
+
+#include <algorithm>
+#include <cwchar>
+#include <basics/Canvas>
+#include <basics/Director>
+#include <basics/Frame_Arena>
+#include <basics/Log>
+#include <basics/Rotation>
+#include <basics/Scaling>
+#include <basics/Sprite_Stress_Scene>
+#include <basics/Text_Layout>
+#include <basics/Translation>
+
+namespace basics
+{
+
+    Sprite_Stress_Scene::Sprite_Stress_Scene(const std::string & atlas_path, const std::vector< Id > & slice_ids, const std::string & font_path)
+    :
+        atlas_path      (atlas_path),
+        slice_ids       (slice_ids ),
+        font_path       (font_path )
+    {
+        state                 = LOADING;
+        suspended             = false;
+        previous_frame_pacing = false;
+        stop_when_done        = true;
+        canvas_width          = 720;
+        canvas_height         = 1280;
+        frame_budget          = 1.f / 60.f;
+        initial_sprites       = 64;
+        growth                = 1.25f;
+        max_sprites           = 1000000;
+        warmup_frames         = 10;
+        frames_per_step       = 60;
+    }
+
+    bool Sprite_Stress_Scene::initialize ()
+    {
+        state           = LOADING;
+        suspended       = false;
+        step_sprites    = 0;                                // The first step measures the frame without sprites
+        step_frame      = 0;
+        step_time       = 0.;
+        last_frame_time = 0.f;
+        timing          = false;
+        report          = Report();
+
+        // The same sprites are generated on every run:
+
+        random.seed (1);
+        sprites.clear ();
+
+        // The frames must run one after the other as fast as possible to measure how long they take:
+
+        previous_frame_pacing = director.is_frame_pacing_enabled ();
+
+        director.set_frame_pacing (false);
+
+        return true;
+    }
+
+    void Sprite_Stress_Scene::finalize ()
+    {
+        director.set_frame_pacing (previous_frame_pacing);
+
+        Graphics_Context::Accessor context = director.lock_graphics_context ();
+
+        if (context) context->set_sync_swap (true);
+
+        // The textures are released while their graphics context still exists:
+
+        sprites.clear ();
+        slices .clear ();
+        font .reset ();
+        atlas.reset ();
+    }
+
+    void Sprite_Stress_Scene::suspend ()
+    {
+        suspended = true;
+        timing    = false;                                  // The time while suspended doesn't count
+    }
+
+    void Sprite_Stress_Scene::resume ()
+    {
+        suspended = false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Stress_Scene::update (float time)
+    {
+        if (state == LOADING)
+        {
+            load ();
+            return;
+        }
+
+        if (state == ERROR || suspended) return;
+
+        // The sprites move bouncing off the edges of the view while they spin:
+
+        const float width  = float(canvas_width );
+        const float height = float(canvas_height);
+        const size_t count = state == RAMPING ? step_sprites : report.max_sprites;
+
+        for (size_t index = 0; index < count && index < sprites.size (); ++index)
+        {
+            Sprite & sprite = sprites[index];
+
+            sprite.x     += sprite.speed_x * time;
+            sprite.y     += sprite.speed_y * time;
+            sprite.angle += sprite.spin    * time;
+
+            if (sprite.x < 0.f  ) { sprite.x = 0.f;    sprite.speed_x = -sprite.speed_x; } else
+            if (sprite.x > width) { sprite.x = width;  sprite.speed_x = -sprite.speed_x; }
+            if (sprite.y < 0.f   ) { sprite.y = 0.f;    sprite.speed_y = -sprite.speed_y; } else
+            if (sprite.y > height) { sprite.y = height; sprite.speed_y = -sprite.speed_y; }
+        }
+
+        measure ();
+    }
+
+    void Sprite_Stress_Scene::render (Graphics_Context::Accessor & context)
+    {
+        if (suspended || state == LOADING || state == ERROR) return;
+
+        Canvas * canvas = context->get_renderer< Canvas > (ID(canvas));
+
+        if (!canvas)
+        {
+            canvas = Canvas::create (ID(canvas), context, {{ canvas_width, canvas_height }});
+        }
+
+        if (!canvas) return;
+
+        canvas->clear ();
+
+        const size_t count = state == RAMPING ? step_sprites : report.max_sprites;
+
+        for (size_t index = 0; index < count && index < sprites.size (); ++index)
+        {
+            const Sprite & sprite = sprites[index];
+
+            canvas->set_transform (Translation2f(sprite.x, sprite.y) * Rotation2f(sprite.angle) * Scaling2f(sprite.scale));
+            canvas->fill_rectangle ({ 0.f, 0.f }, { sprite.slice->width, sprite.slice->height }, sprite.slice, CENTER | sprite.flip);
+        }
+
+        canvas->set_transform (Transformation2f());
+
+        if (font)
+        {
+            // The number of sprites and the last frame time in microseconds:
+
+            wchar_t text[32];
+
+            int length = swprintf (text, 32, L"%u\n%u", unsigned(count), unsigned(last_frame_time * 1000000.f));
+
+            Text_Layout layout(*font, text, length > 0 ? size_t(length) : 0, frame_arena);
+
+            canvas->draw_text ({ 20.f, float(canvas_height) - 20.f }, layout, TOP | LEFT);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Stress_Scene::load ()
+    {
+        Graphics_Context::Accessor context = director.lock_graphics_context ();
+
+        if (!context) return;
+
+        context->set_sync_swap (false);
+
+        atlas.reset (new Atlas(atlas_path, context));
+
+        slices.clear ();
+
+        if (atlas->good ())
+        {
+            for (Id id : slice_ids)
+            {
+                if (const Atlas::Slice * slice = atlas->get_slice (id)) slices.push_back (slice);
+            }
+        }
+
+        if (slices.empty ())
+        {
+            log.e ("Sprite_Stress_Scene: the atlas ", atlas_path, " couldn't be loaded or has none of the slices.");
+
+            state = ERROR;
+
+            if (stop_when_done) director.stop ();
+
+            return;
+        }
+
+        if (!font_path.empty ())
+        {
+            font.reset (new Raster_Font(font_path, context));
+
+            if (!font->good ()) font.reset ();
+        }
+
+        report.backend = context->get_id ();
+
+        spawn (step_sprites);
+
+        state = RAMPING;
+    }
+
+    void Sprite_Stress_Scene::spawn (unsigned count)
+    {
+        sprites.reserve (count);
+
+        while (sprites.size () < count)
+        {
+            Sprite sprite;
+
+            sprite.slice   = slices[sprites.size () % slices.size ()];
+            sprite.x       = random.next_float () * float(canvas_width );
+            sprite.y       = random.next_float () * float(canvas_height);
+            sprite.speed_x = random.next_float () * 400.f - 200.f;
+            sprite.speed_y = random.next_float () * 400.f - 200.f;
+            sprite.angle   = random.next_float () * 6.2831853f;
+            sprite.spin    = random.next_float () * 6.f - 3.f;
+            sprite.scale   = random.next_float () + 0.5f;
+            sprite.flip    = (random () & 1 ? FLIP_HORIZONTAL : 0) | (random () & 1 ? FLIP_VERTICAL : 0);
+
+            sprites.push_back (sprite);
+        }
+    }
+
+    void Sprite_Stress_Scene::measure ()
+    {
+        Clock::time_point now = Clock::now ();
+
+        if (timing)
+        {
+            last_frame_time = std::chrono::duration< float >(now - last_frame_start).count ();
+
+            if (state == RAMPING)
+            {
+                if (step_frame >= warmup_frames) step_time += last_frame_time;
+
+                if (++step_frame == warmup_frames + frames_per_step)
+                {
+                    float frame_time = float(step_time / frames_per_step);
+
+                    unsigned next;
+
+                    if (step_sprites == 0)
+                    {
+                        // The frame time without sprites is measured before the ramp starts:
+
+                        report.base_frame_time = frame_time;
+
+                        next = initial_sprites;
+                    }
+                    else
+                    {
+                        report.steps.push_back (Step{ step_sprites, frame_time });
+
+                        next = std::max (step_sprites + 1, unsigned(float(step_sprites) * growth));
+                    }
+
+                    if (step_sprites > 0 && frame_time > frame_budget) finish_ramp (true ); else
+                    if (next > max_sprites                           ) finish_ramp (false);
+                    else
+                    {
+                        step_sprites = next;
+                        step_frame   = 0;
+                        step_time    = 0.;
+
+                        spawn (step_sprites);
+                    }
+                }
+            }
+        }
+
+        last_frame_start = now;
+        timing           = true;
+    }
+
+    void Sprite_Stress_Scene::finish_ramp (bool complete)
+    {
+        report.complete    = complete;
+        report.max_sprites = 0;
+
+        // Least squares fit of the time the sprites add to the frame time without sprites, which
+        // was measured (fitting the intercept too extrapolates it, and with noisy steps it can come
+        // out negative):
+
+        double sum_xx = 0., sum_xy = 0.;
+
+        for (const Step & step : report.steps)
+        {
+            if (step.frame_time <= frame_budget) report.max_sprites = std::max (report.max_sprites, step.sprites);
+
+            sum_xx += double(step.sprites) * step.sprites;
+            sum_xy += double(step.sprites) * (step.frame_time - report.base_frame_time);
+        }
+
+        report.seconds_per_sprite = sum_xx > 0. ? std::max (float(sum_xy / sum_xx), 0.f) : 0.f;
+
+        log.i
+        (
+            "Sprite stress: ", complete ? "" : "at least ", report.max_sprites, " sprites within ",
+            frame_budget * 1000.f, " ms, ", report.seconds_per_sprite * 1e9f, " ns per sprite, ",
+            report.base_frame_time * 1000.f, " ms per frame without sprites (", report.steps.size (), " steps)"
+        );
+
+        state = FINISHED;
+
+        if (stop_when_done) director.stop ();
+    }
+
+}
@@ -0,0 +1,44 @@
+/*
+ * OPENGL ES CONTEXT
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include "Offscreen_OpenGL_ES_Context.hpp"
+
+    namespace basics { namespace opengles
+    {
+
+        bool Context::create (basics::Window::Accessor & window, Graphics_Resource_Cache * cache)
+        {
+            if (window && window->is_available () && !window->has_graphics_context ())
+            {
+                Window * target = window.operator -> ();
+
+                std::shared_ptr< Graphics_Context > context
+                (
+                    new basics::opengles::internal::Offscreen_OpenGL_ES_Context(*target, cache)
+                );
+
+                if (context->is_available () && window->set_graphics_context (context))
+                {
+                    return context->make_current ();
+                }
+            }
+
+            return false;
+        }
+
+    }}
+
+#endif
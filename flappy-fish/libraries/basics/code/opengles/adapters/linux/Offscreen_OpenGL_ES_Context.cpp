@@ -0,0 +1,201 @@
+/*
+ * OFFSCREEN OPENGL ES CONTEXT
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+// https://www.khronos.org/registry/EGL/sdk/docs/man/html/eglCreatePbufferSurface.xhtml
+// https://www.khronos.org/registry/EGL/extensions/MESA/EGL_MESA_platform_surfaceless.txt
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <cstring>
+    #include "Offscreen_OpenGL_ES_Context.hpp"
+    #include <EGL/eglext.h>
+
+    #define  EGL_ATTRIBUTE(ATTRIBUTE, VALUE) ATTRIBUTE, VALUE
+
+    namespace basics { namespace opengles { namespace internal
+    {
+
+        Offscreen_OpenGL_ES_Context::Offscreen_OpenGL_ES_Context(Window & window, Graphics_Resource_Cache * cache) : basics::opengles::Context(window, cache)
+        {
+            display        = EGL_NO_DISPLAY;
+            surface        = EGL_NO_SURFACE;
+            context        = EGL_NO_CONTEXT;
+            config         = nullptr;
+            surface_width  = EGLint(window.get_width  ());
+            surface_height = EGLint(window.get_height ());
+            available      = surface_width > 0 && surface_height > 0 && initialize_display () && initialize_surface () && initialize_context ();
+            version        = VERSION_2_0;
+        }
+
+        void Offscreen_OpenGL_ES_Context::finalize ()
+        {
+            Graphics_Context::finalize ();
+
+            available = false;
+
+            if (display != EGL_NO_DISPLAY)
+            {
+                eglMakeCurrent (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+                if (context != EGL_NO_CONTEXT) eglDestroyContext (display, context);
+                if (surface != EGL_NO_SURFACE) eglDestroySurface (display, surface);
+
+                eglTerminate (display);
+
+                display = EGL_NO_DISPLAY;
+                surface = EGL_NO_SURFACE;
+                context = EGL_NO_CONTEXT;
+            }
+        }
+
+        bool Offscreen_OpenGL_ES_Context::is_current () const
+        {
+            return available && eglGetCurrentContext () == context;
+        }
+
+        bool Offscreen_OpenGL_ES_Context::make_current ()
+        {
+            if (available)
+            {
+                return eglMakeCurrent (display, surface, surface, context) == EGL_TRUE;
+            }
+
+            return false;
+        }
+
+        bool Offscreen_OpenGL_ES_Context::flush_and_display ()
+        {
+            if (available)
+            {
+                // No hay nada que presentar, pero se espera a que se termine de dibujar para que el
+                // coste de cada fotograma incluya el de la GPU (o el del rasterizador de Mesa):
+
+                glFinish ();
+
+                return true;
+            }
+
+            return false;
+        }
+
+        void Offscreen_OpenGL_ES_Context::reset_viewport ()
+        {
+            if (available)
+            {
+                glViewport (0, 0, surface_width, surface_height);
+            }
+        }
+
+        void Offscreen_OpenGL_ES_Context::set_viewport (const Point2u & bottom_left, const Size2u & size)
+        {
+            if (available)
+            {
+                glViewport (bottom_left[0], bottom_left[1], size.width, size.height);
+            }
+        }
+
+        bool Offscreen_OpenGL_ES_Context::initialize_display ()
+        {
+            // Se prefiere la plataforma sin pantalla de Mesa y si no está disponible se usa la de
+            // por defecto (que necesita un servidor gráfico):
+
+            const char * extensions = eglQueryString (EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+            if (extensions && strstr (extensions, "EGL_MESA_platform_surfaceless"))
+            {
+                PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display = reinterpret_cast< PFNEGLGETPLATFORMDISPLAYEXTPROC >
+                (
+                    eglGetProcAddress ("eglGetPlatformDisplayEXT")
+                );
+
+                if (get_platform_display)
+                {
+                    display = get_platform_display (EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+                }
+            }
+
+            if (display == EGL_NO_DISPLAY)
+            {
+                display = eglGetDisplay (EGL_DEFAULT_DISPLAY);
+            }
+
+            if (display != EGL_NO_DISPLAY)
+            {
+                EGLint egl_version_major = 0;
+                EGLint egl_version_minor = 0;
+
+                if (eglInitialize (display, &egl_version_major, &egl_version_minor) == EGL_TRUE)
+                {
+                    return eglBindAPI (EGL_OPENGL_ES_API) == EGL_TRUE;
+                }
+
+                display = EGL_NO_DISPLAY;
+            }
+
+            return false;
+        }
+
+        bool Offscreen_OpenGL_ES_Context::initialize_surface ()
+        {
+            const EGLint desired_attributes[] =
+            {
+                EGL_ATTRIBUTE( EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT ),
+                EGL_ATTRIBUTE( EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT    ),
+                EGL_ATTRIBUTE( EGL_RED_SIZE,        8                  ),
+                EGL_ATTRIBUTE( EGL_GREEN_SIZE,      8                  ),
+                EGL_ATTRIBUTE( EGL_BLUE_SIZE,       8                  ),
+                EGL_ATTRIBUTE( EGL_ALPHA_SIZE,      8                  ),
+                EGL_ATTRIBUTE( EGL_DEPTH_SIZE,      0                  ),
+                EGL_NONE
+            };
+
+            EGLint number_of_suitable_configurations = 0;
+
+            if
+            (
+                eglChooseConfig (display, desired_attributes, &config, 1, &number_of_suitable_configurations) &&
+                number_of_suitable_configurations > 0
+            )
+            {
+                const EGLint surface_attributes[] =
+                {
+                    EGL_ATTRIBUTE( EGL_WIDTH,  surface_width  ),
+                    EGL_ATTRIBUTE( EGL_HEIGHT, surface_height ),
+                    EGL_NONE
+                };
+
+                surface = eglCreatePbufferSurface (display, config, surface_attributes);
+
+                return surface != EGL_NO_SURFACE;
+            }
+
+            return false;
+        }
+
+        bool Offscreen_OpenGL_ES_Context::initialize_context ()
+        {
+            const EGLint context_attributes[] =
+            {
+                EGL_ATTRIBUTE( EGL_CONTEXT_CLIENT_VERSION, 2 ),
+                EGL_NONE
+            };
+
+            context = eglCreateContext (display, config, EGL_NO_CONTEXT, context_attributes);
+
+            return context != EGL_NO_CONTEXT;
+        }
+
+    }}}
+
+#endif
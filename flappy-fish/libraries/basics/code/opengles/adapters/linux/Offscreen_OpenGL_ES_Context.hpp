@@ -0,0 +1,110 @@
+/*
+ * OFFSCREEN OPENGL ES CONTEXT
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191800
+ */
+
+#ifndef BASICS_OFFSCREEN_OPENGL_ES_CONTEXT_HEADER
+#define BASICS_OFFSCREEN_OPENGL_ES_CONTEXT_HEADER
+
+    #include <atomic>
+    #include <EGL/egl.h>
+    #include <GLES2/gl2.h>
+    #include <basics/opengles/Context>
+
+    namespace basics { namespace opengles { namespace internal
+    {
+
+        using std::atomic;
+
+        /**
+         * Contexto de OpenGL ES 2 que dibuja en una superficie fuera de pantalla (pbuffer de EGL) del
+         * tamaño de la ventana. Si el driver lo admite se usa la plataforma sin pantalla de Mesa, por
+         * lo que no hace falta ningún servidor gráfico.
+         */
+        class Offscreen_OpenGL_ES_Context final : public opengles::Context
+        {
+
+            EGLDisplay      display;
+            EGLSurface      surface;
+            EGLContext      context;
+            EGLConfig       config;
+
+            atomic< bool >  available;
+
+            EGLint          surface_width;
+            EGLint          surface_height;
+
+        public:
+
+            Offscreen_OpenGL_ES_Context(Window & window, Graphics_Resource_Cache * cache);
+
+           ~Offscreen_OpenGL_ES_Context()
+            {
+                finalize ();
+            }
+
+        public:
+
+            bool is_available () const override
+            {
+                return available;
+            }
+
+            void invalidate () override
+            {
+                available = false;
+            }
+
+            void suspend () override
+            {
+            }
+
+            bool resume () override
+            {
+                return available;
+            }
+
+            void finalize () override;
+
+            bool is_current () const override;
+            bool make_current () override;
+
+            bool set_sync_swap (bool ) override
+            {
+                return false;
+            }
+
+            bool flush_and_display () override;
+
+            unsigned get_surface_width () override
+            {
+                return unsigned(surface_width);
+            }
+
+            unsigned get_surface_height () override
+            {
+                return unsigned(surface_height);
+            }
+
+            void reset_viewport () override;
+
+            void set_viewport (const Point2u & bottom_left, const Size2u & size) override;
+
+        private:
+
+            bool initialize_display ();
+            bool initialize_surface ();
+            bool initialize_context ();
+
+        };
+
+    }}}
+
+#endif
@@ -78,6 +78,8 @@
                 if (initialized)
                 {
                     glDeleteProgram (program_object_id);
+
+                    initialized = false;
                 }
             }
 
@@ -88,11 +90,6 @@
                 return instance_id;
             }
 
-            bool is_usable () const
-            {
-                return initialized;
-            }
-
             void add (const Shader::Source_Code & code)
             {
                 source_code.push_back (code);
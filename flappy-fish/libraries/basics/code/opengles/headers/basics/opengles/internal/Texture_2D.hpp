@@ -42,6 +42,15 @@
                 glBindTexture (GL_TEXTURE_2D, 0);
             }
 
+            /**
+             * Convierte la textura a este tipo si la ha creado este backend o devuelve nullptr. Solo
+             * compara la etiqueta de la textura, así que no usa RTTI.
+             */
+            static const Texture_2D * cast (const basics::Texture_2D * texture)
+            {
+                return texture && texture->get_backend () == ID(opengles2) ? static_cast< const Texture_2D * >(texture) : nullptr;
+            }
+
         private:
 
             Color_Buffer< Rgba8888 > color_buffer;
@@ -51,7 +60,7 @@
 
             Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, unsigned width, unsigned height)
             :
-                basics::Texture_2D(width, height),
+                basics::Texture_2D(width, height, ID(opengles2)),
                 color_buffer      (color_buffer )
             {
             }
@@ -74,14 +83,9 @@
                 if (initialized)
                 {
                     glDeleteTextures (1, &texture_object_id);
-                }
-            }
 
-        public:
-
-            bool is_usable () const
-            {
-                return initialized;
+                    initialized = false;
+                }
             }
 
         public:
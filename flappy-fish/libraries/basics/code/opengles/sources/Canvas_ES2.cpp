@@ -10,6 +10,7 @@
  * C1801091703
  */
 
+#include <basics/Small_Object_Pool>
 #include <basics/Transformation>
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Canvas_ES2>
@@ -98,7 +99,7 @@ namespace basics { namespace opengles
 
     Canvas * Canvas_ES2::create (Id id, Graphics_Context::Accessor & context, const Options & options)
     {
-        std::shared_ptr< Canvas >  canvas(new Canvas_ES2(context, options.size));
+        std::shared_ptr< Canvas >  canvas = make_pooled< Canvas_ES2 > (context, options.size);
 
         context->add (id, canvas);
 
@@ -109,7 +110,7 @@ namespace basics { namespace opengles
     :
         size{ float(size.width), float(size.height) }
     {
-        shader_program_f.reset (new Shader_Program);
+        shader_program_f = make_pooled< Shader_Program > ();
 
         shader_program_f->add (Shader::Source_Code::from_string (internal_vertex_shader_f,   Shader::Source_Code::VERTEX  ));
         shader_program_f->add (Shader::Source_Code::from_string (internal_fragment_shader_f, Shader::Source_Code::FRAGMENT));
@@ -126,7 +127,7 @@ namespace basics { namespace opengles
                opacity_f_id = shader_program_f->get_uniform_id ("opacity"   );
         }
 
-        shader_program_t.reset (new Shader_Program);
+        shader_program_t = make_pooled< Shader_Program > ();
 
         shader_program_t->add (Shader::Source_Code::from_string (internal_vertex_shader_t,   Shader::Source_Code::VERTEX  ));
         shader_program_t->add (Shader::Source_Code::from_string (internal_fragment_shader_t, Shader::Source_Code::FRAGMENT));
@@ -312,8 +313,16 @@ namespace basics { namespace opengles
 
     void Canvas_ES2::fill_rectangle (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling)
     {
-        const opengles::Texture_2D * opengl_es_texture = dynamic_cast< const opengles::Texture_2D * >(texture);
+        const opengles::Texture_2D * opengl_es_texture = opengles::Texture_2D::cast (texture);
 
+        // Si la textura todavía no se ha restaurado tras perder el contexto, se omite el dibujo
+        // y se pide al contexto que la restaure antes que el resto:
+
+        if (opengl_es_texture && !opengl_es_texture->is_usable ())
+        {
+            opengl_es_texture->request ();
+        }
+        else
         if (opengl_es_texture)
         {
                   Point2f   bottom_left;
@@ -374,8 +383,13 @@ namespace basics { namespace opengles
             return;
         }
 
-        const opengles::Texture_2D * opengl_es_texture = dynamic_cast< const opengles::Texture_2D * >(slice->atlas->get_texture ().get ());
+        const opengles::Texture_2D * opengl_es_texture = opengles::Texture_2D::cast (slice->atlas->get_texture ().get ());
 
+        if (opengl_es_texture && !opengl_es_texture->is_usable ())
+        {
+            opengl_es_texture->request ();
+        }
+        else
         if (opengl_es_texture)
         {
             float   horizontal_ratio  = 1.f / opengl_es_texture->get_width  ();
@@ -12,6 +12,8 @@
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Shader_Program>
 #include <basics/opengles/Vertex_Shader>
+#include <basics/Small_Object_Pool>
+#include <basics/Trace>
 
 namespace basics { namespace opengles
 {
@@ -25,6 +27,8 @@ namespace basics { namespace opengles
         {
             if (source_code.size () > 0)
             {
+                BASICS_TRACE_SCOPE("Shader_Program::initialize");
+
                 program_object_id = glCreateProgram ();
 
                 assert(program_object_id != 0);
@@ -35,8 +39,8 @@ namespace basics { namespace opengles
                 {
                     switch (source_code[i].get_type ())
                     {
-                        case Shader::Source_Code::VERTEX:   shaders[i].reset (new   Vertex_Shader(source_code[i])); break;
-                        case Shader::Source_Code::FRAGMENT: shaders[i].reset (new Fragment_Shader(source_code[i])); break;
+                        case Shader::Source_Code::VERTEX:   shaders[i] = make_pooled<   Vertex_Shader > (source_code[i]); break;
+                        case Shader::Source_Code::FRAGMENT: shaders[i] = make_pooled< Fragment_Shader > (source_code[i]); break;
                     }
 
                     if (shaders[i]->compilation_failed ())
@@ -11,6 +11,8 @@
  */
 
 #include <basics/assert>
+#include <basics/Small_Object_Pool>
+#include <basics/Trace>
 #include <basics/opengles/Texture_2D>
 
 namespace basics { namespace opengles
@@ -20,7 +22,7 @@ namespace basics { namespace opengles
 
     std::shared_ptr< basics::Texture_2D > Texture_2D::create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
     {
-        return std::shared_ptr< Texture_2D >(new Texture_2D(color_buffer, options.width, options.height));
+        return make_pooled< Texture_2D > (color_buffer, options.width, options.height);
     }
 
     bool Texture_2D::initialize ()
@@ -29,6 +31,8 @@ namespace basics { namespace opengles
         {
             if (color_buffer.size () > 0)
             {
+                BASICS_TRACE_SCOPE("Texture_2D::initialize");
+
                 glEnable        (GL_TEXTURE_2D);////
                 glGenTextures   (1, &texture_object_id);
                 glBindTexture   (GL_TEXTURE_2D, texture_object_id);
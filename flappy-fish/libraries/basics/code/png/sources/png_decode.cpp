@@ -12,6 +12,7 @@
 
 #include "lodepng.h"
 #include <basics/png_decode>
+#include <basics/Trace>
 
 namespace basics
 {
@@ -24,6 +25,8 @@ namespace basics
         unsigned & height
     )
     {
+        BASICS_TRACE_SCOPE("png_decode");
+
         std::vector< byte > decoded_data;
 
         int error = lodepng::decode
@@ -0,0 +1,47 @@
+/*
+ * SOFTWARE CONTEXT
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_ANDROID_OS)
+
+    #include "Android_Software_Context.hpp"
+    #include "../../../base/adapters/android/Native_Window.hpp"
+
+    namespace basics { namespace software
+    {
+
+        bool Context::create (basics::Window::Accessor & window, Graphics_Resource_Cache * cache)
+        {
+            if (window && window->is_available () && !window->has_graphics_context ())
+            {
+                std::shared_ptr< Graphics_Context > context
+                (
+                    new basics::software::internal::Android_Software_Context
+                    (
+                        *static_cast< basics::internal::Native_Window::Accessor & >(window).get (),
+                         cache
+                    )
+                );
+
+                if (context->is_available () && window->set_graphics_context (context))
+                {
+                    return context->make_current ();
+                }
+            }
+
+            return false;
+        }
+
+    }}
+
+#endif
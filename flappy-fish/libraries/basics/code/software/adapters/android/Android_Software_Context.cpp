@@ -0,0 +1,72 @@
+/*
+ * ANDROID SOFTWARE CONTEXT
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_ANDROID_OS)
+
+    #include <algorithm>
+    #include <cstring>
+    #include <android/native_window.h>
+    #include "Android_Software_Context.hpp"
+    #include "../../../base/adapters/android/Native_Window.hpp"
+
+    namespace basics { namespace software { namespace internal
+    {
+
+        Android_Software_Context::Android_Software_Context(basics::internal::Native_Window & window, Graphics_Resource_Cache * cache)
+        :
+            Context      (window, cache),
+            native_window(window)
+        {
+            // Con ancho y alto 0 el búfer de la ventana conserva su tamaño:
+
+            if (window.get_native_window ())
+            {
+                ANativeWindow_setBuffersGeometry (window.get_native_window (), 0, 0, WINDOW_FORMAT_RGBA_8888);
+            }
+        }
+
+        bool Android_Software_Context::present ()
+        {
+            // La ventana nativa puede cambiar al volver de segundo plano, por lo que se consulta
+            // en cada fotograma:
+
+            ANativeWindow * window = native_window.get_native_window ();
+
+            if (!window) return false;
+
+            ANativeWindow_Buffer buffer;
+
+            if (ANativeWindow_lock (window, &buffer, nullptr) != 0) return false;
+
+            const Color_Buffer< Rgba8888 > & surface = get_surface ();
+
+            const unsigned width  = std::min (surface.width,  unsigned(buffer.width ));
+            const unsigned height = std::min (surface.height, unsigned(buffer.height));
+
+            for (unsigned y = 0; y < height; ++y)
+            {
+                std::memcpy
+                (
+                    static_cast< Rgba8888 * >(buffer.bits) + y * unsigned(buffer.stride),
+                    surface.buffer.data () + y * surface.width,
+                    width * sizeof(Rgba8888)
+                );
+            }
+
+            return ANativeWindow_unlockAndPost (window) == 0;
+        }
+
+    }}}
+
+#endif
@@ -0,0 +1,47 @@
+/*
+ * ANDROID SOFTWARE CONTEXT
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#ifndef BASICS_ANDROID_SOFTWARE_CONTEXT_HEADER
+#define BASICS_ANDROID_SOFTWARE_CONTEXT_HEADER
+
+    #include <basics/software/Context>
+
+    namespace basics { namespace internal
+    {
+        class Native_Window;
+    }}
+
+    namespace basics { namespace software { namespace internal
+    {
+
+        /**
+         * Contexto del rasterizador por software que presenta cada fotograma copiando la superficie
+         * al búfer de la ventana nativa (ANativeWindow_lock() y ANativeWindow_unlockAndPost()).
+         */
+        class Android_Software_Context final : public software::Context
+        {
+
+            basics::internal::Native_Window & native_window;
+
+        public:
+
+            Android_Software_Context(basics::internal::Native_Window & window, Graphics_Resource_Cache * cache);
+
+        protected:
+
+            bool present () override;
+
+        };
+
+    }}}
+
+#endif
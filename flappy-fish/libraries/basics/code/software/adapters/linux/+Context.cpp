@@ -0,0 +1,41 @@
+/*
+ * SOFTWARE CONTEXT
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <basics/software/Context>
+
+    namespace basics { namespace software
+    {
+
+        bool Context::create (basics::Window::Accessor & window, Graphics_Resource_Cache * cache)
+        {
+            if (window && window->is_available () && !window->has_graphics_context ())
+            {
+                // No hay donde presentar la superficie, que se puede leer con get_surface():
+
+                std::shared_ptr< Graphics_Context > context(new Context(*window.operator -> (), cache));
+
+                if (context->is_available () && window->set_graphics_context (context))
+                {
+                    return context->make_current ();
+                }
+            }
+
+            return false;
+        }
+
+    }}
+
+#endif
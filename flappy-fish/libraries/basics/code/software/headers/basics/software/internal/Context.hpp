@@ -0,0 +1,150 @@
+/*
+ * SOFTWARE CONTEXT
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#ifndef BASICS_SOFTWARE_CONTEXT_HEADER
+#define BASICS_SOFTWARE_CONTEXT_HEADER
+
+    #include <atomic>
+    #include <basics/Graphics_Context>
+    #include <basics/Window>
+    #include <basics/software/Rasterizer>
+
+    namespace basics { namespace software
+    {
+
+        /**
+         * Contexto gráfico que dibuja con el Rasterizer en un Color_Buffer< Rgba8888 > del tamaño
+         * de la ventana. Los dibujos se hacen todos juntos en flush_and_display() y después se
+         * llama a present() para mostrar el resultado (en Android se copia a la ventana nativa).
+         */
+        class Context : public basics::Graphics_Context
+        {
+        public:
+
+            static bool create (basics::Window::Accessor & window, Graphics_Resource_Cache * cache);
+
+        protected:
+
+            Rasterizer          rasterizer;
+            std::atomic< bool > available;
+            Point2u             viewport_bottom_left;
+            Size2u              viewport_size;
+            unsigned            viewport_version;           ///< Cambia cada vez que cambia el viewport
+
+        public:
+
+            Context(Window & window, Graphics_Resource_Cache * cache);
+
+           ~Context()
+            {
+                finalize ();
+            }
+
+        public:
+
+            Id get_id () const override
+            {
+                return ID(software);
+            }
+
+            bool is_available () const override
+            {
+                return available;
+            }
+
+            bool is_current () const override
+            {
+                return available;
+            }
+
+            void invalidate () override
+            {
+                available = false;
+            }
+
+            void suspend () override
+            {
+            }
+
+            bool resume () override
+            {
+                return available;
+            }
+
+            bool make_current () override
+            {
+                return available;
+            }
+
+            bool set_sync_swap (bool ) override
+            {
+                return false;
+            }
+
+            unsigned get_surface_width () override
+            {
+                return rasterizer.get_width ();
+            }
+
+            unsigned get_surface_height () override
+            {
+                return rasterizer.get_height ();
+            }
+
+            void reset_viewport () override;
+            void set_viewport   (const Point2u & bottom_left, const Size2u & size) override;
+
+            bool flush_and_display () override;
+
+        public:
+
+            Rasterizer & get_rasterizer ()
+            {
+                return rasterizer;
+            }
+
+            const Color_Buffer< Rgba8888 > & get_surface () const
+            {
+                return rasterizer.get_color_buffer ();
+            }
+
+            const Point2u & get_viewport_bottom_left () const
+            {
+                return viewport_bottom_left;
+            }
+
+            const Size2u & get_viewport_size () const
+            {
+                return viewport_size;
+            }
+
+            unsigned get_viewport_version () const
+            {
+                return viewport_version;
+            }
+
+        protected:
+
+            /**
+             * Muestra el contenido de la superficie una vez dibujado. Por defecto no hace nada
+             * (la superficie se puede leer con get_surface()).
+             */
+            virtual bool present ()
+            {
+                return true;
+            }
+
+        };
+
+    }}
+
+#endif
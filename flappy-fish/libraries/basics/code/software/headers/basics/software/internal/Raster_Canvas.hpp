@@ -0,0 +1,138 @@
+/*
+ * RASTER CANVAS
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#ifndef BASICS_SOFTWARE_RASTER_CANVAS_HEADER
+#define BASICS_SOFTWARE_RASTER_CANVAS_HEADER
+
+    #include <basics/Canvas>
+    #include <basics/Transformation>
+    #include <basics/software/Context>
+    #include <basics/software/Rasterizer>
+
+    namespace basics { namespace software
+    {
+
+        class Texture_2D;
+
+        /**
+         * Canvas que dibuja con el rasterizador por software de un software::Context. Se comporta
+         * como Canvas_ES2 (mismas coordenadas, anclajes, volteos y coordenadas de textura) y además
+         * admite los modos de mezcla y elegir entre muestreo bilineal (por defecto) o del texel
+         * más cercano.
+         */
+        class Raster_Canvas : public basics::Canvas
+        {
+        public:
+
+            static Canvas * create (Id id, Graphics_Context::Accessor & context, const Options & options);
+
+        public:
+
+            static void enable ()
+            {
+                register_factory (ID(software), Raster_Canvas::create);
+            }
+
+        private:
+
+            Context          & context;
+            Rasterizer       & rasterizer;
+
+            Size2f             size;
+            Transformation2f   transform;
+            float              to_pixels[6];                ///< Transformación afín del canvas a los píxeles de la superficie
+            unsigned           viewport_version;
+            float              clear_color[3];
+            Rasterizer::Paint  paint;
+
+        public:
+
+            Raster_Canvas(Context & context, const Size2u & size);
+
+        public:
+
+            void reset_state     () override;
+
+        public:
+
+            void set_size        (const Size2u & size) override;
+
+        public:
+
+            void set_clear_color (float r, float g, float b) override;
+            void set_color       (float r, float g, float b) override;
+            void set_opacity     (float opacity) override;
+            void set_blending    (Blending blending) override;
+            void set_transform   (const Transformation2f & transform) override;
+            void apply_transform (const Transformation2f & transform) override;
+
+            void set_sampling    (Rasterizer::Sampling sampling)
+            {
+                paint.sampling = sampling;
+            }
+
+        public:
+
+            void clear           () override;
+            void draw_point      (const Point2f & position) override;
+            void draw_segment    (const Point2f & a, const Point2f & b) override;
+            void draw_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void fill_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void draw_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling = CENTER) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling = CENTER) override;
+
+        private:
+
+            void update_mapping ();
+
+            Rasterizer::Point to_pixel (float x, float y)
+            {
+                if (viewport_version != context.get_viewport_version ()) update_mapping ();
+
+                return
+                {
+                    to_pixels[0] * x + to_pixels[1] * y + to_pixels[2],
+                    to_pixels[3] * x + to_pixels[4] * y + to_pixels[5]
+                };
+            }
+
+            Rasterizer::Point to_pixel (const Point2f & point)
+            {
+                return to_pixel (point[0], point[1]);
+            }
+
+            Rasterizer::Point to_pixel_vector (float x, float y)
+            {
+                if (viewport_version != context.get_viewport_version ()) update_mapping ();
+
+                return { to_pixels[0] * x + to_pixels[1] * y, to_pixels[3] * x + to_pixels[4] * y };
+            }
+
+            void fill_textured_rectangle
+            (
+                const Point2f    & where,
+                const Size2f     & size,
+                const Texture_2D & texture,
+                float              u_left,
+                float              u_right,
+                float              v_bottom,
+                float              v_top,
+                int                handling
+            );
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,212 @@
+/*
+ * RASTERIZER
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#ifndef BASICS_SOFTWARE_RASTERIZER_HEADER
+#define BASICS_SOFTWARE_RASTERIZER_HEADER
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <cstdint>
+    #include <mutex>
+    #include <thread>
+    #include <vector>
+    #include <basics/Canvas>
+    #include <basics/Color_Buffer>
+    #include <basics/Non_Copyable>
+
+    namespace basics { namespace software
+    {
+
+        /**
+         * Rasterizador por software que dibuja en un Color_Buffer< Rgba8888 > (la fila 0 es la de
+         * arriba). Los dibujos no se hacen al pedirlos, sino que se guardan en una lista de órdenes
+         * y execute() los hace todos a la vez: reparte las órdenes entre celdas de tile_size x
+         * tile_size píxeles y varios hilos rasterizan celdas distintas en paralelo. Cada celda la
+         * dibuja un solo hilo en el orden en que se dieron las órdenes, por lo que el resultado es
+         * el mismo con cualquier número de hilos.
+         * Todas las figuras se rasterizan como la intersección de hasta 4 semiplanos (un triángulo
+         * o un paralelogramo) procesando 4 píxeles a la vez con las extensiones vectoriales de
+         * GCC y Clang, que generan SSE2 en x86 y NEON en ARM.
+         * Las texturas que se usan en las órdenes deben existir hasta que se llame a execute().
+         */
+        class Rasterizer : Non_Copyable
+        {
+        public:
+
+            static constexpr unsigned tile_size = 64;
+
+            typedef Canvas::Blending Blending;
+
+            enum Sampling
+            {
+                NEAREST,
+                BILINEAR
+            };
+
+            struct Point
+            {
+                float x;
+                float y;
+            };
+
+            /**
+             * Estado con el que se dibuja. El color solo se usa en las figuras sin textura y la
+             * opacidad multiplica el alfa de la textura o del color.
+             */
+            struct Paint
+            {
+                float    color[3];
+                float    opacity;
+                Blending blending;
+                Sampling sampling;
+            };
+
+        private:
+
+            enum Type : uint8_t
+            {
+                CLEAR,
+                FILL,
+            };
+
+            // Cada semiplano se define como a * x + b * y + c >= 0 evaluado en el centro de los
+            // píxeles (los triángulos tienen uno que siempre se cumple). Las coordenadas de
+            // textura (en texels) son funciones afines de la posición:
+
+            struct Command
+            {
+                Type                             type;
+                Blending                         blending;
+                Sampling                         sampling;
+                int                              left, top, right, bottom;      ///< Rectángulo envolvente recortado (right y bottom excluidos)
+                float                            edges[4][3];
+                float                            u[3];
+                float                            v[3];
+                float                            color[4];                      ///< En el rango [0, 255]; color[3] es la opacidad en [0, 1]
+                Rgba8888                         packed_color;
+                const Color_Buffer< Rgba8888 > * texture;
+            };
+
+            typedef std::vector< Command  > Command_List;
+            typedef std::vector< uint32_t > Bin;
+
+        private:
+
+            Color_Buffer< Rgba8888 >   color_buffer;
+            Command_List               commands;
+            std::vector< Bin >         bins;
+            unsigned                   tile_columns;
+            unsigned                   tile_rows;
+
+            std::vector< std::thread > workers;
+            std::mutex                 mutex;
+            std::condition_variable    work_available;
+            std::condition_variable    work_done;
+            unsigned                   generation;
+            unsigned                   pending_workers;
+            bool                       stopping;
+            std::atomic< unsigned >    next_tile;
+
+        public:
+
+            Rasterizer(unsigned width = 0, unsigned height = 0);
+           ~Rasterizer();
+
+        public:
+
+            /**
+             * Cambia el número de hilos que rasterizan (incluyendo el que llama a execute()).
+             * Por defecto se usan tantos como núcleos tenga el procesador.
+             */
+            void set_thread_count (unsigned thread_count);
+
+            unsigned get_thread_count () const
+            {
+                return unsigned(workers.size ()) + 1;
+            }
+
+            void resize (unsigned width, unsigned height);
+
+            const Color_Buffer< Rgba8888 > & get_color_buffer () const
+            {
+                return color_buffer;
+            }
+
+            unsigned get_width () const
+            {
+                return color_buffer.width;
+            }
+
+            unsigned get_height () const
+            {
+                return color_buffer.height;
+            }
+
+            size_t get_command_count () const
+            {
+                return commands.size ();
+            }
+
+        public:
+
+            void clear (float r, float g, float b);
+
+            /**
+             * Rellena el paralelogramo origin + s * s_axis + t * t_axis con s y t en [0, 1].
+             */
+            void fill_parallelogram (const Point & origin, const Point & s_axis, const Point & t_axis, const Paint & paint);
+
+            /**
+             * Rellena el paralelogramo con una textura. uv contiene las coordenadas de textura (en
+             * texels) que corresponden a s = 0, t = 0, s = 1 y t = 1: { u0, v0, u1, v1 }.
+             */
+            void fill_parallelogram
+            (
+                const Point & origin,
+                const Point & s_axis,
+                const Point & t_axis,
+                const Color_Buffer< Rgba8888 > & texture,
+                const float (& uv)[4],
+                const Paint & paint
+            );
+
+            void fill_triangle (const Point & a, const Point & b, const Point & c, const Paint & paint);
+
+            /**
+             * Dibuja un segmento de un píxel de grosor.
+             */
+            void draw_segment  (const Point & a, const Point & b, const Paint & paint);
+
+            void draw_point    (const Point & position, const Paint & paint);
+
+            /**
+             * Dibuja todas las órdenes pendientes y vacía la lista.
+             */
+            void execute ();
+
+        private:
+
+            bool add_parallelogram (Command & command, const Point & origin, const Point & s_axis, const Point & t_axis, const Paint & paint);
+            bool clip_bounds       (Command & command, float left, float top, float right, float bottom);
+            void set_paint         (Command & command, const Paint & paint);
+
+            void bin_commands      ();
+            void rasterize_tiles   ();
+            void rasterize_tile    (unsigned tile);
+            void work              (unsigned seen_generation);
+            void stop_workers      ();
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,28 @@
+/*
+ * SOFTWARE RENDERING
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#ifndef BASICS_SOFTWARE_RENDERING_HEADER
+#define BASICS_SOFTWARE_RENDERING_HEADER
+
+    namespace basics
+    {
+
+        /**
+         * enable< Software_Rendering > () registra el Canvas y las texturas del rasterizador por
+         * software. Para usarlo hay que crear el contexto gráfico con software::Context::create
+         * (ver Director::set_graphics_context_factory()).
+         */
+        class Software_Rendering;
+
+    }
+
+#endif
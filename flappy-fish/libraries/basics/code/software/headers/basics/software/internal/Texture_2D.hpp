@@ -0,0 +1,86 @@
+/*
+ * SOFTWARE TEXTURE 2D
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#ifndef BASICS_SOFTWARE_TEXTURE_2D_HEADER
+#define BASICS_SOFTWARE_TEXTURE_2D_HEADER
+
+    #include <basics/Color_Buffer>
+    #include <basics/Texture_2D>
+
+    namespace basics { namespace software
+    {
+
+        /**
+         * Textura del rasterizador por software. Los texels se quedan en memoria principal, por lo
+         * que no hay nada que subir al inicializarla ni que restaurar si se pierde el contexto.
+         */
+        class Texture_2D : public basics::Texture_2D
+        {
+        public:
+
+            static std::shared_ptr< basics::Texture_2D > create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
+
+        public:
+
+            static void enable ()
+            {
+                register_factory (ID(software), basics::software::Texture_2D::create);
+            }
+
+            /**
+             * Convierte la textura a este tipo si la ha creado este backend o devuelve nullptr. Solo
+             * compara la etiqueta de la textura, así que no usa RTTI.
+             */
+            static const Texture_2D * cast (const basics::Texture_2D * texture)
+            {
+                return texture && texture->get_backend () == ID(software) ? static_cast< const Texture_2D * >(texture) : nullptr;
+            }
+
+        private:
+
+            Color_Buffer< Rgba8888 > color_buffer;
+
+        public:
+
+            Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, unsigned width, unsigned height)
+            :
+                basics::Texture_2D(width, height, ID(software)),
+                color_buffer      (color_buffer )
+            {
+            }
+
+            Texture_2D(const Texture_2D & ) = delete;
+
+        public:
+
+            bool initialize () override
+            {
+                return initialized = color_buffer.size () > 0;
+            }
+
+            void finalize () override
+            {
+                initialized = false;
+            }
+
+        public:
+
+            const Color_Buffer< Rgba8888 > & get_color_buffer () const
+            {
+                return color_buffer;
+            }
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * SOFTWARE CONTEXT
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#include <basics/software/Context>
+
+namespace basics { namespace software
+{
+
+    Context::Context(Window & window, Graphics_Resource_Cache * cache)
+    :
+        Graphics_Context(window, cache),
+        rasterizer      (window.get_width (), window.get_height ()),
+        viewport_version(0)
+    {
+        available = rasterizer.get_width () > 0 && rasterizer.get_height () > 0;
+
+        reset_viewport ();
+    }
+
+    void Context::reset_viewport ()
+    {
+        // La ventana puede haber cambiado de tamaño (p. ej. al girar la pantalla):
+
+        const unsigned width  = window.get_width  ();
+        const unsigned height = window.get_height ();
+
+        if (width > 0 && height > 0 && (width != rasterizer.get_width () || height != rasterizer.get_height ()))
+        {
+            rasterizer.resize (width, height);
+        }
+
+        set_viewport ({ 0, 0 }, { rasterizer.get_width (), rasterizer.get_height () });
+    }
+
+    void Context::set_viewport (const Point2u & bottom_left, const Size2u & size)
+    {
+        viewport_bottom_left = bottom_left;
+        viewport_size        = size;
+
+        viewport_version++;
+    }
+
+    bool Context::flush_and_display ()
+    {
+        if (available)
+        {
+            rasterizer.execute ();
+
+            return present ();
+        }
+
+        return false;
+    }
+
+}}
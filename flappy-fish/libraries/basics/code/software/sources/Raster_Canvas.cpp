@@ -0,0 +1,276 @@
+/*
+ * RASTER CANVAS
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#include <utility>
+#include <basics/Small_Object_Pool>
+#include <basics/software/Raster_Canvas>
+#include <basics/software/Texture_2D>
+
+namespace basics { namespace software
+{
+
+    Canvas * Raster_Canvas::create (Id id, Graphics_Context::Accessor & context, const Options & options)
+    {
+        // Este factory solo se registra para los contextos con el id de software::Context:
+
+        std::shared_ptr< Canvas > canvas = make_pooled< Raster_Canvas > (*static_cast< Context * >(context.operator -> ()), options.size);
+
+        context->add (id, canvas);
+
+        return canvas.get ();
+    }
+
+    Raster_Canvas::Raster_Canvas(Context & context, const Size2u & size)
+    :
+        context   (context),
+        rasterizer(context.get_rasterizer ()),
+        size      { float(size.width), float(size.height) }
+    {
+        reset_state ();
+    }
+
+    void Raster_Canvas::reset_state ()
+    {
+        set_size        ({ unsigned(size.width), unsigned(size.height) });
+        set_transform   (Transformation2f());
+        set_clear_color (0.f, 0.f, 0.f);
+        set_color       (1.f, 1.f, 1.f);
+        set_opacity     (1.f);
+        set_blending    (TRANSPARENCY);
+        set_sampling    (Rasterizer::BILINEAR);
+    }
+
+    void Raster_Canvas::set_size (const Size2u & new_size)
+    {
+        size.width  = float(new_size.width );
+        size.height = float(new_size.height);
+
+        update_mapping ();
+    }
+
+    void Raster_Canvas::set_clear_color (float r, float g, float b)
+    {
+        clear_color[0] = r;
+        clear_color[1] = g;
+        clear_color[2] = b;
+    }
+
+    void Raster_Canvas::set_color (float r, float g, float b)
+    {
+        paint.color[0] = r;
+        paint.color[1] = g;
+        paint.color[2] = b;
+    }
+
+    void Raster_Canvas::set_opacity (float opacity)
+    {
+        paint.opacity = opacity;
+    }
+
+    void Raster_Canvas::set_blending (Blending blending)
+    {
+        paint.blending = blending;
+    }
+
+    void Raster_Canvas::set_transform (const Transformation2f & new_transform)
+    {
+        transform = new_transform;
+
+        update_mapping ();
+    }
+
+    void Raster_Canvas::apply_transform (const Transformation2f & t)
+    {
+        transform = t * transform;
+
+        update_mapping ();
+    }
+
+    void Raster_Canvas::update_mapping ()
+    {
+        // El canvas ocupa el viewport con el origen abajo a la izquierda, pero la fila 0 de la
+        // superficie es la de arriba:
+
+        const Point2u & bottom_left   = context.get_viewport_bottom_left ();
+        const Size2u  & viewport_size = context.get_viewport_size ();
+
+        const float scale_x = size.width  > 0.f ? float(viewport_size.width ) / size.width  : 1.f;
+        const float scale_y = size.height > 0.f ? float(viewport_size.height) / size.height : 1.f;
+        const float offset_x = float(bottom_left[0]);
+        const float offset_y = float(rasterizer.get_height ()) - float(bottom_left[1]);
+
+        to_pixels[0] =  scale_x * transform.matrix[0][0];
+        to_pixels[1] =  scale_x * transform.matrix[0][1];
+        to_pixels[2] =  scale_x * transform.matrix[0][2] + offset_x;
+        to_pixels[3] = -scale_y * transform.matrix[1][0];
+        to_pixels[4] = -scale_y * transform.matrix[1][1];
+        to_pixels[5] = -scale_y * transform.matrix[1][2] + offset_y;
+
+        viewport_version = context.get_viewport_version ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Raster_Canvas::clear ()
+    {
+        rasterizer.clear (clear_color[0], clear_color[1], clear_color[2]);
+    }
+
+    void Raster_Canvas::draw_point (const Point2f & position)
+    {
+        rasterizer.draw_point (to_pixel (position), paint);
+    }
+
+    void Raster_Canvas::draw_segment (const Point2f & a, const Point2f & b)
+    {
+        rasterizer.draw_segment (to_pixel (a), to_pixel (b), paint);
+    }
+
+    void Raster_Canvas::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        const Rasterizer::Point vertices[] = { to_pixel (a), to_pixel (b), to_pixel (c) };
+
+        rasterizer.draw_segment (vertices[0], vertices[1], paint);
+        rasterizer.draw_segment (vertices[1], vertices[2], paint);
+        rasterizer.draw_segment (vertices[2], vertices[0], paint);
+    }
+
+    void Raster_Canvas::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        rasterizer.fill_triangle (to_pixel (a), to_pixel (b), to_pixel (c), paint);
+    }
+
+    void Raster_Canvas::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        const float left   = bottom_left.coordinates.x ();
+        const float bottom = bottom_left.coordinates.y ();
+        const float right  = left   + size.width;
+        const float top    = bottom + size.height;
+
+        const Rasterizer::Point corners[] =
+        {
+            to_pixel (left,  bottom),
+            to_pixel (right, bottom),
+            to_pixel (right, top   ),
+            to_pixel (left,  top   ),
+        };
+
+        rasterizer.draw_segment (corners[0], corners[1], paint);
+        rasterizer.draw_segment (corners[1], corners[2], paint);
+        rasterizer.draw_segment (corners[2], corners[3], paint);
+        rasterizer.draw_segment (corners[3], corners[0], paint);
+    }
+
+    void Raster_Canvas::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        rasterizer.fill_parallelogram
+        (
+            to_pixel        (bottom_left),
+            to_pixel_vector (size.width, 0.f),
+            to_pixel_vector (0.f, size.height),
+            paint
+        );
+    }
+
+    void Raster_Canvas::fill_rectangle (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling)
+    {
+        const software::Texture_2D * software_texture = software::Texture_2D::cast (texture);
+
+        if (software_texture)
+        {
+            fill_textured_rectangle (where, size, *software_texture, 0.f, 1.f, 1.f, 0.f, handling);
+        }
+    }
+
+    void Raster_Canvas::fill_rectangle (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling)
+    {
+        if (!slice || !slice->atlas)
+        {
+            return;
+        }
+
+        const software::Texture_2D * software_texture = software::Texture_2D::cast (slice->atlas->get_texture ().get ());
+
+        if (software_texture)
+        {
+            float horizontal_ratio = 1.f / software_texture->get_width  ();
+            float   vertical_ratio = 1.f / software_texture->get_height ();
+
+            fill_textured_rectangle
+            (
+                where,
+                size,
+               *software_texture,
+                slice->left   * horizontal_ratio,
+                slice->right  * horizontal_ratio,
+                slice->top    *   vertical_ratio,
+                slice->bottom *   vertical_ratio,
+                handling
+            );
+        }
+    }
+
+    void Raster_Canvas::fill_textured_rectangle
+    (
+        const Point2f    & where,
+        const Size2f     & size,
+        const Texture_2D & texture,
+        float              u_left,
+        float              u_right,
+        float              v_bottom,
+        float              v_top,
+        int                handling
+    )
+    {
+        Point2f bottom_left;
+
+        switch (handling & 0x03)
+        {
+            case LEFT:   bottom_left[0] = where[0];                  break;
+            case CENTER: bottom_left[0] = where[0] - size[0] * 0.5f; break;
+            case RIGHT:  bottom_left[0] = where[0] - size[0];        break;
+        }
+
+        switch (handling & 0x0C)
+        {
+            case TOP:    bottom_left[1] = where[1] - size[1];        break;
+            case CENTER: bottom_left[1] = where[1] - size[1] * 0.5f; break;
+            case BOTTOM: bottom_left[1] = where[1];                  break;
+        }
+
+        if (handling & FLIP_HORIZONTAL) std::swap (u_left,   u_right);
+        if (handling & FLIP_VERTICAL  ) std::swap (v_bottom, v_top  );
+
+        // Las coordenadas normalizadas se pasan a texels (la fila 0 de la textura es la de arriba):
+
+        const Color_Buffer< Rgba8888 > & texels = texture.get_color_buffer ();
+
+        const float uv[] =
+        {
+            u_left   * float(texels.width ),
+            v_bottom * float(texels.height),
+            u_right  * float(texels.width ),
+            v_top    * float(texels.height),
+        };
+
+        rasterizer.fill_parallelogram
+        (
+            to_pixel        (bottom_left),
+            to_pixel_vector (size.width, 0.f),
+            to_pixel_vector (0.f, size.height),
+            texels,
+            uv,
+            paint
+        );
+    }
+
+}}
@@ -0,0 +1,788 @@
+/*
+ * RASTERIZER
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <basics/software/Rasterizer>
+
+namespace basics { namespace software
+{
+
+    namespace
+    {
+
+        // Vectores de 4 elementos de las extensiones de GCC y Clang (un registro SSE2 o NEON):
+
+        typedef float    Float4 __attribute__((vector_size(16)));
+        typedef int32_t  Int4   __attribute__((vector_size(16)));
+        typedef uint32_t Uint4  __attribute__((vector_size(16)));
+
+        const Float4 pixel_centers = { 0.5f, 1.5f, 2.5f, 3.5f };
+        const Int4   lane_indices  = { 0, 1, 2, 3 };
+
+        struct Pixels
+        {
+            Float4 r, g, b, a;                              ///< En el rango [0, 255]
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        inline Float4 splat (float value)
+        {
+            return Float4{ value, value, value, value };
+        }
+
+        inline Float4 select (const Int4 & mask, const Float4 & a, const Float4 & b)
+        {
+            return (Float4)((mask & (Int4)a) | (~mask & (Int4)b));
+        }
+
+        inline Uint4 select (const Int4 & mask, const Uint4 & a, const Uint4 & b)
+        {
+            return ((Uint4)mask & a) | (~(Uint4)mask & b);
+        }
+
+        inline Float4 clamp (const Float4 & value, float low, float high)
+        {
+            Float4 result = select (value < low, splat (low), value);
+
+            return select (result > high, splat (high), result);
+        }
+
+        inline bool any (const Int4 & mask)
+        {
+            return (mask[0] | mask[1] | mask[2] | mask[3]) != 0;
+        }
+
+        inline Pixels unpack (const Uint4 & packed)
+        {
+            Pixels pixels;
+
+            pixels.r = __builtin_convertvector ((Int4)( packed        & 0xFF), Float4);
+            pixels.g = __builtin_convertvector ((Int4)((packed >>  8) & 0xFF), Float4);
+            pixels.b = __builtin_convertvector ((Int4)((packed >> 16) & 0xFF), Float4);
+            pixels.a = __builtin_convertvector ((Int4)( packed >> 24        ), Float4);
+
+            return pixels;
+        }
+
+        inline Uint4 pack_opaque (const Float4 & r, const Float4 & g, const Float4 & b)
+        {
+            Uint4 red   = (Uint4)__builtin_convertvector (clamp (r, 0.f, 255.f) + 0.5f, Int4);
+            Uint4 green = (Uint4)__builtin_convertvector (clamp (g, 0.f, 255.f) + 0.5f, Int4);
+            Uint4 blue  = (Uint4)__builtin_convertvector (clamp (b, 0.f, 255.f) + 0.5f, Int4);
+
+            return red | (green << 8) | (blue << 16) | 0xFF000000u;
+        }
+
+        inline Rgba8888 pack_opaque (const float (& color)[4])
+        {
+            return
+                Rgba8888(color[0] + 0.5f)       |
+                Rgba8888(color[1] + 0.5f) <<  8 |
+                Rgba8888(color[2] + 0.5f) << 16 | 0xFF000000u;
+        }
+
+        inline Uint4 gather (const Rgba8888 * texels, const Int4 & indices)
+        {
+            return Uint4{ texels[indices[0]], texels[indices[1]], texels[indices[2]], texels[indices[3]] };
+        }
+
+        // Los grupos incompletos del final de un tramo no pueden leer ni escribir fuera de él, ya
+        // que lo que hay a continuación puede pertenecer a una celda de otro hilo:
+
+        inline Uint4 load (const Rgba8888 * pixels, int count)
+        {
+            Uint4 result = { 0, 0, 0, 0 };
+
+            if (count == 4)
+                std::memcpy (&result, pixels, sizeof(Uint4));
+            else
+                for (int index = 0; index < count; ++index) result[index] = pixels[index];
+
+            return result;
+        }
+
+        inline void store (Rgba8888 * pixels, const Uint4 & values, int count)
+        {
+            if (count == 4)
+                std::memcpy (pixels, &values, sizeof(Uint4));
+            else
+                for (int index = 0; index < count; ++index) pixels[index] = values[index];
+        }
+
+        inline Float4 lerp (const Float4 & a, const Float4 & b, const Float4 & t)
+        {
+            return a + (b - a) * t;
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        Pixels sample_nearest (const Color_Buffer< Rgba8888 > & texture, const Float4 & u, const Float4 & v)
+        {
+            const float max_x = float(texture.width  - 1);
+            const float max_y = float(texture.height - 1);
+
+            Int4 x = __builtin_convertvector (clamp (u, 0.f, max_x), Int4);
+            Int4 y = __builtin_convertvector (clamp (v, 0.f, max_y), Int4);
+
+            return unpack (gather (texture.buffer.data (), y * int(texture.width) + x));
+        }
+
+        Pixels sample_bilinear (const Color_Buffer< Rgba8888 > & texture, const Float4 & u, const Float4 & v)
+        {
+            const int   width = int(texture.width);
+            const float max_x = float(texture.width  - 1);
+            const float max_y = float(texture.height - 1);
+
+            // Se interpolan los 4 texels más cercanos repitiendo los bordes (como GL_CLAMP_TO_EDGE):
+
+            Float4 x  = clamp (u - 0.5f, 0.f, max_x);
+            Float4 y  = clamp (v - 0.5f, 0.f, max_y);
+            Int4   x0 = __builtin_convertvector (x, Int4);
+            Int4   y0 = __builtin_convertvector (y, Int4);
+            Float4 fx = x - __builtin_convertvector (x0, Float4);
+            Float4 fy = y - __builtin_convertvector (y0, Float4);
+            Int4   dx = (Int4)(fx > 0.f) & 1;
+            Int4   dy = (Int4)(fy > 0.f) & width;
+
+            const Rgba8888 * texels = texture.buffer.data ();
+
+            Int4   i00 = y0 * width + x0;
+            Pixels p00 = unpack (gather (texels, i00          ));
+            Pixels p10 = unpack (gather (texels, i00 + dx     ));
+            Pixels p01 = unpack (gather (texels, i00 + dy     ));
+            Pixels p11 = unpack (gather (texels, i00 + dx + dy));
+
+            Pixels result;
+
+            result.r = lerp (lerp (p00.r, p10.r, fx), lerp (p01.r, p11.r, fx), fy);
+            result.g = lerp (lerp (p00.g, p10.g, fx), lerp (p01.g, p11.g, fx), fy);
+            result.b = lerp (lerp (p00.b, p10.b, fx), lerp (p01.b, p11.b, fx), fy);
+            result.a = lerp (lerp (p00.a, p10.a, fx), lerp (p01.a, p11.a, fx), fy);
+
+            return result;
+        }
+
+        inline void blend (Pixels & destination, const Pixels & source, const Float4 & alpha, Canvas::Blending blending)
+        {
+            switch (blending)
+            {
+                case Canvas::NONE:
+                {
+                    destination = source;
+                    break;
+                }
+
+                case Canvas::TRANSPARENCY:
+                {
+                    destination.r += (source.r - destination.r) * alpha;
+                    destination.g += (source.g - destination.g) * alpha;
+                    destination.b += (source.b - destination.b) * alpha;
+                    break;
+                }
+
+                case Canvas::MULTIPLY:
+                {
+                    const float scale = 1.f / 255.f;
+
+                    destination.r += (destination.r * source.r * scale - destination.r) * alpha;
+                    destination.g += (destination.g * source.g * scale - destination.g) * alpha;
+                    destination.b += (destination.b * source.b * scale - destination.b) * alpha;
+                    break;
+                }
+
+                case Canvas::ADD:
+                {
+                    destination.r += source.r * alpha;
+                    destination.g += source.g * alpha;
+                    destination.b += source.b * alpha;
+                    break;
+                }
+            }
+        }
+
+        inline int to_int (float value, int low, int high)
+        {
+            return value <= float(low) ? low : value >= float(high) ? high : int(value);
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        // Cada tipo de tramo tiene su propia versión del bucle para que no se decida por grupo:
+
+        enum Span_Mode
+        {
+            SPAN_OPAQUE,                                    ///< Color sólido que tapa el destino
+            SPAN_SOLID,                                     ///< Color sólido que se mezcla
+            SPAN_NEAREST,                                   ///< Textura con el texel más cercano
+            SPAN_BILINEAR,                                  ///< Textura con filtro bilineal
+        };
+
+        struct Span
+        {
+            Span_Mode                        mode;
+            const Color_Buffer< Rgba8888 > * texture;
+            Canvas::Blending                 blending;
+            Uint4                            packed;
+            Float4                           opacity;
+            Pixels                           color;
+            Float4                           edge_x[4];
+            float                            offsets[4];    ///< Valor de cada semiplano en x = 0 en la fila actual
+            Float4                           u_x;
+            Float4                           v_x;
+            float                            u_offset;
+            float                            v_offset;
+        };
+
+        template< Span_Mode MODE >
+        void fill_span (const Span & span, Rgba8888 * row, int first, int last)
+        {
+            for (int x = first; x < last; x += 4)
+            {
+                const int    count    = std::min (4, last - x);
+                const Float4 center_x = float(x) + pixel_centers;
+
+                const Int4 mask =
+                    (lane_indices < count) &
+                    (span.edge_x[0] * center_x + span.offsets[0] >= 0.f) &
+                    (span.edge_x[1] * center_x + span.offsets[1] >= 0.f) &
+                    (span.edge_x[2] * center_x + span.offsets[2] >= 0.f) &
+                    (span.edge_x[3] * center_x + span.offsets[3] >= 0.f);
+
+                if (!any (mask)) continue;
+
+                const Uint4 destination = load (row + x, count);
+
+                Uint4 result;
+
+                if (MODE == SPAN_OPAQUE)
+                {
+                    result = select (mask, span.packed, destination);
+                }
+                else
+                {
+                    Pixels target = unpack (destination);
+                    Pixels source;
+
+                    if (MODE == SPAN_SOLID)
+                    {
+                        source = span.color;
+                    }
+                    else
+                    {
+                        const Float4 u = span.u_x * center_x + span.u_offset;
+                        const Float4 v = span.v_x * center_x + span.v_offset;
+
+                        source = MODE == SPAN_NEAREST ? sample_nearest (*span.texture, u, v) : sample_bilinear (*span.texture, u, v);
+                    }
+
+                    blend (target, source, source.a * span.opacity, span.blending);
+
+                    result = select (mask, pack_opaque (target.r, target.g, target.b), destination);
+                }
+
+                store (row + x, result, count);
+            }
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Rasterizer::Rasterizer(unsigned width, unsigned height)
+    :
+        tile_columns   (0),
+        tile_rows      (0),
+        generation     (0),
+        pending_workers(0),
+        stopping       (false),
+        next_tile      (0)
+    {
+        resize (width, height);
+
+        set_thread_count (std::max (std::thread::hardware_concurrency (), 1u));
+    }
+
+    Rasterizer::~Rasterizer()
+    {
+        stop_workers ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Rasterizer::set_thread_count (unsigned thread_count)
+    {
+        stop_workers ();
+
+        stopping = false;
+
+        for (unsigned index = 1; index < thread_count; ++index)
+        {
+            workers.emplace_back (&Rasterizer::work, this, generation);
+        }
+    }
+
+    void Rasterizer::resize (unsigned width, unsigned height)
+    {
+        color_buffer.resize (width, height);
+
+        tile_columns = (width  + tile_size - 1) / tile_size;
+        tile_rows    = (height + tile_size - 1) / tile_size;
+
+        bins.resize (tile_columns * tile_rows);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Rasterizer::clear (float r, float g, float b)
+    {
+        Command command;
+
+        command.type         = CLEAR;
+        command.left         = 0;
+        command.top          = 0;
+        command.right        = int(color_buffer.width );
+        command.bottom       = int(color_buffer.height);
+        command.color[0]     = std::min (std::max (r, 0.f), 1.f) * 255.f;
+        command.color[1]     = std::min (std::max (g, 0.f), 1.f) * 255.f;
+        command.color[2]     = std::min (std::max (b, 0.f), 1.f) * 255.f;
+        command.color[3]     = 1.f;
+        command.packed_color = pack_opaque (command.color);
+
+        commands.push_back (command);
+    }
+
+    void Rasterizer::fill_parallelogram (const Point & origin, const Point & s_axis, const Point & t_axis, const Paint & paint)
+    {
+        Command command;
+
+        if (add_parallelogram (command, origin, s_axis, t_axis, paint))
+        {
+            commands.push_back (command);
+        }
+    }
+
+    void Rasterizer::fill_parallelogram
+    (
+        const Point & origin,
+        const Point & s_axis,
+        const Point & t_axis,
+        const Color_Buffer< Rgba8888 > & texture,
+        const float (& uv)[4],
+        const Paint & paint
+    )
+    {
+        if (texture.size () == 0) return;
+
+        Command command;
+
+        if (add_parallelogram (command, origin, s_axis, t_axis, paint))
+        {
+            // u = u0 + s * (u1 - u0) y v = v0 + t * (v1 - v0), siendo s y t los semiplanos 0 y 2:
+
+            const float du = uv[2] - uv[0];
+            const float dv = uv[3] - uv[1];
+
+            command.u[0]    = command.edges[0][0] * du;
+            command.u[1]    = command.edges[0][1] * du;
+            command.u[2]    = command.edges[0][2] * du + uv[0];
+            command.v[0]    = command.edges[2][0] * dv;
+            command.v[1]    = command.edges[2][1] * dv;
+            command.v[2]    = command.edges[2][2] * dv + uv[1];
+            command.texture = &texture;
+
+            commands.push_back (command);
+        }
+    }
+
+    void Rasterizer::fill_triangle (const Point & a, const Point & b, const Point & c, const Paint & paint)
+    {
+        const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+
+        if (area == 0.f) return;
+
+        Command command;
+
+        if
+        (
+            clip_bounds
+            (
+                command,
+                std::min ({ a.x, b.x, c.x }),
+                std::min ({ a.y, b.y, c.y }),
+                std::max ({ a.x, b.x, c.x }),
+                std::max ({ a.y, b.y, c.y })
+            )
+        )
+        {
+            // Los semiplanos se orientan para que el interior sea positivo con cualquier orden de
+            // los vértices:
+
+            const Point * vertices[] = { &a, &b, &c };
+            const float   sign       = area > 0.f ? 1.f : -1.f;
+
+            for (unsigned index = 0; index < 3; ++index)
+            {
+                const Point & p0 = *vertices[index];
+                const Point & p1 = *vertices[(index + 1) % 3];
+
+                command.edges[index][0] = -(p1.y - p0.y) * sign;
+                command.edges[index][1] =  (p1.x - p0.x) * sign;
+                command.edges[index][2] = ((p1.y - p0.y) * p0.x - (p1.x - p0.x) * p0.y) * sign;
+            }
+
+            // El cuarto semiplano (0 * x + 0 * y + 1 >= 0) no descarta nada:
+
+            command.edges[3][0] = 0.f;
+            command.edges[3][1] = 0.f;
+            command.edges[3][2] = 1.f;
+
+            command.type        = FILL;
+            command.texture     = nullptr;
+
+            set_paint (command, paint);
+
+            commands.push_back (command);
+        }
+    }
+
+    void Rasterizer::draw_segment (const Point & a, const Point & b, const Paint & paint)
+    {
+        const float dx     = b.x - a.x;
+        const float dy     = b.y - a.y;
+        const float length = std::sqrt (dx * dx + dy * dy);
+
+        if (length < 0.001f)
+        {
+            draw_point (a, paint);
+        }
+        else
+        {
+            // Se dibuja como un rectángulo de un píxel de ancho centrado en el segmento:
+
+            const Point normal{ -dy / length * 0.5f, dx / length * 0.5f };
+
+            fill_parallelogram
+            (
+                { a.x - normal.x, a.y - normal.y },
+                { dx, dy },
+                { normal.x * 2.f, normal.y * 2.f },
+                paint
+            );
+        }
+    }
+
+    void Rasterizer::draw_point (const Point & position, const Paint & paint)
+    {
+        fill_parallelogram ({ position.x - 0.5f, position.y - 0.5f }, { 1.f, 0.f }, { 0.f, 1.f }, paint);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Rasterizer::add_parallelogram (Command & command, const Point & origin, const Point & s_axis, const Point & t_axis, const Paint & paint)
+    {
+        const float determinant = s_axis.x * t_axis.y - t_axis.x * s_axis.y;
+
+        if (std::abs (determinant) < 1e-12f) return false;
+
+        const Point corners[] =
+        {
+            { origin.x,                       origin.y                       },
+            { origin.x + s_axis.x,            origin.y + s_axis.y            },
+            { origin.x + t_axis.x,            origin.y + t_axis.y            },
+            { origin.x + s_axis.x + t_axis.x, origin.y + s_axis.y + t_axis.y },
+        };
+
+        if
+        (
+            !clip_bounds
+            (
+                command,
+                std::min ({ corners[0].x, corners[1].x, corners[2].x, corners[3].x }),
+                std::min ({ corners[0].y, corners[1].y, corners[2].y, corners[3].y }),
+                std::max ({ corners[0].x, corners[1].x, corners[2].x, corners[3].x }),
+                std::max ({ corners[0].y, corners[1].y, corners[2].y, corners[3].y })
+            )
+        )
+        {
+            return false;
+        }
+
+        // s y t se obtienen invirtiendo la matriz cuyas columnas son los ejes. Los semiplanos
+        // opuestos (1 - s >= 0 y 1 - t >= 0) se desplazan un poco para que los píxeles que caen
+        // justo en el borde común de dos rectángulos contiguos no se dibujen dos veces:
+
+        const float epsilon = 1e-5f;
+        const float as      =  t_axis.y / determinant;
+        const float bs      = -t_axis.x / determinant;
+        const float at      = -s_axis.y / determinant;
+        const float bt      =  s_axis.x / determinant;
+        const float cs      = -(as * origin.x + bs * origin.y);
+        const float ct      = -(at * origin.x + bt * origin.y);
+
+        const float edges[4][3] =
+        {
+            {  as,  bs,      cs           },
+            { -as, -bs, 1.f - cs - epsilon },
+            {  at,  bt,      ct           },
+            { -at, -bt, 1.f - ct - epsilon },
+        };
+
+        std::memcpy (command.edges, edges, sizeof(edges));
+
+        command.type       = FILL;
+        command.texture    = nullptr;
+
+        set_paint (command, paint);
+
+        return true;
+    }
+
+    bool Rasterizer::clip_bounds (Command & command, float left, float top, float right, float bottom)
+    {
+        const int width  = int(color_buffer.width );
+        const int height = int(color_buffer.height);
+
+        command.left   = to_int (std::floor (left  ), 0, width );
+        command.top    = to_int (std::floor (top   ), 0, height);
+        command.right  = to_int (std::ceil  (right ), 0, width );
+        command.bottom = to_int (std::ceil  (bottom), 0, height);
+
+        return command.left < command.right && command.top < command.bottom;
+    }
+
+    void Rasterizer::set_paint (Command & command, const Paint & paint)
+    {
+        command.blending     = paint.blending;
+        command.sampling     = paint.sampling;
+        command.color[0]     = std::min (std::max (paint.color[0], 0.f), 1.f) * 255.f;
+        command.color[1]     = std::min (std::max (paint.color[1], 0.f), 1.f) * 255.f;
+        command.color[2]     = std::min (std::max (paint.color[2], 0.f), 1.f) * 255.f;
+        command.color[3]     = std::min (std::max (paint.opacity,  0.f), 1.f);
+        command.packed_color = pack_opaque (command.color);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Rasterizer::execute ()
+    {
+        if (color_buffer.size () > 0 && !commands.empty ())
+        {
+            bin_commands ();
+
+            next_tile = 0;
+
+            if (!workers.empty ())
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                pending_workers = unsigned(workers.size ());
+                generation++;
+
+                work_available.notify_all ();
+            }
+
+            // El hilo que llama también rasteriza y después espera a que los demás terminen:
+
+            rasterize_tiles ();
+
+            if (!workers.empty ())
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                work_done.wait (lock, [this] () { return pending_workers == 0; });
+            }
+        }
+
+        commands.clear ();
+    }
+
+    void Rasterizer::bin_commands ()
+    {
+        for (Bin & bin : bins) bin.clear ();
+
+        for (uint32_t index = 0, count = uint32_t(commands.size ()); index < count; ++index)
+        {
+            const Command & command = commands[index];
+
+            // Lo que se dibujó antes de borrar toda la superficie no hace falta rasterizarlo:
+
+            if (command.type == CLEAR)
+            {
+                for (Bin & bin : bins) bin.clear ();
+            }
+
+            const unsigned first_column = unsigned(command.left        ) / tile_size;
+            const unsigned  last_column = unsigned(command.right  - 1  ) / tile_size;
+            const unsigned first_row    = unsigned(command.top         ) / tile_size;
+            const unsigned  last_row    = unsigned(command.bottom - 1  ) / tile_size;
+
+            for (unsigned row = first_row; row <= last_row; ++row)
+            {
+                for (unsigned column = first_column; column <= last_column; ++column)
+                {
+                    bins[row * tile_columns + column].push_back (index);
+                }
+            }
+        }
+    }
+
+    void Rasterizer::rasterize_tiles ()
+    {
+        const unsigned tile_count = unsigned(bins.size ());
+
+        for (unsigned tile; (tile = next_tile.fetch_add (1, std::memory_order_relaxed)) < tile_count; )
+        {
+            if (!bins[tile].empty ()) rasterize_tile (tile);
+        }
+    }
+
+    void Rasterizer::rasterize_tile (unsigned tile)
+    {
+        const int stride      = int(color_buffer.width);
+        const int tile_left   = int(tile % tile_columns * tile_size);
+        const int tile_top    = int(tile / tile_columns * tile_size);
+        const int tile_right  = std::min (tile_left + int(tile_size), int(color_buffer.width ));
+        const int tile_bottom = std::min (tile_top  + int(tile_size), int(color_buffer.height));
+
+        Rgba8888 * pixels = color_buffer.buffer.data ();
+
+        for (uint32_t index : bins[tile])
+        {
+            const Command & command = commands[index];
+
+            const int left   = std::max (command.left,   tile_left  );
+            const int top    = std::max (command.top,    tile_top   );
+            const int right  = std::min (command.right,  tile_right );
+            const int bottom = std::min (command.bottom, tile_bottom);
+
+            if (command.type == CLEAR)
+            {
+                for (int y = top; y < bottom; ++y)
+                {
+                    std::fill (pixels + y * stride + left, pixels + y * stride + right, command.packed_color);
+                }
+
+                continue;
+            }
+
+            // Las figuras sin textura que tapan lo que hay debajo no necesitan leer el destino:
+
+            Span span;
+
+            span.mode = command.texture
+                      ? (command.sampling == NEAREST ? SPAN_NEAREST : SPAN_BILINEAR)
+                      : (command.blending == Canvas::NONE || (command.blending == Canvas::TRANSPARENCY && command.color[3] >= 1.f)) ? SPAN_OPAQUE : SPAN_SOLID;
+
+            span.texture  = command.texture;
+            span.blending = command.blending;
+            span.packed   = Uint4{ command.packed_color, command.packed_color, command.packed_color, command.packed_color };
+            span.opacity  = splat (command.texture ? command.color[3] / 255.f : command.color[3]);
+            span.color.r  = splat (command.color[0]);
+            span.color.g  = splat (command.color[1]);
+            span.color.b  = splat (command.color[2]);
+            span.color.a  = splat (1.f);
+            span.u_x      = splat (command.u[0]);
+            span.v_x      = splat (command.v[0]);
+
+            for (unsigned edge = 0; edge < 4; ++edge) span.edge_x[edge] = splat (command.edges[edge][0]);
+
+            for (int y = top; y < bottom; ++y)
+            {
+                const float center_y = float(y) + 0.5f;
+
+                // Se calcula el tramo de la fila que queda dentro de todos los semiplanos (con un
+                // píxel de margen, ya que los bordes se deciden con la máscara de cada píxel):
+
+                int first = left;
+                int last  = right;
+
+                for (unsigned edge = 0; edge < 4; ++edge)
+                {
+                    const float a = command.edges[edge][0];
+
+                    span.offsets[edge] = command.edges[edge][1] * center_y + command.edges[edge][2];
+
+                    if (a != 0.f)
+                    {
+                        const float x = -span.offsets[edge] / a - 0.5f;
+
+                        if (a > 0.f) first = std::max (first, to_int (std::floor (x) - 1.f, left, right));
+                        else         last  = std::min (last,  to_int (std::floor (x) + 2.f, left, right));
+                    }
+                    else
+                    if (span.offsets[edge] < 0.f)
+                    {
+                        last = first;
+                    }
+                }
+
+                if (first >= last) continue;
+
+                span.u_offset = command.u[1] * center_y + command.u[2];
+                span.v_offset = command.v[1] * center_y + command.v[2];
+
+                Rgba8888 * row = pixels + y * stride;
+
+                switch (span.mode)
+                {
+                    case SPAN_OPAQUE:   fill_span< SPAN_OPAQUE   > (span, row, first, last); break;
+                    case SPAN_SOLID:    fill_span< SPAN_SOLID    > (span, row, first, last); break;
+                    case SPAN_NEAREST:  fill_span< SPAN_NEAREST  > (span, row, first, last); break;
+                    case SPAN_BILINEAR: fill_span< SPAN_BILINEAR > (span, row, first, last); break;
+                }
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Rasterizer::work (unsigned seen_generation)
+    {
+        for (;;)
+        {
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                work_available.wait (lock, [&] () { return stopping || generation != seen_generation; });
+
+                if (stopping) return;
+
+                seen_generation = generation;
+            }
+
+            rasterize_tiles ();
+
+            std::lock_guard< std::mutex > lock(mutex);
+
+            if (--pending_workers == 0) work_done.notify_one ();
+        }
+    }
+
+    void Rasterizer::stop_workers ()
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            stopping = true;
+
+            work_available.notify_all ();
+        }
+
+        for (std::thread & worker : workers) worker.join ();
+
+        workers.clear ();
+    }
+
+}}
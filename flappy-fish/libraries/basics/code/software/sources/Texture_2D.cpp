@@ -0,0 +1,24 @@
+/*
+ * SOFTWARE TEXTURE 2D
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#include <basics/Small_Object_Pool>
+#include <basics/software/Texture_2D>
+
+namespace basics { namespace software
+{
+
+    std::shared_ptr< basics::Texture_2D > Texture_2D::create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
+    {
+        return make_pooled< Texture_2D > (color_buffer, options.width, options.height);
+    }
+
+}}
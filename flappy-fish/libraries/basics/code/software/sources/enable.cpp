@@ -0,0 +1,30 @@
+/*
+ * ENABLE
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C2610191900
+ */
+
+#include <basics/enable>
+#include <basics/software/Raster_Canvas>
+#include <basics/software/Software_Rendering>
+#include <basics/software/Texture_2D>
+
+namespace basics
+{
+
+    template< >
+    bool enable< Software_Rendering > ()
+    {
+        software::Raster_Canvas::enable ();
+        software::Texture_2D   ::enable ();
+
+        return true;
+    }
+
+}